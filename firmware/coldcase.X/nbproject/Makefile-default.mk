@@ -57,17 +57,17 @@ OBJECTDIR=build/${CND_CONF}/${IMAGE_TYPE}
 DISTDIR=dist/${CND_CONF}/${IMAGE_TYPE}
 
 # Source Files Quoted if spaced
-SOURCEFILES_QUOTED_IF_SPACED=../src/config/default/peripheral/clock/plib_clock.c ../src/config/default/peripheral/cmcc/plib_cmcc.c ../src/config/default/peripheral/dmac/plib_dmac.c ../src/config/default/peripheral/eic/plib_eic.c ../src/config/default/peripheral/evsys/plib_evsys.c ../src/config/default/peripheral/nvic/plib_nvic.c ../src/config/default/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/default/peripheral/port/plib_port.c ../src/config/default/peripheral/rtc/plib_rtc_timer.c ../src/config/default/peripheral/sercom/i2c_master/plib_sercom2_i2c_master.c ../src/config/default/peripheral/sercom/i2c_master/plib_sercom0_i2c_master.c ../src/config/default/peripheral/sercom/usart/plib_sercom5_usart.c ../src/config/default/peripheral/sercom/usart/plib_sercom3_usart.c ../src/config/default/peripheral/systick/plib_systick.c ../src/config/default/peripheral/tcc/plib_tcc0.c ../src/config/default/peripheral/tcc/plib_tcc1.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../src/config/default/startup_xc32.c ../src/config/default/libc_syscalls.c ../src/temphum11.c ../src/servo.c ../src/rgbled.cpp ../src/main.cpp ../src/bluesmirf.cpp
+SOURCEFILES_QUOTED_IF_SPACED=../src/config/default/peripheral/clock/plib_clock.c ../src/config/default/peripheral/cmcc/plib_cmcc.c ../src/config/default/peripheral/dmac/plib_dmac.c ../src/config/default/peripheral/eic/plib_eic.c ../src/config/default/peripheral/evsys/plib_evsys.c ../src/config/default/peripheral/nvic/plib_nvic.c ../src/config/default/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/default/peripheral/port/plib_port.c ../src/config/default/peripheral/rtc/plib_rtc_timer.c ../src/config/default/peripheral/sercom/i2c_master/plib_sercom2_i2c_master.c ../src/config/default/peripheral/sercom/i2c_master/plib_sercom0_i2c_master.c ../src/config/default/peripheral/sercom/usart/plib_sercom5_usart.c ../src/config/default/peripheral/sercom/usart/plib_sercom3_usart.c ../src/config/default/peripheral/systick/plib_systick.c ../src/config/default/peripheral/tcc/plib_tcc0.c ../src/config/default/peripheral/tcc/plib_tcc1.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../src/config/default/startup_xc32.c ../src/config/default/libc_syscalls.c ../src/temphum11.c ../src/servo.c ../src/rgbled.cpp ../src/main.cpp ../src/bluesmirf.cpp ../src/swtimer.c ../src/tempcontrol.cpp ../src/tempmodel.cpp ../src/nvstore.c ../src/stepresponse.cpp ../src/rollup.c ../src/anomaly.cpp ../src/sampler.cpp ../src/filter.c ../src/currentmon.c ../src/door.cpp ../src/motion.c ../src/servochan.c ../src/boot.c ../src/btrx.c ../src/drivers/bttx.c
 
 # Object Files Quoted if spaced
-OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1984496892/plib_clock.o ${OBJECTDIR}/_ext/1865131932/plib_cmcc.o ${OBJECTDIR}/_ext/1865161661/plib_dmac.o ${OBJECTDIR}/_ext/60167341/plib_eic.o ${OBJECTDIR}/_ext/1986646378/plib_evsys.o ${OBJECTDIR}/_ext/1865468468/plib_nvic.o ${OBJECTDIR}/_ext/1593096446/plib_nvmctrl.o ${OBJECTDIR}/_ext/1865521619/plib_port.o ${OBJECTDIR}/_ext/60180175/plib_rtc_timer.o ${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o ${OBJECTDIR}/_ext/504274921/plib_sercom5_usart.o ${OBJECTDIR}/_ext/504274921/plib_sercom3_usart.o ${OBJECTDIR}/_ext/1827571544/plib_systick.o ${OBJECTDIR}/_ext/60181570/plib_tcc0.o ${OBJECTDIR}/_ext/60181570/plib_tcc1.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/1171490990/startup_xc32.o ${OBJECTDIR}/_ext/1171490990/libc_syscalls.o ${OBJECTDIR}/_ext/1360937237/temphum11.o ${OBJECTDIR}/_ext/1360937237/servo.o ${OBJECTDIR}/_ext/1360937237/rgbled.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/bluesmirf.o
-POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1984496892/plib_clock.o.d ${OBJECTDIR}/_ext/1865131932/plib_cmcc.o.d ${OBJECTDIR}/_ext/1865161661/plib_dmac.o.d ${OBJECTDIR}/_ext/60167341/plib_eic.o.d ${OBJECTDIR}/_ext/1986646378/plib_evsys.o.d ${OBJECTDIR}/_ext/1865468468/plib_nvic.o.d ${OBJECTDIR}/_ext/1593096446/plib_nvmctrl.o.d ${OBJECTDIR}/_ext/1865521619/plib_port.o.d ${OBJECTDIR}/_ext/60180175/plib_rtc_timer.o.d ${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o.d ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o.d ${OBJECTDIR}/_ext/504274921/plib_sercom5_usart.o.d ${OBJECTDIR}/_ext/504274921/plib_sercom3_usart.o.d ${OBJECTDIR}/_ext/1827571544/plib_systick.o.d ${OBJECTDIR}/_ext/60181570/plib_tcc0.o.d ${OBJECTDIR}/_ext/60181570/plib_tcc1.o.d ${OBJECTDIR}/_ext/163028504/xc32_monitor.o.d ${OBJECTDIR}/_ext/1171490990/initialization.o.d ${OBJECTDIR}/_ext/1171490990/interrupts.o.d ${OBJECTDIR}/_ext/1171490990/exceptions.o.d ${OBJECTDIR}/_ext/1171490990/startup_xc32.o.d ${OBJECTDIR}/_ext/1171490990/libc_syscalls.o.d ${OBJECTDIR}/_ext/1360937237/temphum11.o.d ${OBJECTDIR}/_ext/1360937237/servo.o.d ${OBJECTDIR}/_ext/1360937237/rgbled.o.d ${OBJECTDIR}/_ext/1360937237/main.o.d ${OBJECTDIR}/_ext/1360937237/bluesmirf.o.d
+OBJECTFILES_QUOTED_IF_SPACED=${OBJECTDIR}/_ext/1984496892/plib_clock.o ${OBJECTDIR}/_ext/1865131932/plib_cmcc.o ${OBJECTDIR}/_ext/1865161661/plib_dmac.o ${OBJECTDIR}/_ext/60167341/plib_eic.o ${OBJECTDIR}/_ext/1986646378/plib_evsys.o ${OBJECTDIR}/_ext/1865468468/plib_nvic.o ${OBJECTDIR}/_ext/1593096446/plib_nvmctrl.o ${OBJECTDIR}/_ext/1865521619/plib_port.o ${OBJECTDIR}/_ext/60180175/plib_rtc_timer.o ${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o ${OBJECTDIR}/_ext/504274921/plib_sercom5_usart.o ${OBJECTDIR}/_ext/504274921/plib_sercom3_usart.o ${OBJECTDIR}/_ext/1827571544/plib_systick.o ${OBJECTDIR}/_ext/60181570/plib_tcc0.o ${OBJECTDIR}/_ext/60181570/plib_tcc1.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/1171490990/startup_xc32.o ${OBJECTDIR}/_ext/1171490990/libc_syscalls.o ${OBJECTDIR}/_ext/1360937237/temphum11.o ${OBJECTDIR}/_ext/1360937237/servo.o ${OBJECTDIR}/_ext/1360937237/rgbled.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/bluesmirf.o ${OBJECTDIR}/_ext/1360937237/swtimer.o ${OBJECTDIR}/_ext/1360937237/tempcontrol.o ${OBJECTDIR}/_ext/1360937237/tempmodel.o ${OBJECTDIR}/_ext/1360937237/nvstore.o ${OBJECTDIR}/_ext/1360937237/stepresponse.o ${OBJECTDIR}/_ext/1360937237/rollup.o ${OBJECTDIR}/_ext/1360937237/anomaly.o ${OBJECTDIR}/_ext/1360937237/sampler.o ${OBJECTDIR}/_ext/1360937237/filter.o ${OBJECTDIR}/_ext/1360937237/currentmon.o ${OBJECTDIR}/_ext/1360937237/door.o ${OBJECTDIR}/_ext/1360937237/motion.o ${OBJECTDIR}/_ext/1360937237/servochan.o ${OBJECTDIR}/_ext/1360937237/boot.o ${OBJECTDIR}/_ext/1360937237/btrx.o ${OBJECTDIR}/_ext/1639450193/bttx.o
+POSSIBLE_DEPFILES=${OBJECTDIR}/_ext/1984496892/plib_clock.o.d ${OBJECTDIR}/_ext/1865131932/plib_cmcc.o.d ${OBJECTDIR}/_ext/1865161661/plib_dmac.o.d ${OBJECTDIR}/_ext/60167341/plib_eic.o.d ${OBJECTDIR}/_ext/1986646378/plib_evsys.o.d ${OBJECTDIR}/_ext/1865468468/plib_nvic.o.d ${OBJECTDIR}/_ext/1593096446/plib_nvmctrl.o.d ${OBJECTDIR}/_ext/1865521619/plib_port.o.d ${OBJECTDIR}/_ext/60180175/plib_rtc_timer.o.d ${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o.d ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o.d ${OBJECTDIR}/_ext/504274921/plib_sercom5_usart.o.d ${OBJECTDIR}/_ext/504274921/plib_sercom3_usart.o.d ${OBJECTDIR}/_ext/1827571544/plib_systick.o.d ${OBJECTDIR}/_ext/60181570/plib_tcc0.o.d ${OBJECTDIR}/_ext/60181570/plib_tcc1.o.d ${OBJECTDIR}/_ext/163028504/xc32_monitor.o.d ${OBJECTDIR}/_ext/1171490990/initialization.o.d ${OBJECTDIR}/_ext/1171490990/interrupts.o.d ${OBJECTDIR}/_ext/1171490990/exceptions.o.d ${OBJECTDIR}/_ext/1171490990/startup_xc32.o.d ${OBJECTDIR}/_ext/1171490990/libc_syscalls.o.d ${OBJECTDIR}/_ext/1360937237/temphum11.o.d ${OBJECTDIR}/_ext/1360937237/servo.o.d ${OBJECTDIR}/_ext/1360937237/rgbled.o.d ${OBJECTDIR}/_ext/1360937237/main.o.d ${OBJECTDIR}/_ext/1360937237/bluesmirf.o.d ${OBJECTDIR}/_ext/1360937237/swtimer.o.d ${OBJECTDIR}/_ext/1360937237/tempcontrol.o.d ${OBJECTDIR}/_ext/1360937237/tempmodel.o.d ${OBJECTDIR}/_ext/1360937237/nvstore.o.d ${OBJECTDIR}/_ext/1360937237/stepresponse.o.d ${OBJECTDIR}/_ext/1360937237/rollup.o.d ${OBJECTDIR}/_ext/1360937237/anomaly.o.d ${OBJECTDIR}/_ext/1360937237/sampler.o.d ${OBJECTDIR}/_ext/1360937237/filter.o.d ${OBJECTDIR}/_ext/1360937237/currentmon.o.d ${OBJECTDIR}/_ext/1360937237/door.o.d ${OBJECTDIR}/_ext/1360937237/motion.o.d ${OBJECTDIR}/_ext/1360937237/servochan.o.d ${OBJECTDIR}/_ext/1360937237/boot.o.d ${OBJECTDIR}/_ext/1360937237/btrx.o.d ${OBJECTDIR}/_ext/1639450193/bttx.o.d
 
 # Object Files
-OBJECTFILES=${OBJECTDIR}/_ext/1984496892/plib_clock.o ${OBJECTDIR}/_ext/1865131932/plib_cmcc.o ${OBJECTDIR}/_ext/1865161661/plib_dmac.o ${OBJECTDIR}/_ext/60167341/plib_eic.o ${OBJECTDIR}/_ext/1986646378/plib_evsys.o ${OBJECTDIR}/_ext/1865468468/plib_nvic.o ${OBJECTDIR}/_ext/1593096446/plib_nvmctrl.o ${OBJECTDIR}/_ext/1865521619/plib_port.o ${OBJECTDIR}/_ext/60180175/plib_rtc_timer.o ${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o ${OBJECTDIR}/_ext/504274921/plib_sercom5_usart.o ${OBJECTDIR}/_ext/504274921/plib_sercom3_usart.o ${OBJECTDIR}/_ext/1827571544/plib_systick.o ${OBJECTDIR}/_ext/60181570/plib_tcc0.o ${OBJECTDIR}/_ext/60181570/plib_tcc1.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/1171490990/startup_xc32.o ${OBJECTDIR}/_ext/1171490990/libc_syscalls.o ${OBJECTDIR}/_ext/1360937237/temphum11.o ${OBJECTDIR}/_ext/1360937237/servo.o ${OBJECTDIR}/_ext/1360937237/rgbled.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/bluesmirf.o
+OBJECTFILES=${OBJECTDIR}/_ext/1984496892/plib_clock.o ${OBJECTDIR}/_ext/1865131932/plib_cmcc.o ${OBJECTDIR}/_ext/1865161661/plib_dmac.o ${OBJECTDIR}/_ext/60167341/plib_eic.o ${OBJECTDIR}/_ext/1986646378/plib_evsys.o ${OBJECTDIR}/_ext/1865468468/plib_nvic.o ${OBJECTDIR}/_ext/1593096446/plib_nvmctrl.o ${OBJECTDIR}/_ext/1865521619/plib_port.o ${OBJECTDIR}/_ext/60180175/plib_rtc_timer.o ${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o ${OBJECTDIR}/_ext/504274921/plib_sercom5_usart.o ${OBJECTDIR}/_ext/504274921/plib_sercom3_usart.o ${OBJECTDIR}/_ext/1827571544/plib_systick.o ${OBJECTDIR}/_ext/60181570/plib_tcc0.o ${OBJECTDIR}/_ext/60181570/plib_tcc1.o ${OBJECTDIR}/_ext/163028504/xc32_monitor.o ${OBJECTDIR}/_ext/1171490990/initialization.o ${OBJECTDIR}/_ext/1171490990/interrupts.o ${OBJECTDIR}/_ext/1171490990/exceptions.o ${OBJECTDIR}/_ext/1171490990/startup_xc32.o ${OBJECTDIR}/_ext/1171490990/libc_syscalls.o ${OBJECTDIR}/_ext/1360937237/temphum11.o ${OBJECTDIR}/_ext/1360937237/servo.o ${OBJECTDIR}/_ext/1360937237/rgbled.o ${OBJECTDIR}/_ext/1360937237/main.o ${OBJECTDIR}/_ext/1360937237/bluesmirf.o ${OBJECTDIR}/_ext/1360937237/swtimer.o ${OBJECTDIR}/_ext/1360937237/tempcontrol.o ${OBJECTDIR}/_ext/1360937237/tempmodel.o ${OBJECTDIR}/_ext/1360937237/nvstore.o ${OBJECTDIR}/_ext/1360937237/stepresponse.o ${OBJECTDIR}/_ext/1360937237/rollup.o ${OBJECTDIR}/_ext/1360937237/anomaly.o ${OBJECTDIR}/_ext/1360937237/sampler.o ${OBJECTDIR}/_ext/1360937237/filter.o ${OBJECTDIR}/_ext/1360937237/currentmon.o ${OBJECTDIR}/_ext/1360937237/door.o ${OBJECTDIR}/_ext/1360937237/motion.o ${OBJECTDIR}/_ext/1360937237/servochan.o ${OBJECTDIR}/_ext/1360937237/boot.o ${OBJECTDIR}/_ext/1360937237/btrx.o ${OBJECTDIR}/_ext/1639450193/bttx.o
 
 # Source Files
-SOURCEFILES=../src/config/default/peripheral/clock/plib_clock.c ../src/config/default/peripheral/cmcc/plib_cmcc.c ../src/config/default/peripheral/dmac/plib_dmac.c ../src/config/default/peripheral/eic/plib_eic.c ../src/config/default/peripheral/evsys/plib_evsys.c ../src/config/default/peripheral/nvic/plib_nvic.c ../src/config/default/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/default/peripheral/port/plib_port.c ../src/config/default/peripheral/rtc/plib_rtc_timer.c ../src/config/default/peripheral/sercom/i2c_master/plib_sercom2_i2c_master.c ../src/config/default/peripheral/sercom/i2c_master/plib_sercom0_i2c_master.c ../src/config/default/peripheral/sercom/usart/plib_sercom5_usart.c ../src/config/default/peripheral/sercom/usart/plib_sercom3_usart.c ../src/config/default/peripheral/systick/plib_systick.c ../src/config/default/peripheral/tcc/plib_tcc0.c ../src/config/default/peripheral/tcc/plib_tcc1.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../src/config/default/startup_xc32.c ../src/config/default/libc_syscalls.c ../src/temphum11.c ../src/servo.c ../src/rgbled.cpp ../src/main.cpp ../src/bluesmirf.cpp
+SOURCEFILES=../src/config/default/peripheral/clock/plib_clock.c ../src/config/default/peripheral/cmcc/plib_cmcc.c ../src/config/default/peripheral/dmac/plib_dmac.c ../src/config/default/peripheral/eic/plib_eic.c ../src/config/default/peripheral/evsys/plib_evsys.c ../src/config/default/peripheral/nvic/plib_nvic.c ../src/config/default/peripheral/nvmctrl/plib_nvmctrl.c ../src/config/default/peripheral/port/plib_port.c ../src/config/default/peripheral/rtc/plib_rtc_timer.c ../src/config/default/peripheral/sercom/i2c_master/plib_sercom2_i2c_master.c ../src/config/default/peripheral/sercom/i2c_master/plib_sercom0_i2c_master.c ../src/config/default/peripheral/sercom/usart/plib_sercom5_usart.c ../src/config/default/peripheral/sercom/usart/plib_sercom3_usart.c ../src/config/default/peripheral/systick/plib_systick.c ../src/config/default/peripheral/tcc/plib_tcc0.c ../src/config/default/peripheral/tcc/plib_tcc1.c ../src/config/default/stdio/xc32_monitor.c ../src/config/default/initialization.c ../src/config/default/interrupts.c ../src/config/default/exceptions.c ../src/config/default/startup_xc32.c ../src/config/default/libc_syscalls.c ../src/temphum11.c ../src/servo.c ../src/rgbled.cpp ../src/main.cpp ../src/bluesmirf.cpp ../src/swtimer.c ../src/tempcontrol.cpp ../src/tempmodel.cpp ../src/nvstore.c ../src/stepresponse.cpp ../src/rollup.c ../src/anomaly.cpp ../src/sampler.cpp ../src/filter.c ../src/currentmon.c ../src/door.cpp ../src/motion.c ../src/servochan.c ../src/boot.c ../src/btrx.c ../src/drivers/bttx.c
 
 # Pack Options 
 PACK_COMMON_OPTIONS=-I "${CMSIS_DIR}/CMSIS/Core/Include"
@@ -164,13 +164,13 @@ ${OBJECTDIR}/_ext/60180175/plib_rtc_timer.o: ../src/config/default/peripheral/rt
 	@${RM} ${OBJECTDIR}/_ext/60180175/plib_rtc_timer.o 
 	${MP_CPPC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/60180175/plib_rtc_timer.o.d" -o ${OBJECTDIR}/_ext/60180175/plib_rtc_timer.o ../src/config/default/peripheral/rtc/plib_rtc_timer.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
 	
-${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o: ../src/config/default/peripheral/sercom/i2c_master/plib_sercom2_i2c_master.c  .generated_files/flags/default/68174834d3a8067fd22d974df8253bda51a9d1cd .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o: ../src/config/default/peripheral/sercom/i2c_master/plib_sercom2_i2c_master.c  .generated_files/flags/default/cd5d9b6e14f9aaa6c3e52852e276025efae62d06 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
 	@${MKDIR} "${OBJECTDIR}/_ext/508257091" 
 	@${RM} ${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o.d 
 	@${RM} ${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o 
 	${MP_CPPC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o.d" -o ${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o ../src/config/default/peripheral/sercom/i2c_master/plib_sercom2_i2c_master.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
 	
-${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o: ../src/config/default/peripheral/sercom/i2c_master/plib_sercom0_i2c_master.c  .generated_files/flags/default/c1c2fde6bc8e7a20d0b5899f5479f569765d439c .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o: ../src/config/default/peripheral/sercom/i2c_master/plib_sercom0_i2c_master.c  .generated_files/flags/default/0c46c191e4c61e62299ff5c46496f58bf17242f1 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
 	@${MKDIR} "${OBJECTDIR}/_ext/508257091" 
 	@${RM} ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o.d 
 	@${RM} ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o 
@@ -254,6 +254,66 @@ ${OBJECTDIR}/_ext/1360937237/servo.o: ../src/servo.c  .generated_files/flags/def
 	@${RM} ${OBJECTDIR}/_ext/1360937237/servo.o 
 	${MP_CPPC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/servo.o.d" -o ${OBJECTDIR}/_ext/1360937237/servo.o ../src/servo.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
 	
+${OBJECTDIR}/_ext/1360937237/swtimer.o: ../src/swtimer.c  .generated_files/flags/default/e523fef478c65b1d6e62a1481198acac7cb0e29a .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/swtimer.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/swtimer.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/swtimer.o.d" -o ${OBJECTDIR}/_ext/1360937237/swtimer.o ../src/swtimer.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/nvstore.o: ../src/nvstore.c  .generated_files/flags/default/af85c8f526c6f2123080570ce53f7108b31e155c .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/nvstore.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/nvstore.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/nvstore.o.d" -o ${OBJECTDIR}/_ext/1360937237/nvstore.o ../src/nvstore.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/rollup.o: ../src/rollup.c  .generated_files/flags/default/f1b6adf5014dd1bda3bb7055520b2152b979e62e .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/rollup.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/rollup.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/rollup.o.d" -o ${OBJECTDIR}/_ext/1360937237/rollup.o ../src/rollup.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/filter.o: ../src/filter.c  .generated_files/flags/default/e78ff6c84a039da8dbf430d3e34f7fc1ba1f3be2 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/filter.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/filter.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/filter.o.d" -o ${OBJECTDIR}/_ext/1360937237/filter.o ../src/filter.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/currentmon.o: ../src/currentmon.c  .generated_files/flags/default/8ab043f9fafd12779b6bafb976baedec1c497b43 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/currentmon.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/currentmon.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/currentmon.o.d" -o ${OBJECTDIR}/_ext/1360937237/currentmon.o ../src/currentmon.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/motion.o: ../src/motion.c  .generated_files/flags/default/ca448feccc6fe232c9cc21b3374baf2d7e8ae1a3 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/motion.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/motion.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/motion.o.d" -o ${OBJECTDIR}/_ext/1360937237/motion.o ../src/motion.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/servochan.o: ../src/servochan.c  .generated_files/flags/default/7c513fa767738fb7235221a8d63d4b2f02484625 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/servochan.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/servochan.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/servochan.o.d" -o ${OBJECTDIR}/_ext/1360937237/servochan.o ../src/servochan.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/boot.o: ../src/boot.c  .generated_files/flags/default/fd513b396b2922bdd7e11b7cdb0035553e8139d3 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/boot.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/boot.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/boot.o.d" -o ${OBJECTDIR}/_ext/1360937237/boot.o ../src/boot.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/btrx.o: ../src/btrx.c  .generated_files/flags/default/f2533a382754a7ccef0e52041f8b61bbdac5a18f .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/btrx.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/btrx.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/btrx.o.d" -o ${OBJECTDIR}/_ext/1360937237/btrx.o ../src/btrx.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1639450193/bttx.o: ../src/drivers/bttx.c  .generated_files/flags/default/d97fb3d32066b5899f4e470b10830cd13a4097ec .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1639450193" 
+	@${RM} ${OBJECTDIR}/_ext/1639450193/bttx.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1639450193/bttx.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1639450193/bttx.o.d" -o ${OBJECTDIR}/_ext/1639450193/bttx.o ../src/drivers/bttx.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
 else
 ${OBJECTDIR}/_ext/1984496892/plib_clock.o: ../src/config/default/peripheral/clock/plib_clock.c  .generated_files/flags/default/dff3c1efadb8ab3311153bded1d58c98287b359a .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
 	@${MKDIR} "${OBJECTDIR}/_ext/1984496892" 
@@ -309,13 +369,13 @@ ${OBJECTDIR}/_ext/60180175/plib_rtc_timer.o: ../src/config/default/peripheral/rt
 	@${RM} ${OBJECTDIR}/_ext/60180175/plib_rtc_timer.o 
 	${MP_CPPC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/60180175/plib_rtc_timer.o.d" -o ${OBJECTDIR}/_ext/60180175/plib_rtc_timer.o ../src/config/default/peripheral/rtc/plib_rtc_timer.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
 	
-${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o: ../src/config/default/peripheral/sercom/i2c_master/plib_sercom2_i2c_master.c  .generated_files/flags/default/1beba54b90e92f4bbdc0019a9cedac7bdfd1b76f .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o: ../src/config/default/peripheral/sercom/i2c_master/plib_sercom2_i2c_master.c  .generated_files/flags/default/937c2257c0cacb9b8931732d544cbd34b11ad635 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
 	@${MKDIR} "${OBJECTDIR}/_ext/508257091" 
 	@${RM} ${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o.d 
 	@${RM} ${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o 
 	${MP_CPPC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o.d" -o ${OBJECTDIR}/_ext/508257091/plib_sercom2_i2c_master.o ../src/config/default/peripheral/sercom/i2c_master/plib_sercom2_i2c_master.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
 	
-${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o: ../src/config/default/peripheral/sercom/i2c_master/plib_sercom0_i2c_master.c  .generated_files/flags/default/f151570ab37dc4509b12b09284b7780224cfe1c9 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o: ../src/config/default/peripheral/sercom/i2c_master/plib_sercom0_i2c_master.c  .generated_files/flags/default/3595ffe315a414c18ab10c8ed37ce5471abf244e .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
 	@${MKDIR} "${OBJECTDIR}/_ext/508257091" 
 	@${RM} ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o.d 
 	@${RM} ${OBJECTDIR}/_ext/508257091/plib_sercom0_i2c_master.o 
@@ -399,6 +459,66 @@ ${OBJECTDIR}/_ext/1360937237/servo.o: ../src/servo.c  .generated_files/flags/def
 	@${RM} ${OBJECTDIR}/_ext/1360937237/servo.o 
 	${MP_CPPC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/servo.o.d" -o ${OBJECTDIR}/_ext/1360937237/servo.o ../src/servo.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
 	
+${OBJECTDIR}/_ext/1360937237/swtimer.o: ../src/swtimer.c  .generated_files/flags/default/6205f176cb33c65203752859e362990fa67c7520 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/swtimer.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/swtimer.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/swtimer.o.d" -o ${OBJECTDIR}/_ext/1360937237/swtimer.o ../src/swtimer.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/nvstore.o: ../src/nvstore.c  .generated_files/flags/default/43dd4fac0ebe73c54c03a528c6eb1e13b5dfef91 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/nvstore.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/nvstore.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/nvstore.o.d" -o ${OBJECTDIR}/_ext/1360937237/nvstore.o ../src/nvstore.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/rollup.o: ../src/rollup.c  .generated_files/flags/default/59b90cb20d5d55c8d064f8976de7883d73f18bb1 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/rollup.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/rollup.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/rollup.o.d" -o ${OBJECTDIR}/_ext/1360937237/rollup.o ../src/rollup.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/filter.o: ../src/filter.c  .generated_files/flags/default/4f6d10c21ec947263a307ead6a10c831a426cd07 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/filter.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/filter.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/filter.o.d" -o ${OBJECTDIR}/_ext/1360937237/filter.o ../src/filter.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/currentmon.o: ../src/currentmon.c  .generated_files/flags/default/3132a9eae2b7d07d49c616fec0bd715d1a86c28b .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/currentmon.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/currentmon.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/currentmon.o.d" -o ${OBJECTDIR}/_ext/1360937237/currentmon.o ../src/currentmon.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/motion.o: ../src/motion.c  .generated_files/flags/default/81e7d2c69f537b2987359f43cb25024903c553f7 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/motion.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/motion.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/motion.o.d" -o ${OBJECTDIR}/_ext/1360937237/motion.o ../src/motion.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/servochan.o: ../src/servochan.c  .generated_files/flags/default/45fb2a24cb17e1144d57e313bc5556c482707336 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/servochan.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/servochan.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/servochan.o.d" -o ${OBJECTDIR}/_ext/1360937237/servochan.o ../src/servochan.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/boot.o: ../src/boot.c  .generated_files/flags/default/3f473c3941ac3ce6f98e01cc04452679a803a185 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/boot.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/boot.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/boot.o.d" -o ${OBJECTDIR}/_ext/1360937237/boot.o ../src/boot.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/btrx.o: ../src/btrx.c  .generated_files/flags/default/5760e27f0f10a53daae092014c7e99c9e710bc2c .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/btrx.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/btrx.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/btrx.o.d" -o ${OBJECTDIR}/_ext/1360937237/btrx.o ../src/btrx.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1639450193/bttx.o: ../src/drivers/bttx.c  .generated_files/flags/default/0b1336599c30d79d7b070f2a33c123f73ec92f50 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1639450193" 
+	@${RM} ${OBJECTDIR}/_ext/1639450193/bttx.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1639450193/bttx.o 
+	${MP_CPPC}  $(MP_EXTRA_CC_PRE)  -g -x c -c -mprocessor=$(MP_PROCESSOR_OPTION)  -ffunction-sections -fdata-sections -O1 -fno-common -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -Werror -Wall -MP -MMD -MF "${OBJECTDIR}/_ext/1639450193/bttx.o.d" -o ${OBJECTDIR}/_ext/1639450193/bttx.o ../src/drivers/bttx.c    -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
 endif
 
 # ------------------------------------------------------------------------------------
@@ -422,6 +542,42 @@ ${OBJECTDIR}/_ext/1360937237/bluesmirf.o: ../src/bluesmirf.cpp  .generated_files
 	@${RM} ${OBJECTDIR}/_ext/1360937237/bluesmirf.o 
 	${MP_CPPC} $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c++ -c -mprocessor=$(MP_PROCESSOR_OPTION)  -frtti -fexceptions -fno-check-new -fenforce-eh-specs -ffunction-sections -O1 -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/bluesmirf.o.d" -o ${OBJECTDIR}/_ext/1360937237/bluesmirf.o ../src/bluesmirf.cpp   -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
 	
+${OBJECTDIR}/_ext/1360937237/tempcontrol.o: ../src/tempcontrol.cpp  .generated_files/flags/default/ff356c36623edf85046028488b2a014cdf021abc .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tempcontrol.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tempcontrol.o 
+	${MP_CPPC} $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c++ -c -mprocessor=$(MP_PROCESSOR_OPTION)  -frtti -fexceptions -fno-check-new -fenforce-eh-specs -ffunction-sections -O1 -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/tempcontrol.o.d" -o ${OBJECTDIR}/_ext/1360937237/tempcontrol.o ../src/tempcontrol.cpp   -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/tempmodel.o: ../src/tempmodel.cpp  .generated_files/flags/default/075d1bb5939aa21a80bad062202f56d61428c8bc .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tempmodel.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tempmodel.o 
+	${MP_CPPC} $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c++ -c -mprocessor=$(MP_PROCESSOR_OPTION)  -frtti -fexceptions -fno-check-new -fenforce-eh-specs -ffunction-sections -O1 -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/tempmodel.o.d" -o ${OBJECTDIR}/_ext/1360937237/tempmodel.o ../src/tempmodel.cpp   -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/stepresponse.o: ../src/stepresponse.cpp  .generated_files/flags/default/953c0530eaa4f7327a9954bbce5e92f77f2df617 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/stepresponse.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/stepresponse.o 
+	${MP_CPPC} $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c++ -c -mprocessor=$(MP_PROCESSOR_OPTION)  -frtti -fexceptions -fno-check-new -fenforce-eh-specs -ffunction-sections -O1 -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/stepresponse.o.d" -o ${OBJECTDIR}/_ext/1360937237/stepresponse.o ../src/stepresponse.cpp   -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/anomaly.o: ../src/anomaly.cpp  .generated_files/flags/default/f0ff3c2bb8fb41daa8e5871e796ffc8fbf81f282 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/anomaly.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/anomaly.o 
+	${MP_CPPC} $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c++ -c -mprocessor=$(MP_PROCESSOR_OPTION)  -frtti -fexceptions -fno-check-new -fenforce-eh-specs -ffunction-sections -O1 -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/anomaly.o.d" -o ${OBJECTDIR}/_ext/1360937237/anomaly.o ../src/anomaly.cpp   -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/sampler.o: ../src/sampler.cpp  .generated_files/flags/default/b319a3fbe8d8adb74f844bf5eec9efb2734e336a .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/sampler.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/sampler.o 
+	${MP_CPPC} $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c++ -c -mprocessor=$(MP_PROCESSOR_OPTION)  -frtti -fexceptions -fno-check-new -fenforce-eh-specs -ffunction-sections -O1 -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/sampler.o.d" -o ${OBJECTDIR}/_ext/1360937237/sampler.o ../src/sampler.cpp   -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/door.o: ../src/door.cpp  .generated_files/flags/default/06897632ad56ed2257552870c5f9bb68d0a9f18f .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/door.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/door.o 
+	${MP_CPPC} $(MP_EXTRA_CC_PRE) -g -D__DEBUG   -x c++ -c -mprocessor=$(MP_PROCESSOR_OPTION)  -frtti -fexceptions -fno-check-new -fenforce-eh-specs -ffunction-sections -O1 -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/door.o.d" -o ${OBJECTDIR}/_ext/1360937237/door.o ../src/door.cpp   -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
 else
 ${OBJECTDIR}/_ext/1360937237/rgbled.o: ../src/rgbled.cpp  .generated_files/flags/default/8eebf52615d7f992ccf77d2465945b55520db40b .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
 	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
@@ -441,6 +597,42 @@ ${OBJECTDIR}/_ext/1360937237/bluesmirf.o: ../src/bluesmirf.cpp  .generated_files
 	@${RM} ${OBJECTDIR}/_ext/1360937237/bluesmirf.o 
 	${MP_CPPC} $(MP_EXTRA_CC_PRE)  -g -x c++ -c -mprocessor=$(MP_PROCESSOR_OPTION)  -frtti -fexceptions -fno-check-new -fenforce-eh-specs -ffunction-sections -O1 -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/bluesmirf.o.d" -o ${OBJECTDIR}/_ext/1360937237/bluesmirf.o ../src/bluesmirf.cpp   -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
 	
+${OBJECTDIR}/_ext/1360937237/tempcontrol.o: ../src/tempcontrol.cpp  .generated_files/flags/default/704cf65b86d5ba732a2ecf3e29ca37f4d0cdb1dc .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tempcontrol.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tempcontrol.o 
+	${MP_CPPC} $(MP_EXTRA_CC_PRE)  -g -x c++ -c -mprocessor=$(MP_PROCESSOR_OPTION)  -frtti -fexceptions -fno-check-new -fenforce-eh-specs -ffunction-sections -O1 -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/tempcontrol.o.d" -o ${OBJECTDIR}/_ext/1360937237/tempcontrol.o ../src/tempcontrol.cpp   -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/tempmodel.o: ../src/tempmodel.cpp  .generated_files/flags/default/051e6650ae4fc9d1f9184b8e71f45698417bb8c1 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tempmodel.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/tempmodel.o 
+	${MP_CPPC} $(MP_EXTRA_CC_PRE)  -g -x c++ -c -mprocessor=$(MP_PROCESSOR_OPTION)  -frtti -fexceptions -fno-check-new -fenforce-eh-specs -ffunction-sections -O1 -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/tempmodel.o.d" -o ${OBJECTDIR}/_ext/1360937237/tempmodel.o ../src/tempmodel.cpp   -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/stepresponse.o: ../src/stepresponse.cpp  .generated_files/flags/default/05beb203d98829cea12c44cabc21d4f59ab8644d .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/stepresponse.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/stepresponse.o 
+	${MP_CPPC} $(MP_EXTRA_CC_PRE)  -g -x c++ -c -mprocessor=$(MP_PROCESSOR_OPTION)  -frtti -fexceptions -fno-check-new -fenforce-eh-specs -ffunction-sections -O1 -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/stepresponse.o.d" -o ${OBJECTDIR}/_ext/1360937237/stepresponse.o ../src/stepresponse.cpp   -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/anomaly.o: ../src/anomaly.cpp  .generated_files/flags/default/cb93dd31da098075b4cc7de1793c45d22e1b467a .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/anomaly.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/anomaly.o 
+	${MP_CPPC} $(MP_EXTRA_CC_PRE)  -g -x c++ -c -mprocessor=$(MP_PROCESSOR_OPTION)  -frtti -fexceptions -fno-check-new -fenforce-eh-specs -ffunction-sections -O1 -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/anomaly.o.d" -o ${OBJECTDIR}/_ext/1360937237/anomaly.o ../src/anomaly.cpp   -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/sampler.o: ../src/sampler.cpp  .generated_files/flags/default/e40d7669ac5aba86dc9894fee5c9af16ddccf089 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/sampler.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/sampler.o 
+	${MP_CPPC} $(MP_EXTRA_CC_PRE)  -g -x c++ -c -mprocessor=$(MP_PROCESSOR_OPTION)  -frtti -fexceptions -fno-check-new -fenforce-eh-specs -ffunction-sections -O1 -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/sampler.o.d" -o ${OBJECTDIR}/_ext/1360937237/sampler.o ../src/sampler.cpp   -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
+${OBJECTDIR}/_ext/1360937237/door.o: ../src/door.cpp  .generated_files/flags/default/3cf72812bf605638abd5492c7a8f30453d9ae187 .generated_files/flags/default/4c3f5d7fc1567776caa35eca785034a4542d577c
+	@${MKDIR} "${OBJECTDIR}/_ext/1360937237" 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/door.o.d 
+	@${RM} ${OBJECTDIR}/_ext/1360937237/door.o 
+	${MP_CPPC} $(MP_EXTRA_CC_PRE)  -g -x c++ -c -mprocessor=$(MP_PROCESSOR_OPTION)  -frtti -fexceptions -fno-check-new -fenforce-eh-specs -ffunction-sections -O1 -I"../src" -I"../src/config/default" -I"../src/packs/ATSAME51J20A_DFP" -I"../src/packs/CMSIS/" -I"../src/packs/CMSIS/CMSIS/Core/Include" -MP -MMD -MF "${OBJECTDIR}/_ext/1360937237/door.o.d" -o ${OBJECTDIR}/_ext/1360937237/door.o ../src/door.cpp   -DXPRJ_default=$(CND_CONF)  $(COMPARISON_BUILD)  -mdfp="${DFP_DIR}" ${PACK_COMMON_OPTIONS} 
+	
 endif
 
 # ------------------------------------------------------------------------------------
@@ -0,0 +1,92 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include <math.h>
+#include "sim.h"
+#include "plant.h"
+#include "bench.h"
+
+/**
+ * @brief Bench ctx object definition.
+ */
+typedef struct
+{
+    double setpoint_c;
+    uint64_t settle_us;
+
+    double min_c;
+    double max_c;
+    double sum_sq;
+    uint64_t samples;
+
+} bench_t;
+
+static bench_t bench_ctx;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static void sample_priv ( uintptr_t context );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void bench_start ( double setpoint_c )
+{
+    bench_ctx.setpoint_c = setpoint_c;
+    bench_ctx.settle_us = SIM_TIME_NEVER;
+    bench_ctx.min_c = setpoint_c;
+    bench_ctx.max_c = setpoint_c;
+    bench_ctx.sum_sq = 0.0;
+    bench_ctx.samples = 0;
+
+    sim_schedule( sim_time_us( ), sample_priv, 0 );
+}
+
+void bench_metrics ( bench_metrics_t *metrics )
+{
+    const plant_stats_t *st = plant_stats( );
+
+    metrics->setpoint_c = bench_ctx.setpoint_c;
+    metrics->settle_us = bench_ctx.settle_us;
+    metrics->overshoot_c = bench_ctx.setpoint_c - bench_ctx.min_c;
+    metrics->peak_error_c = bench_ctx.max_c - bench_ctx.setpoint_c;
+    metrics->rms_error_c = ( bench_ctx.samples > 0 ) ? sqrt( bench_ctx.sum_sq / bench_ctx.samples ) : 0.0;
+    metrics->cell_switches = st->cell_switches;
+    metrics->cell_wh = st->cell_energy_j / 3600.0;
+    metrics->fan_wh = st->fan_energy_j / 3600.0;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void sample_priv ( uintptr_t context )
+{
+    double air = plant_air_c( );
+    double err = air - bench_ctx.setpoint_c;
+
+    if ( ( bench_ctx.settle_us == SIM_TIME_NEVER ) && ( err <= BENCH_SETTLE_C ) )
+    {
+        bench_ctx.settle_us = sim_time_us( );
+    }
+
+    if ( bench_ctx.settle_us != SIM_TIME_NEVER )
+    {
+        if ( air < bench_ctx.min_c )
+        {
+            bench_ctx.min_c = air;
+        }
+        if ( air > bench_ctx.max_c )
+        {
+            bench_ctx.max_c = air;
+        }
+        bench_ctx.sum_sq += err * err;
+        bench_ctx.samples++;
+    }
+
+    sim_schedule( sim_time_us( ) + BENCH_SAMPLE_US, sample_priv, 0 );
+}
+
+// ------------------------------------------------------------------------- END
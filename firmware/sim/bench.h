@@ -0,0 +1,94 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the control quality metrics.
+ *
+ * The air temperature of the plant is sampled at a fixed interval and
+ * compared with the setpoint of the scenario. The case is settled the first
+ * time the air comes within BENCH_SETTLE_C of the setpoint; overshoot, peak and RMS error are
+ * measured from then on, so the pull-down does not hide the regulation.
+ *
+ * \addtogroup bench Benchmark Metrics
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+#define BENCH_SAMPLE_US             1000000ULL
+
+/* Controllers that anticipate the lag stop just short of the setpoint */
+#define BENCH_SETTLE_C              0.1
+
+/** \} */ // End group macro
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup type Types
+ * \{
+ */
+
+typedef struct
+{
+    double setpoint_c;
+
+    // time from power up to the first sample within BENCH_SETTLE_C of the
+    // setpoint, SIM_TIME_NEVER if the case never got there
+    uint64_t settle_us;
+
+    // deepest excursion below and highest above the setpoint once settled
+    double overshoot_c;
+    double peak_error_c;
+    double rms_error_c;
+
+    uint32_t cell_switches;
+    double cell_wh;
+    double fan_wh;
+
+} bench_metrics_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Start function.
+ *
+ * @param setpoint_c   Temperature the controller is asked to hold.
+ *
+ * @description This function schedules the sampling of the plant from the
+ * current simulated time.
+ */
+void bench_start ( double setpoint_c );
+
+/**
+ * @brief Metrics function.
+ *
+ * @param metrics      Filled with the results up to the current time.
+ */
+void bench_metrics ( bench_metrics_t *metrics );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _BENCH_H_
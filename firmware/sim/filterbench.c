@@ -0,0 +1,189 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * Host benchmark of the sensor filter pipeline.
+ *
+ * A temperature-like signal in 0.01 C (slow ramp and sine, Gaussian noise of
+ * a 14-bit HDC1080 reading and a spike every thousand readings) is pushed
+ * through a set of pipeline configurations. For each one the time and, on
+ * x86, the TSC cycles per reading are printed with the RMS and worst error
+ * of the output against the clean signal.
+ *
+ * Host cycles are only a relative measure: the Cortex-M4 has a single cycle
+ * 32x32->64 MAC but no branch predictor worth the name.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "filter.h"
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#define BENCH_CYCLES( )             __rdtsc( )
+#else
+#define BENCH_CYCLES( )             0ULL
+#endif
+
+#define BENCH_READINGS              4000000
+#define BENCH_SAMPLE_HZ             2.0f
+#define BENCH_NOISE                 1.0         // 0.01 C rms
+#define BENCH_SPIKE                 500         // 5 C
+#define BENCH_SPIKE_EVERY           1000
+
+typedef struct
+{
+    const char *name;
+    filter_cfg_t cfg;
+    float cutoff_hz;            // designs the biquad when not zero
+
+} bench_config_t;
+
+static const bench_config_t bench_configs[] =
+{
+    { "raw",                { 1, 1, FILTER_SMOOTH_NONE,   0, { 0 } }, 0.0f  },
+    { "median3",            { 1, 3, FILTER_SMOOTH_NONE,   0, { 0 } }, 0.0f  },
+    { "median7",            { 1, 7, FILTER_SMOOTH_NONE,   0, { 0 } }, 0.0f  },
+    { "ema/2",              { 1, 1, FILTER_SMOOTH_EMA,    1, { 0 } }, 0.0f  },
+    { "biquad 0.05 Hz",     { 1, 1, FILTER_SMOOTH_BIQUAD, 0, { 0 } }, 0.05f },
+    { "median3+ema/2",      { 1, 3, FILTER_SMOOTH_EMA,    1, { 0 } }, 0.0f  },
+    { "median5+biquad",     { 1, 5, FILTER_SMOOTH_BIQUAD, 0, { 0 } }, 0.05f },
+    { "x4+median3+ema/2",   { 4, 3, FILTER_SMOOTH_EMA,    1, { 0 } }, 0.0f  },
+};
+
+#define BENCH_CONFIGS               ( sizeof( bench_configs ) / sizeof( bench_configs[ 0 ] ) )
+
+static int32_t *bench_raw;
+static int32_t *bench_clean;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static void signal_priv ( );
+static double gauss_priv ( );
+static void run_priv ( const bench_config_t *bc );
+
+// -------------------------------------------------------------------- MAIN
+
+int main ( void )
+{
+    uint8_t i;
+
+    bench_raw = malloc( BENCH_READINGS * sizeof( int32_t ) );
+    bench_clean = malloc( BENCH_READINGS * sizeof( int32_t ) );
+    if ( ( bench_raw == NULL ) || ( bench_clean == NULL ) )
+    {
+        return EXIT_FAILURE;
+    }
+
+    signal_priv( );
+
+    printf( "%u readings at %.1f Hz, noise %.2f C rms, a %.0f C spike every %u\n\n",
+            BENCH_READINGS, BENCH_SAMPLE_HZ, BENCH_NOISE / 100.0, BENCH_SPIKE / 100.0,
+            BENCH_SPIKE_EVERY );
+    printf( "%-18s %10s %10s %10s %10s\n", "pipeline", "ns/read", "cyc/read", "rms C", "worst C" );
+
+    for ( i = 0; i < BENCH_CONFIGS; i++ )
+    {
+        run_priv( &bench_configs[ i ] );
+    }
+
+    free( bench_raw );
+    free( bench_clean );
+
+    return EXIT_SUCCESS;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void signal_priv ( )
+{
+    double t;
+    double v;
+    uint32_t i;
+
+    srand( 1080 );
+
+    for ( i = 0; i < BENCH_READINGS; i++ )
+    {
+        t = i / BENCH_SAMPLE_HZ;
+
+        // 5 C with a 1 C swing every 20 minutes
+        v = 500.0 + 100.0 * sin( 2.0 * M_PI * t / 1200.0 );
+        bench_clean[ i ] = ( int32_t )lround( v );
+
+        v += BENCH_NOISE * gauss_priv( );
+        if ( ( i % BENCH_SPIKE_EVERY ) == BENCH_SPIKE_EVERY / 2 )
+        {
+            v += BENCH_SPIKE;
+        }
+        bench_raw[ i ] = ( int32_t )lround( v );
+    }
+}
+
+static double gauss_priv ( )
+{
+    double u1 = ( rand( ) + 1.0 ) / ( RAND_MAX + 2.0 );
+    double u2 = ( rand( ) + 1.0 ) / ( RAND_MAX + 2.0 );
+
+    return sqrt( -2.0 * log( u1 ) ) * cos( 2.0 * M_PI * u2 );
+}
+
+static void run_priv ( const bench_config_t *bc )
+{
+    filter_cfg_t cfg = bc->cfg;
+    filter_t filter;
+    struct timespec start;
+    struct timespec end;
+    uint64_t cycles;
+    double ns;
+    double err;
+    double sum = 0.0;
+    double worst = 0.0;
+    uint32_t count = 0;
+    uint32_t i;
+    int32_t out;
+    volatile int32_t sink = 0;
+
+    if ( bc->cutoff_hz > 0.0f )
+    {
+        filter_design_lowpass( &cfg, bc->cutoff_hz, BENCH_SAMPLE_HZ / cfg.decimation );
+    }
+
+    // timed pass without the error bookkeeping
+    filter_init( &filter, &cfg );
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    cycles = BENCH_CYCLES( );
+    for ( i = 0; i < BENCH_READINGS; i++ )
+    {
+        if ( filter_push( &filter, bench_raw[ i ], &out ) )
+        {
+            sink += out;
+        }
+    }
+    cycles = BENCH_CYCLES( ) - cycles;
+    clock_gettime( CLOCK_MONOTONIC, &end );
+    ns = ( end.tv_sec - start.tv_sec ) * 1e9 + ( end.tv_nsec - start.tv_nsec );
+
+    // error against the clean signal, after the start-up transient
+    filter_init( &filter, &cfg );
+    for ( i = 0; i < BENCH_READINGS; i++ )
+    {
+        if ( filter_push( &filter, bench_raw[ i ], &out ) && ( i > 1000 ) )
+        {
+            err = ( out - bench_clean[ i ] ) / 100.0;
+            sum += err * err;
+            worst = ( fabs( err ) > worst ) ? fabs( err ) : worst;
+            count++;
+        }
+    }
+
+    printf( "%-18s %10.2f %10.1f %10.4f %10.3f\n", bc->name, ns / BENCH_READINGS,
+            ( double )cycles / BENCH_READINGS, sqrt( sum / count ), worst );
+}
+
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,373 @@
+/*******************************************************************************
+  System Definitions (host simulation)
+
+  File Name:
+    definitions.h
+
+  Summary:
+    Host replacement for config/default/definitions.h.
+
+  Description:
+    This file declares the subset of the Harmony peripheral libraries used by
+    the application, with the same names and signatures as the generated
+    plibs. The implementation lives in sim_plib.c and drives the simulated
+    cold case instead of the SAME51 registers, so the application sources
+    build unmodified for the host.
+ *******************************************************************************/
+
+#ifndef DEFINITIONS_H
+#define DEFINITIONS_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+extern "C" {
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: System
+// *****************************************************************************
+// *****************************************************************************
+
+void SYS_Initialize( void *data );
+
+void NVIC_INT_Enable( void );
+bool NVIC_INT_Disable( void );
+void NVIC_INT_Restore( bool state );
+
+/* Wait for interrupt: the simulation skips straight to the next event */
+void sim_idle( void );
+#define __WFI()                     sim_idle()
+
+#define __ALIGNED(x)                __attribute__((aligned(x)))
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: PORT
+// *****************************************************************************
+// *****************************************************************************
+
+#define SIM_PORT_GROUPS             2
+
+/* Numbered as PORT_PIN_PAxx and PORT_PIN_PBxx, 32 to a group */
+typedef enum
+{
+    SIM_PIN_PS_ON = 2,
+    SIM_PIN_LED0 = 14,
+    SIM_PIN_SERVO_OE = 18,
+    SIM_PIN_PS_SW = 35
+
+} SIM_PIN;
+
+void sim_port_set( SIM_PIN pin );
+void sim_port_clear( SIM_PIN pin );
+void sim_port_toggle( SIM_PIN pin );
+uint32_t sim_port_get( SIM_PIN pin );
+
+void sim_port_group_set( uint8_t group, uint32_t mask );
+void sim_port_group_clear( uint8_t group, uint32_t mask );
+void sim_port_group_toggle( uint8_t group, uint32_t mask );
+uint32_t sim_port_group_read( uint8_t group, uint32_t mask );
+
+#define PS_ON_Set()                 sim_port_set( SIM_PIN_PS_ON )
+#define PS_ON_Clear()               sim_port_clear( SIM_PIN_PS_ON )
+#define PS_ON_Toggle()              sim_port_toggle( SIM_PIN_PS_ON )
+#define PS_ON_Get()                 sim_port_get( SIM_PIN_PS_ON )
+
+#define LED0_Set()                  sim_port_set( SIM_PIN_LED0 )
+#define LED0_Clear()                sim_port_clear( SIM_PIN_LED0 )
+#define LED0_Toggle()               sim_port_toggle( SIM_PIN_LED0 )
+#define LED0_Get()                  sim_port_get( SIM_PIN_LED0 )
+
+#define SERVO_OE_Set()              sim_port_set( SIM_PIN_SERVO_OE )
+#define SERVO_OE_Clear()            sim_port_clear( SIM_PIN_SERVO_OE )
+#define SERVO_OE_Toggle()           sim_port_toggle( SIM_PIN_SERVO_OE )
+#define SERVO_OE_Get()              sim_port_get( SIM_PIN_SERVO_OE )
+
+/* The power switch is the only input polled by the main loop every pass */
+#define PS_SW_Get()                 ( sim_idle( ), sim_port_get( SIM_PIN_PS_SW ) )
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SYSTICK
+// *****************************************************************************
+// *****************************************************************************
+
+#define SYSTICK_FREQ                    120000000U
+#define SYSTICK_INTERRUPT_PERIOD_IN_US  (1000U)
+
+void SYSTICK_TimerStart ( void );
+void SYSTICK_TimerStop ( void );
+void SYSTICK_DelayMs ( uint32_t delay_ms );
+void SYSTICK_DelayUs ( uint32_t delay_us );
+uint32_t SYSTICK_GetTickCounter( void );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: RTC
+// *****************************************************************************
+// *****************************************************************************
+
+#define RTC_COUNTER_CLOCK_FREQUENCY     (1024U)
+
+#define RTC_MODE0_INTENSET_CMP0_Msk     (0x100U)
+#define RTC_MODE0_INTENSET_CMP1_Msk     (0x200U)
+#define RTC_MODE0_INTENSET_OVF_Msk      (0x8000U)
+
+#define RTC_TIMER32_INT_MASK_CMP0       RTC_MODE0_INTENSET_CMP0_Msk
+#define RTC_TIMER32_INT_MASK_CMP1       RTC_MODE0_INTENSET_CMP1_Msk
+#define RTC_TIMER32_INT_MASK_OVF        RTC_MODE0_INTENSET_OVF_Msk
+
+typedef uint32_t RTC_TIMER32_INT_MASK;
+typedef void (*RTC_TIMER32_CALLBACK)( RTC_TIMER32_INT_MASK intCause, uintptr_t context );
+
+void RTC_Timer32Start ( void );
+void RTC_Timer32Stop ( void );
+void RTC_Timer32CounterSet ( uint32_t count );
+uint32_t RTC_Timer32CounterGet ( void );
+uint32_t RTC_Timer32FrequencyGet ( void );
+void RTC_Timer32Compare0Set ( uint32_t compareValue );
+void RTC_Timer32Compare1Set ( uint32_t compareValue );
+uint32_t RTC_Timer32PeriodGet ( void );
+void RTC_Timer32InterruptEnable( RTC_TIMER32_INT_MASK interruptMask );
+void RTC_Timer32InterruptDisable( RTC_TIMER32_INT_MASK interruptMask );
+void RTC_Timer32CallbackRegister ( RTC_TIMER32_CALLBACK callback, uintptr_t context );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: EIC
+// *****************************************************************************
+// *****************************************************************************
+
+#define EIC_PIN_15                  (15U)
+
+typedef uint16_t EIC_PIN;
+typedef void (*EIC_CALLBACK) (uintptr_t context);
+
+void EIC_CallbackRegister(EIC_PIN pin, EIC_CALLBACK callback, uintptr_t context);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: NVMCTRL
+// *****************************************************************************
+// *****************************************************************************
+
+#define NVMCTRL_FLASH_START_ADDRESS        (0U)
+#define NVMCTRL_FLASH_PAGESIZE             (512U)
+#define NVMCTRL_FLASH_BLOCKSIZE            (8192U)
+
+bool NVMCTRL_Read( uint32_t *data, uint32_t length, const uint32_t address );
+bool NVMCTRL_PageWrite( const uint32_t* data, const uint32_t address );
+bool NVMCTRL_BlockErase( uint32_t address );
+uint16_t NVMCTRL_ErrorGet( void );
+bool NVMCTRL_IsBusy( void );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: DMAC
+// *****************************************************************************
+// *****************************************************************************
+
+#define DMAC_CHANNEL_0              (0U)
+#define DMAC_CHANNEL_1              (1U)
+#define DMAC_CHANNEL_2              (2U)
+#define DMAC_CHANNEL_3              (3U)
+#define DMAC_CHANNEL_4              (4U)
+
+typedef uint32_t DMAC_CHANNEL;
+typedef uint32_t DMAC_CHANNEL_CONFIG;
+
+/* The addresses are host pointers, the target fields are 32-bit */
+typedef struct
+{
+    uint16_t DMAC_BTCTRL;
+    uint16_t DMAC_BTCNT;
+    uintptr_t DMAC_SRCADDR;
+    uintptr_t DMAC_DSTADDR;
+    uintptr_t DMAC_DESCADDR;
+
+} dmac_descriptor_registers_t;
+
+typedef enum
+{
+    DMAC_TRANSFER_EVENT_NONE = 0,
+    DMAC_TRANSFER_EVENT_COMPLETE = 1,
+    DMAC_TRANSFER_EVENT_ERROR = 2
+
+} DMAC_TRANSFER_EVENT;
+
+typedef void (*DMAC_CHANNEL_CALLBACK) (DMAC_TRANSFER_EVENT event, uintptr_t contextHandle);
+
+void DMAC_ChannelCallbackRegister (DMAC_CHANNEL channel, const DMAC_CHANNEL_CALLBACK callback, const uintptr_t context);
+bool DMAC_ChannelTransfer (DMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize);
+bool DMAC_LinkedListTransfer (DMAC_CHANNEL channel, dmac_descriptor_registers_t* channelDesc);
+void DMAC_ChannelDisable ( DMAC_CHANNEL channel );
+bool DMAC_ChannelIsBusy ( DMAC_CHANNEL channel );
+DMAC_CHANNEL_CONFIG DMAC_ChannelSettingsGet ( DMAC_CHANNEL channel );
+uint16_t DMAC_ChannelGetTransferredCount( DMAC_CHANNEL channel );
+DMAC_TRANSFER_EVENT DMAC_ChannelTransferStatusGet(DMAC_CHANNEL channel);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: SERCOM
+// *****************************************************************************
+// *****************************************************************************
+
+/* The DATA register is a DMA source or destination, INTENCLR hands the
+   receive side of SERCOM3 from the plib interrupt to the DMA */
+typedef struct
+{
+    volatile uint8_t SERCOM_INTENCLR;
+    volatile uint32_t SERCOM_DATA;
+
+} sercom_usart_int_registers_t;
+
+#define SERCOM_USART_INT_INTENCLR_RXC_Msk   (0x4U)
+
+typedef union
+{
+    sercom_usart_int_registers_t USART_INT;
+
+} sercom_registers_t;
+
+extern sercom_registers_t sim_sercom3_regs;
+extern sercom_registers_t sim_sercom5_regs;
+#define SERCOM3_REGS                (&sim_sercom3_regs)
+#define SERCOM5_REGS                (&sim_sercom5_regs)
+
+/* SERCOM0 and SERCOM2: I2C masters */
+typedef enum
+{
+    SERCOM_I2C_ERROR_NONE,
+    SERCOM_I2C_ERROR_NAK,
+    SERCOM_I2C_ERROR_BUS,
+
+} SERCOM_I2C_ERROR;
+
+typedef void (*SERCOM_I2C_CALLBACK)(uintptr_t contextHandle);
+
+bool SERCOM0_I2C_Read(uint16_t address, uint8_t* rdData, uint32_t rdLength);
+bool SERCOM0_I2C_Write(uint16_t address, uint8_t* wrData, uint32_t wrLength);
+bool SERCOM0_I2C_WriteRead(uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength);
+bool SERCOM0_I2C_IsBusy(void);
+
+bool SERCOM2_I2C_Read(uint16_t address, uint8_t* rdData, uint32_t rdLength);
+bool SERCOM2_I2C_Write(uint16_t address, uint8_t* wrData, uint32_t wrLength);
+bool SERCOM2_I2C_WriteRead(uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength);
+bool SERCOM2_I2C_IsBusy(void);
+SERCOM_I2C_ERROR SERCOM2_I2C_ErrorGet(void);
+void SERCOM2_I2C_CallbackRegister(SERCOM_I2C_CALLBACK callback, uintptr_t contextHandle);
+
+/* SERCOM3: ring buffer USART connected to the RN-42 */
+typedef enum
+{
+    USART_DATA_8_BIT = 0x0,
+} USART_DATA;
+
+typedef enum
+{
+    USART_PARITY_NONE = 0x2,
+} USART_PARITY;
+
+typedef enum
+{
+    USART_STOP_1_BIT = 0x0,
+} USART_STOP;
+
+typedef struct
+{
+    uint32_t baudRate;
+    USART_PARITY parity;
+    USART_DATA dataWidth;
+    USART_STOP stopBits;
+
+} USART_SERIAL_SETUP;
+
+typedef uint16_t USART_ERROR;
+
+#define USART_ERROR_NONE            0U
+#define USART_ERROR_PARITY          (0x1U)
+#define USART_ERROR_FRAMING         (0x2U)
+#define USART_ERROR_OVERRUN         (0x4U)
+
+bool SERCOM3_USART_SerialSetup( USART_SERIAL_SETUP * serialSetup, uint32_t clkFrequency );
+size_t SERCOM3_USART_Write(uint8_t* pWrBuffer, const size_t size );
+size_t SERCOM3_USART_WriteCountGet(void);
+size_t SERCOM3_USART_WriteFreeBufferCountGet(void);
+size_t SERCOM3_USART_Read(uint8_t* pRdBuffer, const size_t size);
+size_t SERCOM3_USART_ReadCountGet(void);
+size_t SERCOM3_USART_ReadFreeBufferCountGet(void);
+USART_ERROR SERCOM3_USART_ErrorGet( void );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: TCC
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    TCC0_CHANNEL0,
+    TCC0_CHANNEL1,
+    TCC0_CHANNEL2,
+    TCC0_CHANNEL3,
+    TCC0_CHANNEL4,
+    TCC0_CHANNEL5
+
+} TCC0_CHANNEL_NUM;
+
+typedef enum
+{
+    TCC1_CHANNEL0,
+    TCC1_CHANNEL1,
+    TCC1_CHANNEL2,
+    TCC1_CHANNEL3
+
+} TCC1_CHANNEL_NUM;
+
+/* The compare buffers are DMA destinations; a buffer is taken at once, so
+   it is never left valid */
+typedef struct
+{
+    volatile uint32_t TCC_STATUS;
+    volatile uint32_t TCC_CCBUF[6];
+
+} tcc_registers_t;
+
+#define TCC_STATUS_CCBUFV0_Msk      (0x10000U)
+#define TCC_STATUS_CCBUFV2_Msk      (0x40000U)
+#define TCC_STATUS_CCBUFV3_Msk      (0x80000U)
+
+extern tcc_registers_t sim_tcc0_regs;
+extern tcc_registers_t sim_tcc1_regs;
+#define TCC0_REGS                   (&sim_tcc0_regs)
+#define TCC1_REGS                   (&sim_tcc1_regs)
+
+void TCC0_PWMStart(void);
+void TCC0_PWMStop(void);
+bool TCC0_PWM24bitDutySet(TCC0_CHANNEL_NUM channel, uint32_t duty);
+void TCC1_PWMStart(void);
+void TCC1_PWMStop(void);
+bool TCC1_PWM24bitDutySet(TCC1_CHANNEL_NUM channel, uint32_t duty);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+// DOM-IGNORE-END
+
+#endif /* DEFINITIONS_H */
+/*******************************************************************************
+ End of File
+*/
@@ -0,0 +1,43 @@
+/*
+ * PORT group access of the plib shim, on the simulated pins, in place of
+ * src/drivers/port_group.h.
+ */
+
+#ifndef _PORT_GROUP_H
+#define _PORT_GROUP_H
+
+#include "definitions.h"
+
+template <uint8_t Group>
+struct PortGroup
+{
+    static_assert(Group < SIM_PORT_GROUPS, "no such PORT group");
+
+    static inline void Set(uint32_t mask)
+    {
+        sim_port_group_set( Group, mask );
+    }
+
+    static inline void Clear(uint32_t mask)
+    {
+        sim_port_group_clear( Group, mask );
+    }
+
+    static inline void Toggle(uint32_t mask)
+    {
+        sim_port_group_toggle( Group, mask );
+    }
+
+    static inline uint32_t Read(uint32_t mask)
+    {
+        // the power switch is the only input polled by the main loop every
+        // pass, as PS_SW_Get()
+        if ( ( Group == SIM_PIN_PS_SW / 32 ) && ( mask & ( 1UL << ( SIM_PIN_PS_SW % 32 ) ) ) )
+        {
+            sim_idle( );
+        }
+        return sim_port_group_read( Group, mask );
+    }
+};
+
+#endif // _PORT_GROUP_H
@@ -0,0 +1,405 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include <math.h>
+#include <string.h>
+#include "definitions.h"
+#include "sim.h"
+#include "sim_pca9685.h"
+#include "plant.h"
+
+#define KELVIN                      273.15
+
+/* Servo channels wired by main.cpp: SERVO_MOTOR_1, _3 and _16 */
+#define PLANT_CH_CELL               0
+#define PLANT_CH_FAN                2
+#define PLANT_CH_DOOR               15
+
+/* Pulse to angle, inverse of the map in servo.c (0..180 deg to 10..340) */
+#define PLANT_PULSE_OFFSET          10.0
+#define PLANT_PULSE_SPAN            330.0
+#define PLANT_SWITCH_ANGLE          45.0
+#define PLANT_LID_CLOSED_ANGLE      125.0
+#define PLANT_SERVO_CHANNELS        16
+#define PLANT_SERVO_SUPPLY_V        5.0
+
+/* Magnus formula, saturation vapour pressure in hPa */
+#define PLANT_SATURATION_HPA( t )   ( 6.112 * exp( 17.62 * ( t ) / ( 243.12 + ( t ) ) ) )
+
+/**
+ * @brief Plant ctx object definition.
+ */
+typedef struct
+{
+    plant_params_t params;
+    uint64_t t_us;
+
+    double air_c;
+    double cold_c;
+    double hot_c;
+    double vapour_hpa;
+
+    // rocker switches flipped by the servos, they hold when unpowered
+    double servo_angle[ PLANT_SERVO_CHANNELS ];
+    double servo_current[ PLANT_SERVO_CHANNELS ];
+    bool cell_switch;
+    bool fan_switch;
+    double lid_angle;
+    double lid_block;
+    bool door;
+    PLANT_FAULT fault;
+
+    bool cell_on;
+    bool fan_on;
+    double cell_current;
+    double fan_current;
+
+    plant_stats_t stats;
+
+} plant_t;
+
+static plant_t plant_ctx;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static void actuators_priv ( double dt );
+static void step_priv ( double dt );
+static double servo_priv ( uint8_t channel, double dt );
+static double lid_priv ( double current, double dt );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void plant_default_params ( plant_params_t *params )
+{
+    params->ambient_c = 25.0;
+    params->ambient_swing_c = 0.0;
+    params->ambient_period_h = 24.0;
+    params->ambient_rh = 50.0;
+
+    params->air_capacity = 6000.0;
+    params->cold_capacity = 250.0;
+    params->hot_capacity = 500.0;
+
+    params->wall_conductance = 0.45;
+    params->lid_conductance = 3.0;
+    params->door_conductance = 6.0;
+    params->cold_conductance = 1.5;
+    params->hot_conductance_fan = 4.0;
+    params->hot_conductance_still = 0.6;
+
+    params->tec_seebeck = 0.053;
+    params->tec_resistance = 2.0;
+    params->tec_conductance = 0.6;
+    params->supply_v = 12.0;
+
+    params->fan_power_w = 1.8;
+
+    // small analog servos at 5 V
+    params->servo_speed_dps = 300.0;
+    params->servo_run_a = 0.25;
+    params->servo_hold_a = 0.01;
+    params->servo_stall_a = 0.7;
+
+    // the air in the case is replaced in about 30 s with the door open
+    params->vapour_exchange_seal = 1.0 / ( 4.0 * 3600.0 );
+    params->vapour_exchange_lid = 1.0 / 60.0;
+    params->vapour_exchange_door = 1.0 / 30.0;
+    params->condensation_rate = 1.0 / 1800.0;
+}
+
+void plant_init ( const plant_params_t *params )
+{
+    memset( &plant_ctx, 0, sizeof( plant_ctx ) );
+
+    plant_ctx.params = *params;
+    plant_ctx.t_us = sim_time_us( );
+    plant_ctx.air_c = params->ambient_c;
+    plant_ctx.cold_c = params->ambient_c;
+    plant_ctx.hot_c = params->ambient_c;
+    plant_ctx.vapour_hpa = params->ambient_rh / 100.0 * PLANT_SATURATION_HPA( params->ambient_c );
+    plant_ctx.lid_angle = PLANT_LID_CLOSED_ANGLE;
+    plant_ctx.lid_block = -1.0;
+    plant_ctx.stats.lid_stall_first_us = SIM_TIME_NEVER;
+
+    // where main.cpp leaves them: cell and fan off, door closed
+    plant_ctx.servo_angle[ PLANT_CH_CELL ] = 90.0;
+    plant_ctx.servo_angle[ PLANT_CH_FAN ] = 0.0;
+    plant_ctx.servo_angle[ PLANT_CH_DOOR ] = PLANT_LID_CLOSED_ANGLE;
+}
+
+void plant_advance ( uint64_t t_us )
+{
+    uint64_t dt;
+
+    while ( plant_ctx.t_us < t_us )
+    {
+        dt = t_us - plant_ctx.t_us;
+        if ( dt > PLANT_STEP_US )
+        {
+            dt = PLANT_STEP_US;
+        }
+
+        actuators_priv( ( double )dt / SIM_US_PER_S );
+        step_priv( ( double )dt / SIM_US_PER_S );
+
+        if ( plant_ctx.cell_on )
+        {
+            plant_ctx.stats.cell_on_us += dt;
+        }
+        if ( plant_ctx.fan_on )
+        {
+            plant_ctx.stats.fan_on_us += dt;
+        }
+
+        plant_ctx.t_us += dt;
+    }
+}
+
+void plant_set_door ( bool open )
+{
+    plant_ctx.door = open;
+}
+
+void plant_block_lid ( double angle )
+{
+    plant_ctx.lid_block = angle;
+}
+
+void plant_set_fault ( PLANT_FAULT fault )
+{
+    plant_ctx.fault = fault;
+}
+
+double plant_air_c ( )
+{
+    return plant_ctx.air_c;
+}
+
+double plant_humidity ( )
+{
+    double rh;
+
+    rh = 100.0 * plant_ctx.vapour_hpa / PLANT_SATURATION_HPA( plant_ctx.air_c );
+
+    return ( rh > 100.0 ) ? 100.0 : rh;
+}
+
+double plant_ambient_c ( )
+{
+    const plant_params_t *p = &plant_ctx.params;
+    double hours = ( double )plant_ctx.t_us / SIM_US_PER_HOUR;
+
+    return p->ambient_c + p->ambient_swing_c * sin( 2.0 * M_PI * hours / p->ambient_period_h );
+}
+
+double plant_hot_c ( )
+{
+    return plant_ctx.hot_c;
+}
+
+bool plant_cell_on ( )
+{
+    return plant_ctx.cell_on;
+}
+
+bool plant_fan_on ( )
+{
+    return plant_ctx.fan_on;
+}
+
+double plant_cell_current_a ( )
+{
+    return plant_ctx.cell_current;
+}
+
+double plant_fan_current_a ( )
+{
+    return plant_ctx.fan_current;
+}
+
+double plant_servo_current_a ( uint8_t channel )
+{
+    return ( channel < PLANT_SERVO_CHANNELS ) ? plant_ctx.servo_current[ channel ] : 0.0;
+}
+
+double plant_lid_open ( )
+{
+    double open = ( PLANT_LID_CLOSED_ANGLE - plant_ctx.lid_angle ) / PLANT_LID_CLOSED_ANGLE;
+
+    return ( open < 0.0 ) ? 0.0 : ( ( open > 1.0 ) ? 1.0 : open );
+}
+
+const plant_stats_t *plant_stats ( )
+{
+    return &plant_ctx.stats;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void actuators_priv ( double dt )
+{
+    bool mains = ( PS_ON_Get( ) == 0 );
+    bool cell_on;
+    bool fan_on;
+    uint8_t ch;
+
+    // the servos are supplied by the switched power supply
+    for ( ch = 0; ch < PLANT_SERVO_CHANNELS; ch++ )
+    {
+        plant_ctx.servo_current[ ch ] = mains ? servo_priv( ch, dt ) : 0.0;
+    }
+    plant_ctx.servo_current[ PLANT_CH_DOOR ] = lid_priv( plant_ctx.servo_current[ PLANT_CH_DOOR ], dt );
+    for ( ch = 0; ch < PLANT_SERVO_CHANNELS; ch++ )
+    {
+        plant_ctx.stats.servo_energy_j += PLANT_SERVO_SUPPLY_V * plant_ctx.servo_current[ ch ] * dt;
+    }
+
+    plant_ctx.cell_switch = plant_ctx.servo_angle[ PLANT_CH_CELL ] < PLANT_SWITCH_ANGLE;
+    plant_ctx.fan_switch = plant_ctx.servo_angle[ PLANT_CH_FAN ] >= PLANT_SWITCH_ANGLE;
+    plant_ctx.lid_angle = plant_ctx.servo_angle[ PLANT_CH_DOOR ];
+
+    cell_on = mains && plant_ctx.cell_switch;
+    fan_on = mains && plant_ctx.fan_switch;
+
+    if ( cell_on && !plant_ctx.cell_on )
+    {
+        plant_ctx.stats.cell_switches++;
+    }
+    if ( fan_on && !plant_ctx.fan_on )
+    {
+        plant_ctx.stats.fan_switches++;
+    }
+
+    plant_ctx.cell_on = cell_on;
+    plant_ctx.fan_on = fan_on;
+}
+
+static void step_priv ( double dt )
+{
+    const plant_params_t *p = &plant_ctx.params;
+    double ambient = plant_ambient_c( );
+    double tc = plant_ctx.cold_c + KELVIN;
+    double th = plant_ctx.hot_c + KELVIN;
+    double current;
+    double q_cold;
+    double q_hot;
+    double power = 0.0;
+    double g_leak;
+    double g_hot;
+    double exchange;
+    double saturation;
+    bool pumping = plant_ctx.cell_on && ( plant_ctx.fault != PLANT_FAULT_CELL );
+    bool spinning = plant_ctx.fan_on && ( plant_ctx.fault != PLANT_FAULT_FAN );
+
+    plant_ctx.cell_current = 0.0;
+    plant_ctx.fan_current = spinning ? p->fan_power_w / p->supply_v : 0.0;
+
+    if ( pumping )
+    {
+        current = ( p->supply_v - p->tec_seebeck * ( th - tc ) ) / p->tec_resistance;
+        if ( current < 0.0 )
+        {
+            current = 0.0;
+        }
+        plant_ctx.cell_current = current;
+
+        power = p->supply_v * current;
+        q_cold = p->tec_seebeck * current * tc -
+                 0.5 * current * current * p->tec_resistance -
+                 p->tec_conductance * ( th - tc );
+    }
+    else
+    {
+        // an idle cell is just a thermal bridge between the sinks
+        q_cold = -p->tec_conductance * ( th - tc );
+    }
+    q_hot = q_cold + power;
+
+    g_leak = p->wall_conductance + p->lid_conductance * plant_lid_open( ) +
+             ( plant_ctx.door ? p->door_conductance : 0.0 );
+    g_hot = spinning ? p->hot_conductance_fan : p->hot_conductance_still;
+
+    plant_ctx.air_c += dt * ( g_leak * ( ambient - plant_ctx.air_c ) +
+                              p->cold_conductance * ( plant_ctx.cold_c - plant_ctx.air_c ) ) / p->air_capacity;
+    plant_ctx.cold_c += dt * ( p->cold_conductance * ( plant_ctx.air_c - plant_ctx.cold_c ) - q_cold ) / p->cold_capacity;
+    plant_ctx.hot_c += dt * ( q_hot - g_hot * ( plant_ctx.hot_c - ambient ) ) / p->hot_capacity;
+
+    // moisture comes in with the outside air and condenses on the cold plate
+    exchange = p->vapour_exchange_seal + p->vapour_exchange_lid * plant_lid_open( ) +
+               ( plant_ctx.door ? p->vapour_exchange_door : 0.0 );
+    plant_ctx.vapour_hpa += dt * exchange * ( p->ambient_rh / 100.0 * PLANT_SATURATION_HPA( ambient ) - plant_ctx.vapour_hpa );
+
+    saturation = PLANT_SATURATION_HPA( plant_ctx.cold_c );
+    if ( plant_ctx.vapour_hpa > saturation )
+    {
+        plant_ctx.vapour_hpa -= dt * p->condensation_rate * ( plant_ctx.vapour_hpa - saturation );
+    }
+
+    plant_ctx.stats.cell_energy_j += power * dt;
+    if ( spinning )
+    {
+        plant_ctx.stats.fan_energy_j += p->fan_power_w * dt;
+    }
+}
+
+static double servo_priv ( uint8_t channel, double dt )
+{
+    const plant_params_t *p = &plant_ctx.params;
+    int pulse = sim_pca9685_pulse( channel );
+    double *angle = &plant_ctx.servo_angle[ channel ];
+    double target;
+    double travel = p->servo_speed_dps * dt;
+
+    // no pulse: the servo is not driven and stays where it is
+    if ( pulse <= 0 )
+    {
+        return 0.0;
+    }
+
+    target = ( ( double )pulse - PLANT_PULSE_OFFSET ) * 180.0 / PLANT_PULSE_SPAN;
+    if ( fabs( target - *angle ) <= travel )
+    {
+        // the current is averaged over the step
+        travel = ( travel > 0.0 ) ? fabs( target - *angle ) / travel : 0.0;
+        *angle = target;
+        return p->servo_hold_a + travel * ( p->servo_run_a - p->servo_hold_a );
+    }
+
+    *angle += ( target > *angle ) ? travel : -travel;
+
+    return p->servo_run_a;
+}
+
+static double lid_priv ( double current, double dt )
+{
+    double *angle = &plant_ctx.servo_angle[ PLANT_CH_DOOR ];
+    int pulse = sim_pca9685_pulse( PLANT_CH_DOOR );
+    double target = ( ( double )pulse - PLANT_PULSE_OFFSET ) * 180.0 / PLANT_PULSE_SPAN;
+
+    // the lid closes onto the obstacle, the servo keeps pushing while driven past it
+    if ( ( plant_ctx.lid_block < 0.0 ) || ( *angle < plant_ctx.lid_block ) )
+    {
+        return current;
+    }
+
+    *angle = plant_ctx.lid_block;
+    if ( ( current == 0.0 ) || ( pulse <= 0 ) || ( target <= plant_ctx.lid_block ) )
+    {
+        return current;
+    }
+
+    if ( plant_ctx.stats.lid_stall_first_us == SIM_TIME_NEVER )
+    {
+        plant_ctx.stats.lid_stall_first_us = plant_ctx.t_us;
+    }
+    plant_ctx.stats.lid_stall_us += ( uint64_t )( dt * SIM_US_PER_S );
+
+    return plant_ctx.params.servo_stall_a;
+}
+
+// ------------------------------------------------------------------------- END
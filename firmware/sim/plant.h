@@ -0,0 +1,195 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the cold case thermal model.
+ *
+ * Three lumped nodes: the air and contents of the case, the cold side heat
+ * sink and the hot side heat sink. The Peltier cell pumps heat between the
+ * sinks according to the thermoelectric equations, the fan cools the hot
+ * sink, and heat leaks in through the walls and the door.
+ *
+ * The actuators are read from the simulated board: the cell and the fan are
+ * powered by the supply switched by PS_ON and turned on by the rocker servos
+ * on the PCA9685, the door angle comes from the door servo.
+ *
+ * \addtogroup plant Thermal Plant
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef PLANT_H
+#define PLANT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+/* Longest integration step, well below the fastest time constant */
+#define PLANT_STEP_US               1000000ULL
+
+/** \} */ // End group macro
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup type Types
+ * \{
+ */
+
+typedef struct
+{
+    // environment
+    double ambient_c;
+    double ambient_swing_c;
+    double ambient_period_h;
+    double ambient_rh;
+
+    // heat capacities [J/K]
+    double air_capacity;
+    double cold_capacity;
+    double hot_capacity;
+
+    // thermal conductances [W/K]
+    double wall_conductance;
+    double lid_conductance;
+    double door_conductance;
+    double cold_conductance;
+    double hot_conductance_fan;
+    double hot_conductance_still;
+
+    // Peltier cell
+    double tec_seebeck;
+    double tec_resistance;
+    double tec_conductance;
+    double supply_v;
+
+    double fan_power_w;
+
+    // servos: slew rate [deg/s], current while moving, holding, stalled [A]
+    double servo_speed_dps;
+    double servo_run_a;
+    double servo_hold_a;
+    double servo_stall_a;
+
+    // moisture exchanged with the outside [1/s], condensing on the cold plate
+    double vapour_exchange_seal;
+    double vapour_exchange_lid;
+    double vapour_exchange_door;
+    double condensation_rate;
+
+} plant_params_t;
+
+typedef enum
+{
+    PLANT_FAULT_NONE = 0,
+    PLANT_FAULT_CELL,
+    PLANT_FAULT_FAN
+
+} PLANT_FAULT;
+
+typedef struct
+{
+    double cell_energy_j;
+    double fan_energy_j;
+    double servo_energy_j;
+    uint64_t cell_on_us;
+    uint64_t fan_on_us;
+    uint32_t cell_switches;
+    uint32_t fan_switches;
+    uint64_t lid_stall_first_us;
+    uint64_t lid_stall_us;
+
+} plant_stats_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Default parameters: a small cooler with a TEC1-12706 at 12 V.
+ */
+void plant_default_params ( plant_params_t *params );
+
+/**
+ * @brief Initialization function.
+ *
+ * @param params       Plant parameters, copied.
+ *
+ * @description All the nodes start at the ambient temperature.
+ */
+void plant_init ( const plant_params_t *params );
+
+/**
+ * @brief Integration function.
+ *
+ * @param t_us         Simulation time to integrate to.
+ */
+void plant_advance ( uint64_t t_us );
+
+/**
+ * @brief Door function.
+ *
+ * @param open         true while someone keeps the case open.
+ */
+void plant_set_door ( bool open );
+
+/**
+ * @brief Obstacle function.
+ *
+ * @param angle        Servo angle the lid cannot close past, it was put in
+ *                     the way of the open lid; negative to remove it.
+ */
+void plant_block_lid ( double angle );
+
+/**
+ * @brief Fault function.
+ *
+ * @param fault        Part that stops working: the switch still flips but
+ *                     the cell pumps no heat, or the fan does not spin;
+ *                     either way the circuit is open and draws nothing.
+ */
+void plant_set_fault ( PLANT_FAULT fault );
+
+double plant_air_c ( );
+double plant_humidity ( );
+double plant_ambient_c ( );
+double plant_hot_c ( );
+bool plant_cell_on ( );
+bool plant_fan_on ( );
+double plant_lid_open ( );
+
+/**
+ * @brief Current functions.
+ *
+ * @returns Current drawn from the 12 V supply by the cell and the fan, and
+ * from the 5 V servo supply by a PCA9685 channel, in A.
+ */
+double plant_cell_current_a ( );
+double plant_fan_current_a ( );
+double plant_servo_current_a ( uint8_t channel );
+
+/**
+ * @brief Statistics function.
+ *
+ * @returns Energy and actuator counters since plant_init().
+ */
+const plant_stats_t *plant_stats ( );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _PLANT_H_
@@ -0,0 +1,233 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "sim.h"
+#include "sim_plib.h"
+#include "plant.h"
+
+/**
+ * @brief Scheduled stimulus.
+ */
+typedef struct
+{
+    uint64_t t_us;
+    uint32_t seq;
+    SIM_EVENT_CALLBACK callback;
+    uintptr_t context;
+
+} sim_event_t;
+
+/**
+ * @brief Kernel ctx object definition.
+ */
+typedef struct
+{
+    uint64_t now;
+
+    // min-heap ordered by time, then by scheduling order
+    sim_event_t events[ SIM_MAX_EVENTS ];
+    uint32_t n_events;
+    uint32_t seq;
+
+    uint64_t end;
+    SIM_EVENT_CALLBACK end_callback;
+    uintptr_t end_context;
+
+    uint64_t idle_count;
+
+} sim_kernel_t;
+
+static sim_kernel_t sim_ctx = { .end = SIM_TIME_NEVER };
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static void advance_to_priv ( uint64_t target );
+static bool before_priv ( const sim_event_t *a, const sim_event_t *b );
+static void pop_priv ( sim_event_t *event );
+static void finish_priv ( );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+uint64_t sim_time_us ( )
+{
+    return sim_ctx.now;
+}
+
+void sim_advance_us ( uint64_t us )
+{
+    advance_to_priv( sim_ctx.now + us );
+}
+
+bool sim_schedule ( uint64_t t_us, SIM_EVENT_CALLBACK callback, uintptr_t context )
+{
+    sim_event_t *heap = sim_ctx.events;
+    uint32_t i;
+    uint32_t parent;
+    sim_event_t tmp;
+
+    if ( sim_ctx.n_events >= SIM_MAX_EVENTS )
+    {
+        return false;
+    }
+
+    i = sim_ctx.n_events++;
+    heap[ i ].t_us = ( t_us < sim_ctx.now ) ? sim_ctx.now : t_us;
+    heap[ i ].seq = sim_ctx.seq++;
+    heap[ i ].callback = callback;
+    heap[ i ].context = context;
+
+    while ( i > 0 )
+    {
+        parent = ( i - 1 ) / 2;
+        if ( !before_priv( &heap[ i ], &heap[ parent ] ) )
+        {
+            break;
+        }
+        tmp = heap[ i ];
+        heap[ i ] = heap[ parent ];
+        heap[ parent ] = tmp;
+        i = parent;
+    }
+
+    return true;
+}
+
+void sim_set_end ( uint64_t t_us, SIM_EVENT_CALLBACK callback, uintptr_t context )
+{
+    sim_ctx.end = t_us;
+    sim_ctx.end_callback = callback;
+    sim_ctx.end_context = context;
+}
+
+uint64_t sim_idle_count ( )
+{
+    return sim_ctx.idle_count;
+}
+
+void sim_idle ( void )
+{
+    uint64_t next;
+
+    sim_ctx.idle_count++;
+
+    if ( sim_ctx.now >= sim_ctx.end )
+    {
+        finish_priv( );
+    }
+
+    // nothing can change until the next interrupt or stimulus
+    next = sim_rtc_next_us( );
+    if ( ( sim_ctx.n_events > 0 ) && ( sim_ctx.events[ 0 ].t_us < next ) )
+    {
+        next = sim_ctx.events[ 0 ].t_us;
+    }
+    if ( sim_ctx.end < next )
+    {
+        next = sim_ctx.end;
+    }
+    if ( next <= sim_ctx.now )
+    {
+        next = sim_ctx.now + 1;
+    }
+
+    advance_to_priv( next );
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void advance_to_priv ( uint64_t target )
+{
+    uint64_t t_rtc;
+    uint64_t t_event;
+    sim_event_t event;
+
+    for ( ; ; )
+    {
+        t_rtc = sim_rtc_next_us( );
+        t_event = ( sim_ctx.n_events > 0 ) ? sim_ctx.events[ 0 ].t_us : SIM_TIME_NEVER;
+
+        if ( ( t_rtc > target ) && ( t_event > target ) )
+        {
+            break;
+        }
+
+        if ( t_event <= t_rtc )
+        {
+            plant_advance( t_event );
+            sim_ctx.now = t_event;
+            pop_priv( &event );
+            event.callback( event.context );
+        }
+        else
+        {
+            plant_advance( t_rtc );
+            sim_ctx.now = t_rtc;
+            sim_rtc_expire( );
+        }
+    }
+
+    plant_advance( target );
+    sim_ctx.now = target;
+}
+
+static bool before_priv ( const sim_event_t *a, const sim_event_t *b )
+{
+    if ( a->t_us != b->t_us )
+    {
+        return a->t_us < b->t_us;
+    }
+
+    return ( int32_t )( a->seq - b->seq ) < 0;
+}
+
+static void pop_priv ( sim_event_t *event )
+{
+    sim_event_t *heap = sim_ctx.events;
+    uint32_t i = 0;
+    uint32_t child;
+    sim_event_t tmp;
+
+    *event = heap[ 0 ];
+    heap[ 0 ] = heap[ --sim_ctx.n_events ];
+
+    for ( ; ; )
+    {
+        child = 2 * i + 1;
+        if ( child >= sim_ctx.n_events )
+        {
+            break;
+        }
+        if ( ( child + 1 < sim_ctx.n_events ) && before_priv( &heap[ child + 1 ], &heap[ child ] ) )
+        {
+            child++;
+        }
+        if ( !before_priv( &heap[ child ], &heap[ i ] ) )
+        {
+            break;
+        }
+        tmp = heap[ i ];
+        heap[ i ] = heap[ child ];
+        heap[ child ] = tmp;
+        i = child;
+    }
+}
+
+static void finish_priv ( )
+{
+    if ( sim_ctx.end_callback != NULL )
+    {
+        sim_ctx.end_callback( sim_ctx.end_context );
+    }
+
+    fflush( stdout );
+    exit( EXIT_SUCCESS );
+}
+
+// ------------------------------------------------------------------------- END
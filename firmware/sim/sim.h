@@ -0,0 +1,106 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the simulation kernel.
+ *
+ * The kernel owns the virtual clock. Time only moves when the application
+ * waits: busy delays advance it by their length, while the idle point of the
+ * main loop jumps straight to the next interrupt or scheduled stimulus, so
+ * hours of operation run in milliseconds.
+ *
+ * \addtogroup sim Simulation Kernel
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+#define SIM_US_PER_MS               1000ULL
+#define SIM_US_PER_S                1000000ULL
+#define SIM_US_PER_MIN              ( 60ULL * SIM_US_PER_S )
+#define SIM_US_PER_HOUR             ( 60ULL * SIM_US_PER_MIN )
+#define SIM_US_PER_DAY              ( 24ULL * SIM_US_PER_HOUR )
+
+#define SIM_TIME_NEVER              UINT64_MAX
+
+/* Stimuli that can be scheduled at the same time */
+#define SIM_MAX_EVENTS              1024
+
+/** \} */ // End group macro
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup type Types
+ * \{
+ */
+
+typedef void ( *SIM_EVENT_CALLBACK )( uintptr_t context );
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Current simulated time, in microseconds since power up.
+ */
+uint64_t sim_time_us ( );
+
+/**
+ * @brief Busy wait function.
+ *
+ * @param us           Time spent by the CPU.
+ *
+ * @description This function moves the clock forward, raising the interrupts
+ * and stimuli that fall in the interval.
+ */
+void sim_advance_us ( uint64_t us );
+
+/**
+ * @brief Schedule function.
+ *
+ * @param t_us         Absolute time of the stimulus.
+ * @param callback     Function executed at t_us, in interrupt context.
+ * @param context      Value passed to the callback.
+ *
+ * @returns false if the event queue is full.
+ */
+bool sim_schedule ( uint64_t t_us, SIM_EVENT_CALLBACK callback, uintptr_t context );
+
+/**
+ * @brief End time function.
+ *
+ * @param t_us         Time at which the simulation stops.
+ * @param callback     Function executed at the end, before the process exits.
+ * @param context      Value passed to the callback.
+ */
+void sim_set_end ( uint64_t t_us, SIM_EVENT_CALLBACK callback, uintptr_t context );
+
+/**
+ * @brief Loop passes the application spent waiting for an event.
+ */
+uint64_t sim_idle_count ( );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _SIM_H_
@@ -0,0 +1,321 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include <math.h>
+#include "sim.h"
+#include "sim_hdc1080.h"
+#include "plant.h"
+
+#define HDC1080_REG_TEMPERATURE     0x00
+#define HDC1080_REG_HUMIDITY        0x01
+#define HDC1080_REG_CONFIGURATION   0x02
+#define HDC1080_REG_SERIAL_ID_0     0xFB
+#define HDC1080_REG_SERIAL_ID_1     0xFC
+#define HDC1080_REG_SERIAL_ID_2     0xFD
+#define HDC1080_REG_MANUFACTURER_ID 0xFE
+#define HDC1080_REG_DEVICE_ID       0xFF
+
+#define HDC1080_MANUFACTURER_ID     0x5449
+#define HDC1080_DEVICE_ID           0x1050
+
+#define HDC1080_CONFIG_RST          0x8000
+#define HDC1080_CONFIG_HEAT         0x2000
+#define HDC1080_CONFIG_MODE         0x1000
+#define HDC1080_CONFIG_TRES         0x0400
+#define HDC1080_CONFIG_HRES         0x0300
+#define HDC1080_CONFIG_WRITABLE     ( HDC1080_CONFIG_HEAT | HDC1080_CONFIG_MODE | \
+                                      HDC1080_CONFIG_TRES | HDC1080_CONFIG_HRES )
+#define HDC1080_CONFIG_DEFAULT      0x1000
+
+/* Conversion times from the datasheet, in microseconds */
+#define HDC1080_TCONV_T14_US        6350
+#define HDC1080_TCONV_T11_US        3650
+#define HDC1080_TCONV_H14_US        6500
+#define HDC1080_TCONV_H11_US        3850
+#define HDC1080_TCONV_H8_US         2500
+#define HDC1080_RESET_US            15000
+
+/* Self heating of the die while the heater is on */
+#define HDC1080_HEATER_OFFSET_C     1.0
+
+/* RMS noise of a 14-bit conversion, a few LSB as on the bench */
+#define HDC1080_NOISE_T_C           0.01
+#define HDC1080_NOISE_RH            0.05
+
+/**
+ * @brief Model ctx object definition.
+ */
+typedef struct
+{
+    sim_i2c_device_t dev;
+
+    uint8_t pointer;
+    uint16_t config;
+
+    // measurement triggered by the last pointer write
+    bool converting;
+    bool stuck;
+    bool both;
+    uint64_t ready_us;
+
+    uint16_t temperature;
+    uint16_t humidity;
+
+    // fixed seed, every run sees the same noise
+    uint32_t seed;
+
+} sim_hdc1080_t;
+
+static sim_hdc1080_t hdc1080_ctx;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static bool write_priv ( sim_i2c_device_t *dev, const uint8_t *data, uint32_t len );
+static bool read_priv ( sim_i2c_device_t *dev, uint8_t *data, uint32_t len );
+static void trigger_priv ( uint8_t reg );
+static void sample_priv ( );
+static uint16_t register_priv ( uint8_t reg );
+static uint16_t quantize_priv ( double value, uint16_t mask );
+static double noise_priv ( );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void sim_hdc1080_attach ( SIM_I2C_BUS bus )
+{
+    hdc1080_ctx.dev.name = "HDC1080";
+    hdc1080_ctx.dev.address = SIM_HDC1080_ADDRESS;
+    hdc1080_ctx.dev.write = write_priv;
+    hdc1080_ctx.dev.read = read_priv;
+    hdc1080_ctx.config = HDC1080_CONFIG_DEFAULT;
+    hdc1080_ctx.seed = 0x1080;
+
+    sim_i2c_attach( bus, &hdc1080_ctx.dev );
+}
+
+void sim_hdc1080_set_stuck ( bool stuck )
+{
+    hdc1080_ctx.stuck = stuck;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static bool write_priv ( sim_i2c_device_t *dev, const uint8_t *data, uint32_t len )
+{
+    uint16_t config;
+
+    // busy during the soft reset
+    if ( sim_time_us( ) < hdc1080_ctx.ready_us && !hdc1080_ctx.converting )
+    {
+        return false;
+    }
+
+    if ( len == 0 )
+    {
+        return true;
+    }
+
+    hdc1080_ctx.pointer = data[ 0 ];
+
+    if ( ( len == 1 ) &&
+         ( ( hdc1080_ctx.pointer == HDC1080_REG_TEMPERATURE ) || ( hdc1080_ctx.pointer == HDC1080_REG_HUMIDITY ) ) )
+    {
+        trigger_priv( hdc1080_ctx.pointer );
+    }
+    else if ( ( hdc1080_ctx.pointer == HDC1080_REG_CONFIGURATION ) && ( len >= 3 ) )
+    {
+        config = ( ( uint16_t )data[ 1 ] << 8 ) | data[ 2 ];
+
+        if ( config & HDC1080_CONFIG_RST )
+        {
+            hdc1080_ctx.config = HDC1080_CONFIG_DEFAULT;
+            hdc1080_ctx.converting = false;
+            hdc1080_ctx.ready_us = sim_i2c_stop_us( ) + HDC1080_RESET_US;
+        }
+        else
+        {
+            hdc1080_ctx.config = config & HDC1080_CONFIG_WRITABLE;
+        }
+    }
+
+    return true;
+}
+
+static bool read_priv ( sim_i2c_device_t *dev, uint8_t *data, uint32_t len )
+{
+    uint16_t words[ 2 ];
+    uint8_t n_words = 1;
+    uint32_t i;
+
+    if ( hdc1080_ctx.converting )
+    {
+        // the address is not acknowledged until the conversion completes
+        if ( sim_time_us( ) < hdc1080_ctx.ready_us )
+        {
+            return false;
+        }
+        sample_priv( );
+    }
+
+    if ( ( hdc1080_ctx.pointer == HDC1080_REG_TEMPERATURE ) && hdc1080_ctx.both )
+    {
+        // acquisition of both: temperature then humidity in one read
+        words[ 0 ] = hdc1080_ctx.temperature;
+        words[ 1 ] = hdc1080_ctx.humidity;
+        n_words = 2;
+    }
+    else
+    {
+        words[ 0 ] = register_priv( hdc1080_ctx.pointer );
+    }
+
+    for ( i = 0; i < len; i++ )
+    {
+        data[ i ] = ( i / 2 < n_words ) ? ( ( i & 1 ) ? ( words[ i / 2 ] & 0xFF ) : ( words[ i / 2 ] >> 8 ) ) : 0xFF;
+    }
+
+    return true;
+}
+
+static void trigger_priv ( uint8_t reg )
+{
+    uint16_t config = hdc1080_ctx.config;
+    uint32_t t_us;
+    uint32_t h_us;
+
+    t_us = ( config & HDC1080_CONFIG_TRES ) ? HDC1080_TCONV_T11_US : HDC1080_TCONV_T14_US;
+    switch ( ( config & HDC1080_CONFIG_HRES ) >> 8 )
+    {
+        case 0:
+            h_us = HDC1080_TCONV_H14_US;
+            break;
+        case 1:
+            h_us = HDC1080_TCONV_H11_US;
+            break;
+        default:
+            h_us = HDC1080_TCONV_H8_US;
+            break;
+    }
+
+    hdc1080_ctx.both = ( config & HDC1080_CONFIG_MODE ) && ( reg == HDC1080_REG_TEMPERATURE );
+    hdc1080_ctx.converting = true;
+    hdc1080_ctx.ready_us = sim_i2c_stop_us( );
+
+    if ( hdc1080_ctx.both )
+    {
+        hdc1080_ctx.ready_us += t_us + h_us;
+    }
+    else
+    {
+        hdc1080_ctx.ready_us += ( reg == HDC1080_REG_TEMPERATURE ) ? t_us : h_us;
+    }
+}
+
+static void sample_priv ( )
+{
+    uint16_t config = hdc1080_ctx.config;
+    double t = plant_air_c( ) + HDC1080_NOISE_T_C * noise_priv( );
+    double rh = plant_humidity( ) + HDC1080_NOISE_RH * noise_priv( );
+    uint16_t t_mask;
+    uint16_t h_mask;
+
+    // the plant changes slowly, it is sampled when the result is collected
+    if ( config & HDC1080_CONFIG_HEAT )
+    {
+        t += HDC1080_HEATER_OFFSET_C;
+    }
+
+    t_mask = ( config & HDC1080_CONFIG_TRES ) ? 0xFFE0 : 0xFFFC;
+    switch ( ( config & HDC1080_CONFIG_HRES ) >> 8 )
+    {
+        case 0:
+            h_mask = 0xFFFC;
+            break;
+        case 1:
+            h_mask = 0xFFE0;
+            break;
+        default:
+            h_mask = 0xFF00;
+            break;
+    }
+
+    // a failed part keeps answering with the last result
+    if ( hdc1080_ctx.stuck )
+    {
+        hdc1080_ctx.converting = false;
+        return;
+    }
+
+    if ( hdc1080_ctx.both || ( hdc1080_ctx.pointer == HDC1080_REG_TEMPERATURE ) )
+    {
+        hdc1080_ctx.temperature = quantize_priv( ( ( t + 40.0 ) / 165.0 ) * 65536.0, t_mask );
+    }
+    if ( hdc1080_ctx.both || ( hdc1080_ctx.pointer == HDC1080_REG_HUMIDITY ) )
+    {
+        hdc1080_ctx.humidity = quantize_priv( ( rh / 100.0 ) * 65536.0, h_mask );
+    }
+
+    hdc1080_ctx.converting = false;
+}
+
+static uint16_t register_priv ( uint8_t reg )
+{
+    switch ( reg )
+    {
+        case HDC1080_REG_TEMPERATURE:
+            return hdc1080_ctx.temperature;
+        case HDC1080_REG_HUMIDITY:
+            return hdc1080_ctx.humidity;
+        case HDC1080_REG_CONFIGURATION:
+            return hdc1080_ctx.config;
+        case HDC1080_REG_SERIAL_ID_0:
+            return 0x0123;
+        case HDC1080_REG_SERIAL_ID_1:
+            return 0x4567;
+        case HDC1080_REG_SERIAL_ID_2:
+            return 0x8980;
+        case HDC1080_REG_MANUFACTURER_ID:
+            return HDC1080_MANUFACTURER_ID;
+        case HDC1080_REG_DEVICE_ID:
+            return HDC1080_DEVICE_ID;
+        default:
+            return 0xFFFF;
+    }
+}
+
+static uint16_t quantize_priv ( double value, uint16_t mask )
+{
+    if ( value < 0.0 )
+    {
+        value = 0.0;
+    }
+    if ( value > 65535.0 )
+    {
+        value = 65535.0;
+    }
+
+    return ( uint16_t )value & mask;
+}
+
+static double noise_priv ( )
+{
+    double u[ 2 ];
+    uint8_t i;
+
+    // xorshift32 and Box-Muller, unit variance
+    for ( i = 0; i < 2; i++ )
+    {
+        hdc1080_ctx.seed ^= hdc1080_ctx.seed << 13;
+        hdc1080_ctx.seed ^= hdc1080_ctx.seed >> 17;
+        hdc1080_ctx.seed ^= hdc1080_ctx.seed << 5;
+        u[ i ] = ( hdc1080_ctx.seed + 1.0 ) / 4294967297.0;
+    }
+
+    return sqrt( -2.0 * log( u[ 0 ] ) ) * cos( 2.0 * M_PI * u[ 1 ] );
+}
+
+// ------------------------------------------------------------------------- END
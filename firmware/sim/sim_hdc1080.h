@@ -0,0 +1,63 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the HDC1080 device model.
+ *
+ * The model answers on the address used by the Temp&Hum 11 click and reports
+ * the air temperature and humidity of the simulated case.
+ *
+ * Writing the temperature or humidity pointer alone starts a conversion,
+ * timed from the STOP with the resolution set in the configuration register;
+ * reading before it completes is not acknowledged, as on the part.
+ *
+ * \addtogroup sim_hdc1080 HDC1080 Model
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef SIM_HDC1080_H
+#define SIM_HDC1080_H
+
+#include "sim_i2c.h"
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+#define SIM_HDC1080_ADDRESS         0x40
+
+/** \} */ // End group macro
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Attach function.
+ *
+ * @param bus          Bus the sensor is wired to.
+ */
+void sim_hdc1080_attach ( SIM_I2C_BUS bus );
+
+/**
+ * @brief Fault function.
+ *
+ * @param stuck        true to keep returning the last conversion results.
+ */
+void sim_hdc1080_set_stuck ( bool stuck );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _SIM_HDC1080_H_
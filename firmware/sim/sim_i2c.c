@@ -0,0 +1,226 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include <stddef.h>
+#include "sim.h"
+#include "sim_i2c.h"
+
+#define I2C_BIT_NS                  ( 1000000000ULL / SIM_I2C_SCL_HZ )
+
+/* 8 data bits and the acknowledge */
+#define I2C_BYTE_BITS               9
+
+/**
+ * @brief Bus ctx object definition.
+ */
+typedef struct
+{
+    sim_i2c_device_t *devices;
+
+    uint64_t busy_until;
+    bool nack;
+    sim_i2c_stats_t stats;
+
+} sim_i2c_bus_t;
+
+static sim_i2c_bus_t i2c_ctx[ SIM_I2C_BUS_COUNT ];
+static uint64_t i2c_stop_us;
+
+static const char *bus_names[ SIM_I2C_BUS_COUNT ] = { "SERCOM0", "SERCOM2" };
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static sim_i2c_device_t *find_priv ( SIM_I2C_BUS bus, uint16_t address );
+static bool general_call_priv ( SIM_I2C_BUS bus, const uint8_t *data, uint32_t len );
+static void account_priv ( SIM_I2C_BUS bus, sim_i2c_device_t *dev, uint32_t bits,
+                           uint32_t written, uint32_t read, bool nack );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void sim_i2c_attach ( SIM_I2C_BUS bus, sim_i2c_device_t *dev )
+{
+    dev->next = i2c_ctx[ bus ].devices;
+    i2c_ctx[ bus ].devices = dev;
+}
+
+bool sim_i2c_transfer ( SIM_I2C_BUS bus, uint16_t address, const uint8_t *wr_data, uint32_t wr_len,
+                        uint8_t *rd_data, uint32_t rd_len )
+{
+    sim_i2c_device_t *dev;
+    uint32_t bits;
+    uint32_t wr_bits;
+    uint32_t rd_bits;
+
+    if ( sim_time_us( ) < i2c_ctx[ bus ].busy_until )
+    {
+        return false;
+    }
+
+    // START, address, data, STOP; a read after a write adds a repeated START
+    wr_bits = ( wr_data != NULL ) ? I2C_BYTE_BITS * ( 1 + wr_len ) : 0;
+    rd_bits = ( rd_data != NULL ) ? I2C_BYTE_BITS * ( 1 + rd_len ) + ( ( wr_data != NULL ) ? 1 : 0 ) : 0;
+    bits = 2 + wr_bits + rd_bits;
+    i2c_stop_us = sim_time_us( ) + ( bits * I2C_BIT_NS + 999 ) / 1000;
+
+    if ( ( address == SIM_I2C_GENERAL_CALL ) && ( wr_data != NULL ) )
+    {
+        if ( !general_call_priv( bus, wr_data, wr_len ) )
+        {
+            account_priv( bus, NULL, 2 + I2C_BYTE_BITS, 0, 0, true );
+            return true;
+        }
+        account_priv( bus, NULL, bits, wr_len, 0, false );
+        return true;
+    }
+
+    dev = find_priv( bus, address );
+
+    // address not acknowledged: START, address, STOP
+    if ( ( dev == NULL ) || ( ( wr_data != NULL ) && !dev->write( dev, wr_data, wr_len ) ) )
+    {
+        account_priv( bus, dev, 2 + I2C_BYTE_BITS, 0, 0, true );
+        return true;
+    }
+
+    // read address not acknowledged after the write part
+    if ( ( rd_data != NULL ) && !dev->read( dev, rd_data, rd_len ) )
+    {
+        account_priv( bus, dev, 2 + wr_bits + ( ( wr_data != NULL ) ? 1 : 0 ) + I2C_BYTE_BITS,
+                      ( wr_data != NULL ) ? wr_len : 0, 0, true );
+        return true;
+    }
+
+    account_priv( bus, dev, bits, ( wr_data != NULL ) ? wr_len : 0, ( rd_data != NULL ) ? rd_len : 0, false );
+
+    return true;
+}
+
+bool sim_i2c_is_busy ( SIM_I2C_BUS bus )
+{
+    uint64_t now = sim_time_us( );
+
+    if ( now >= i2c_ctx[ bus ].busy_until )
+    {
+        return false;
+    }
+
+    // the caller spins until the STOP condition
+    sim_advance_us( i2c_ctx[ bus ].busy_until - now );
+
+    return true;
+}
+
+uint64_t sim_i2c_stop_us ( )
+{
+    return i2c_stop_us;
+}
+
+bool sim_i2c_nacked ( SIM_I2C_BUS bus )
+{
+    return i2c_ctx[ bus ].nack;
+}
+
+const sim_i2c_stats_t *sim_i2c_bus_stats ( SIM_I2C_BUS bus )
+{
+    return &i2c_ctx[ bus ].stats;
+}
+
+void sim_i2c_report ( FILE *out )
+{
+    double elapsed = ( double )sim_time_us( ) * 1000.0;
+    const sim_i2c_stats_t *st;
+    sim_i2c_device_t *dev;
+    uint8_t bus;
+
+    fprintf( out, "i2c            %lu Hz SCL\n", ( unsigned long )SIM_I2C_SCL_HZ );
+
+    for ( bus = 0; bus < SIM_I2C_BUS_COUNT; bus++ )
+    {
+        st = &i2c_ctx[ bus ].stats;
+        fprintf( out, "  %-12s %8u xfers %6u nacks %9llu wr %9llu rd %10.3f s busy %7.4f%%\n",
+                 bus_names[ bus ], st->transactions, st->nacks,
+                 ( unsigned long long )st->bytes_written, ( unsigned long long )st->bytes_read,
+                 st->bus_ns / 1e9, ( elapsed > 0 ) ? 100.0 * st->bus_ns / elapsed : 0.0 );
+
+        for ( dev = i2c_ctx[ bus ].devices; dev != NULL; dev = dev->next )
+        {
+            st = &dev->stats;
+            fprintf( out, "    %-10s %8u xfers %6u nacks %9llu wr %9llu rd %10.3f s busy\n",
+                     dev->name, st->transactions, st->nacks,
+                     ( unsigned long long )st->bytes_written, ( unsigned long long )st->bytes_read,
+                     st->bus_ns / 1e9 );
+        }
+    }
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static sim_i2c_device_t *find_priv ( SIM_I2C_BUS bus, uint16_t address )
+{
+    sim_i2c_device_t *dev;
+
+    for ( dev = i2c_ctx[ bus ].devices; dev != NULL; dev = dev->next )
+    {
+        if ( ( dev->address == address ) ||
+             ( ( dev->match != NULL ) && dev->match( dev, address ) ) )
+        {
+            return dev;
+        }
+    }
+
+    return NULL;
+}
+
+static bool general_call_priv ( SIM_I2C_BUS bus, const uint8_t *data, uint32_t len )
+{
+    sim_i2c_device_t *dev;
+    bool ack = false;
+
+    for ( dev = i2c_ctx[ bus ].devices; dev != NULL; dev = dev->next )
+    {
+        if ( dev->general_call != NULL )
+        {
+            dev->general_call( dev, data, len );
+            ack = true;
+        }
+    }
+
+    return ack;
+}
+
+static void account_priv ( SIM_I2C_BUS bus, sim_i2c_device_t *dev, uint32_t bits,
+                           uint32_t written, uint32_t read, bool nack )
+{
+    sim_i2c_stats_t *st[ 2 ];
+    uint64_t ns = ( uint64_t )bits * I2C_BIT_NS;
+    uint8_t i;
+
+    st[ 0 ] = &i2c_ctx[ bus ].stats;
+    st[ 1 ] = ( dev != NULL ) ? &dev->stats : NULL;
+
+    for ( i = 0; i < 2; i++ )
+    {
+        if ( st[ i ] == NULL )
+        {
+            continue;
+        }
+        st[ i ]->transactions++;
+        st[ i ]->nacks += nack ? 1 : 0;
+        st[ i ]->bytes_written += written;
+        st[ i ]->bytes_read += read;
+        st[ i ]->bus_ns += ns;
+    }
+
+    i2c_ctx[ bus ].busy_until = sim_time_us( ) + ( ns + 999 ) / 1000;
+    i2c_ctx[ bus ].nack = nack;
+
+    // a transfer cut short by a NACK stops early
+    i2c_stop_us = i2c_ctx[ bus ].busy_until;
+}
+
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,171 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the simulated I2C buses.
+ *
+ * Each SERCOM I2C master is a bus with a list of device models attached.
+ * A transfer is routed to the device answering the address; a device that
+ * does not acknowledge ends the transfer and the read buffer is left
+ * untouched, as on the wire.
+ *
+ * Transfers take the time of their bits at the SCL rate programmed by the
+ * plib: the bus stays busy for that long and the busy-wait in the drivers
+ * advances the clock. Every bus and device counts its transactions, bytes,
+ * NACKs and bus time, so driver changes can be compared on occupancy.
+ *
+ * \addtogroup sim_i2c Simulated I2C Buses
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef SIM_I2C_H
+#define SIM_I2C_H
+
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+/* SERCOM0/2 run from GCLK1 (60 MHz) with BAUD = 0xFF and 100 ns rise time */
+#define SIM_I2C_GCLK_HZ             60000000UL
+#define SIM_I2C_BAUD                255
+#define SIM_I2C_RISE_NS             100
+#define SIM_I2C_SCL_HZ              ( SIM_I2C_GCLK_HZ / ( 10 + 2 * SIM_I2C_BAUD + \
+                                      ( SIM_I2C_GCLK_HZ / 1000000UL ) * SIM_I2C_RISE_NS / 1000 ) )
+
+#define SIM_I2C_GENERAL_CALL        0x00
+
+/** \} */ // End group macro
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup type Types
+ * \{
+ */
+
+typedef enum
+{
+    SIM_I2C_BUS_SERCOM0 = 0,
+    SIM_I2C_BUS_SERCOM2,
+    SIM_I2C_BUS_COUNT
+
+} SIM_I2C_BUS;
+
+typedef struct
+{
+    uint32_t transactions;
+    uint32_t nacks;
+    uint64_t bytes_written;
+    uint64_t bytes_read;
+    uint64_t bus_ns;
+
+} sim_i2c_stats_t;
+
+typedef struct sim_i2c_device_s sim_i2c_device_t;
+
+/**
+ * @brief Device model, embedded as first member by the concrete models.
+ *
+ * write and read return false when the device does not acknowledge its
+ * address. match and general_call are optional.
+ */
+struct sim_i2c_device_s
+{
+    const char *name;
+    uint16_t address;
+
+    bool ( *match )( sim_i2c_device_t *dev, uint16_t address );
+    bool ( *write )( sim_i2c_device_t *dev, const uint8_t *data, uint32_t len );
+    bool ( *read )( sim_i2c_device_t *dev, uint8_t *data, uint32_t len );
+    void ( *general_call )( sim_i2c_device_t *dev, const uint8_t *data, uint32_t len );
+
+    sim_i2c_stats_t stats;
+    sim_i2c_device_t *next;
+};
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Attach function.
+ *
+ * @param bus          Bus the device is wired to.
+ * @param dev          Device model, owned by the caller.
+ */
+void sim_i2c_attach ( SIM_I2C_BUS bus, sim_i2c_device_t *dev );
+
+/**
+ * @brief Transfer function.
+ *
+ * @param bus          Bus used by the transfer.
+ * @param address      7-bit slave address.
+ * @param wr_data      Bytes written, NULL for a read only transfer.
+ * @param wr_len       Number of bytes written.
+ * @param rd_data      Bytes read after a repeated start, NULL for a write.
+ * @param rd_len       Number of bytes read.
+ *
+ * @returns false if the bus is busy, true if the transfer was started.
+ */
+bool sim_i2c_transfer ( SIM_I2C_BUS bus, uint16_t address, const uint8_t *wr_data, uint32_t wr_len,
+                        uint8_t *rd_data, uint32_t rd_len );
+
+/**
+ * @brief Busy function.
+ *
+ * @returns true while a transfer is in progress on the bus. Each call spends
+ * the CPU time up to the end of the transfer.
+ */
+bool sim_i2c_is_busy ( SIM_I2C_BUS bus );
+
+/**
+ * @brief Stop time function.
+ *
+ * @returns Time of the STOP condition of the transfer in progress, for the
+ * device models whose conversions start at the end of the transfer.
+ */
+uint64_t sim_i2c_stop_us ( );
+
+/**
+ * @brief Acknowledge function.
+ *
+ * @returns true if the last transfer on the bus was not acknowledged.
+ */
+bool sim_i2c_nacked ( SIM_I2C_BUS bus );
+
+/**
+ * @brief Statistics function.
+ *
+ * @returns Totals of all the transfers on the bus.
+ */
+const sim_i2c_stats_t *sim_i2c_bus_stats ( SIM_I2C_BUS bus );
+
+/**
+ * @brief Report function.
+ *
+ * @param out          Stream the table is printed to.
+ *
+ * @description This function prints the counters of every bus and device,
+ * with the bus occupancy over the simulated time.
+ */
+void sim_i2c_report ( FILE *out );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _SIM_I2C_H_
@@ -0,0 +1,192 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include <stddef.h>
+#include <math.h>
+#include "sim.h"
+#include "sim_ltc2497.h"
+
+/* Command byte: 1 0 EN SGL ODD A2 A1 A0 */
+#define LTC2497_CMD_MASK            0xE0
+#define LTC2497_CMD_ENABLE          0xA0
+#define LTC2497_CMD_SGL             0x10
+#define LTC2497_CMD_ODD             0x08
+#define LTC2497_CMD_ADDRESS         0x07
+
+/* Differential CH0-CH1 after power up */
+#define LTC2497_CMD_DEFAULT         0x00
+
+/* Conversion time with the internal oscillator, 50/60 Hz rejection */
+#define LTC2497_TCONV_US            149900
+
+/* 17-bit result with SIG, left aligned in 24 bits with 6 zero sub-LSBs */
+#define LTC2497_CODE_FS             65536
+#define LTC2497_CODE_OFFSET         0x20000
+#define LTC2497_OVERRANGE           0x30000
+#define LTC2497_UNDERRANGE          0x0FFFF
+#define LTC2497_SUB_LSB_BITS        6
+
+/**
+ * @brief Model ctx object definition.
+ */
+typedef struct
+{
+    sim_i2c_device_t dev;
+
+    SIM_LTC2497_SOURCE source;
+    uint8_t command;
+
+    // conversion started at the STOP of the last acknowledged transfer
+    uint64_t ready_us;
+    uint64_t transfer_stop_us;
+
+    uint32_t output;
+
+} sim_ltc2497_t;
+
+static sim_ltc2497_t ltc2497_ctx;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static bool write_priv ( sim_i2c_device_t *dev, const uint8_t *data, uint32_t len );
+static bool read_priv ( sim_i2c_device_t *dev, uint8_t *data, uint32_t len );
+static bool begin_priv ( );
+static uint32_t convert_priv ( uint8_t command );
+static double input_priv ( uint8_t channel );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void sim_ltc2497_attach ( SIM_I2C_BUS bus )
+{
+    ltc2497_ctx.dev.name = "LTC2497";
+    ltc2497_ctx.dev.address = SIM_LTC2497_ADDRESS;
+    ltc2497_ctx.dev.write = write_priv;
+    ltc2497_ctx.dev.read = read_priv;
+    ltc2497_ctx.command = LTC2497_CMD_DEFAULT;
+
+    // the first conversion starts at power up
+    ltc2497_ctx.ready_us = sim_time_us( ) + LTC2497_TCONV_US;
+    ltc2497_ctx.transfer_stop_us = SIM_TIME_NEVER;
+
+    sim_i2c_attach( bus, &ltc2497_ctx.dev );
+}
+
+void sim_ltc2497_set_source ( SIM_LTC2497_SOURCE source )
+{
+    ltc2497_ctx.source = source;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static bool write_priv ( sim_i2c_device_t *dev, const uint8_t *data, uint32_t len )
+{
+    if ( !begin_priv( ) )
+    {
+        return false;
+    }
+
+    // without EN the previous channel is kept
+    if ( ( len > 0 ) && ( ( data[ 0 ] & LTC2497_CMD_MASK ) == LTC2497_CMD_ENABLE ) )
+    {
+        ltc2497_ctx.command = data[ 0 ];
+    }
+
+    return true;
+}
+
+static bool read_priv ( sim_i2c_device_t *dev, uint8_t *data, uint32_t len )
+{
+    uint32_t i;
+
+    if ( !begin_priv( ) )
+    {
+        return false;
+    }
+
+    for ( i = 0; i < len; i++ )
+    {
+        data[ i ] = ( i < 3 ) ? ( uint8_t )( ltc2497_ctx.output >> ( 16 - 8 * i ) ) : 0xFF;
+    }
+
+    return true;
+}
+
+static bool begin_priv ( )
+{
+    uint64_t stop_us = sim_i2c_stop_us( );
+
+    // read part of a transfer already acknowledged
+    if ( stop_us == ltc2497_ctx.transfer_stop_us )
+    {
+        return true;
+    }
+
+    if ( sim_time_us( ) < ltc2497_ctx.ready_us )
+    {
+        return false;
+    }
+
+    // the inputs change slowly, they are sampled when the result is collected
+    ltc2497_ctx.output = convert_priv( ltc2497_ctx.command );
+    ltc2497_ctx.transfer_stop_us = stop_us;
+    ltc2497_ctx.ready_us = stop_us + LTC2497_TCONV_US;
+
+    return true;
+}
+
+static uint32_t convert_priv ( uint8_t command )
+{
+    uint8_t pair = ( command & LTC2497_CMD_ADDRESS ) * 2;
+    bool odd = ( command & LTC2497_CMD_ODD ) != 0;
+    double fs = 0.5 * SIM_LTC2497_VREF;
+    double vin;
+    double code;
+    uint32_t word;
+
+    if ( command & LTC2497_CMD_SGL )
+    {
+        // single-ended against COM, which is grounded
+        vin = input_priv( pair + ( odd ? 1 : 0 ) );
+    }
+    else if ( odd )
+    {
+        vin = input_priv( pair + 1 ) - input_priv( pair );
+    }
+    else
+    {
+        vin = input_priv( pair ) - input_priv( pair + 1 );
+    }
+
+    if ( vin >= fs )
+    {
+        word = LTC2497_OVERRANGE;
+    }
+    else if ( vin < -fs )
+    {
+        word = LTC2497_UNDERRANGE;
+    }
+    else
+    {
+        code = floor( vin / fs * LTC2497_CODE_FS );
+        word = ( uint32_t )( ( int32_t )code + LTC2497_CODE_OFFSET );
+    }
+
+    return word << LTC2497_SUB_LSB_BITS;
+}
+
+static double input_priv ( uint8_t channel )
+{
+    if ( ltc2497_ctx.source == NULL )
+    {
+        return 0.0;
+    }
+
+    return ltc2497_ctx.source( channel );
+}
+
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,79 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the LTC2497 ADC model.
+ *
+ * The converter answers at 0x14 on the servo bus. A conversion takes
+ * 149.9 ms from the STOP of the previous transfer and the device does not
+ * acknowledge its address until it is done; a read returns the previous
+ * result while the channel written in the same transfer is used by the
+ * next conversion.
+ *
+ * \addtogroup sim_ltc2497 LTC2497 Model
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef SIM_LTC2497_H
+#define SIM_LTC2497_H
+
+#include "sim_i2c.h"
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+#define SIM_LTC2497_ADDRESS         0x14
+#define SIM_LTC2497_CHANNELS        16
+
+/* Reference of the Click board */
+#define SIM_LTC2497_VREF            3.3
+
+/** \} */ // End group macro
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup type Types
+ * \{
+ */
+
+/**
+ * @brief Input source, returns the voltage of a single-ended input.
+ */
+typedef double ( *SIM_LTC2497_SOURCE )( uint8_t channel );
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Attach function.
+ *
+ * @param bus          Bus the converter is wired to.
+ */
+void sim_ltc2497_attach ( SIM_I2C_BUS bus );
+
+/**
+ * @brief Source function.
+ *
+ * @param source       Function sampled at the start of every conversion,
+ *                     NULL to ground all the inputs.
+ */
+void sim_ltc2497_set_source ( SIM_LTC2497_SOURCE source );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _SIM_LTC2497_H_
@@ -0,0 +1,623 @@
+/* ************************************************************************** */
+/** Host simulation entry point
+
+  @Summary
+    Runs the unmodified application against the simulated cold case.
+
+  @Description
+    The scenario is built from the command line: ambient conditions, target
+    setpoint sent over Bluetooth, door openings. The power switch is pressed
+    once at start up, then the application runs until the requested time and
+    a summary is printed. The app sends the loopback frames back, after the
+    time they take over the air. Faults can be injected with -f: the alerts the app
+    receives are timed from the fault, or from the door opening.
+
+    With -b the standard scenarios are run instead, each in its own process
+    since the simulated board is global, and their control quality and
+    energy figures are printed side by side.
+ */
+/* ************************************************************************** */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "definitions.h"
+#include "sim.h"
+#include "sim_plib.h"
+#include "sim_hdc1080.h"
+#include "sim_pca9685.h"
+#include "sim_ltc2497.h"
+#include "sim_rn42.h"
+#include "plant.h"
+#include "bench.h"
+#include "bluesmirf.h"
+#include "btrx.h"
+#include "stepresponse.h"
+#include "tempcontrol.h"
+#include "nvstore.h"
+#include "rollup.h"
+#include "anomaly.h"
+#include "currentmon.h"
+#include "boot.h"
+
+/* Application entry point, main.cpp is built with -Dmain=app_main */
+int app_main(void);
+
+#define POWER_PRESS_US          (3 * SIM_US_PER_S)
+#define POWER_HOLD_US           (1500 * SIM_US_PER_MS)
+#define SETPOINT_SEND_US        (10 * SIM_US_PER_S)
+#define FRAME_LENGTH            7
+
+/* Current sense wiring, as in currentmon.c: the Click sense resistors of
+   the servo outputs, the cell and fan amplifiers on inputs 12 and 13 */
+#define SENSE_SERVO_V_PER_A     0.1
+#define SENSE_SUPPLY_V_PER_A    0.2
+#define SENSE_CELL_CHANNEL      12
+#define SENSE_FAN_CHANNEL       13
+
+typedef struct
+{
+    double hours;
+    double setpoint;
+    bool setpointSet;
+    double traceMin;
+    bool console;
+    int control;
+
+} SimOptions;
+
+typedef struct
+{
+    const char* name;
+    double hours;
+    double ambient;
+    double swing;
+    double doorStartMin;
+    double doorLenMin;
+
+} BenchScenario;
+
+static const BenchScenario benchScenarios[] =
+{
+    // pull-down from ambient and regulation
+    { "pulldown",  6.0, 25.0, 0.0,   0.0,  0.0 },
+    // door left open for 5 minutes once settled
+    { "door",     12.0, 25.0, 0.0, 480.0,  5.0 },
+    // daily ambient cycle between 17 and 33 C
+    { "swing",    48.0, 25.0, 8.0,   0.0,  0.0 },
+};
+
+#define BENCH_SCENARIOS         (sizeof(benchScenarios) / sizeof(benchScenarios[0]))
+
+static const char* const controlNames[] = { "hyst", "pi", "pid", "pred" };
+
+/* Faults injected with -f, the index is also the alert they should raise;
+   bt is a Bluetooth module that stops answering, noise a line that loses
+   bytes above the default rate, they raise none */
+static const char* const faultNames[] = { "cell", "fan", "stuck", "lid", "bt", "noise" };
+static const char* const alertNames[] = { "cooling failure", "door open", "sensor stuck", "actuator mismatch", "door stall" };
+
+/* Servo angle of the obstacle put in the way of the open lid by -f lid */
+#define LID_OBSTACLE_ANGLE      60.0
+
+#define ALERT_COUNT             (sizeof(alertNames) / sizeof(alertNames[0]))
+
+/* Round trip of a loopback frame from the module to the app and back */
+#define APP_ECHO_US             (10 * SIM_US_PER_MS)
+#define ECHO_SLOTS              16
+#define LOOPBACK_RUNS           8
+#define LINK_REPORT_LENGTH      10
+
+/* Frames sent by the device, decoded to time the alerts */
+typedef struct
+{
+    uint8_t type;
+    size_t length;
+    size_t expected;
+    uint8_t alerts;
+    uint8_t frame[BLUESMIRF_LOOP_FRAME];
+
+} BtDecoder;
+
+/* Loopback runs as reported to the app */
+typedef struct
+{
+    uint64_t atUs;
+    uint32_t baud;
+    uint16_t echoed;
+    uint16_t lost;
+    uint16_t bytesPerSec;
+
+} LoopbackRun;
+
+static SimOptions options = { 24.0, 5.0, false, 0.0, false, -1 };
+static struct timespec wallStart;
+static int benchFd = -1;
+static BtDecoder btDecoder;
+static uint64_t faultUs = SIM_TIME_NEVER;
+static uint64_t doorOpenUs = SIM_TIME_NEVER;
+static uint64_t alertUs[ALERT_COUNT];
+static uint8_t echoFrames[ECHO_SLOTS][BLUESMIRF_LOOP_FRAME];
+static size_t echoNext;
+static LoopbackRun loopbackRuns[LOOPBACK_RUNS];
+static size_t loopbackCount;
+
+static int runScenario(SIM_EVENT_CALLBACK end);
+
+static void usage(const char* name)
+{
+    fprintf(stderr,
+        "usage: %s [options]\n"
+        "  -H hours        simulated time (default 24)\n"
+        "  -D days         simulated time in days\n"
+        "  -a celsius      ambient temperature (default 25)\n"
+        "  -w celsius      ambient daily swing amplitude (default 0)\n"
+        "  -s celsius      setpoint sent from the app after power on\n"
+        "  -k minutes      start a step-response characterization\n"
+        "  -m mode         control mode sent with the setpoint: hyst, pi, pid, pred\n"
+        "                  (pred needs a build with APP_DEFS=-DTEMPCONTROL_PREDICTIVE)\n"
+        "  -o start,len    keep the door open, in minutes (repeatable)\n"
+        "  -L start,len    open the lid from the app, in minutes (repeatable)\n"
+        "  -f fault,start  inject a fault at the given minute: cell, fan, stuck, lid, bt, noise\n"
+        "  -u minutes      ask for the fast Bluetooth UART rate\n"
+        "  -l minutes      run a Bluetooth loopback benchmark (repeatable)\n"
+        "  -t minutes      print a trace line every interval\n"
+        "  -c              echo the debug console\n"
+        "  -b              run the benchmark scenarios and compare them\n", name);
+    exit(EXIT_FAILURE);
+}
+
+static void pressPowerSwitch(uintptr_t pressed)
+{
+    sim_port_drive(SIM_PIN_PS_SW, !pressed);
+}
+
+static void sendFrame(uint8_t command)
+{
+    int sp = (int)(options.setpoint * 10.0 + (options.setpoint >= 0 ? 0.5 : -0.5));
+    uint8_t frame[FRAME_LENGTH];
+
+    // '$', mode (0 = auto), command, setpoint MSB/LSB, outputs, ETX
+    frame[0] = '$';
+    frame[1] = 0;
+    frame[2] = command;
+    frame[3] = (uint8_t)(sp >> 8);
+    frame[4] = (uint8_t)sp;
+    frame[5] = 0;
+    frame[6] = '#';
+
+    sim_rn42_receive(frame, sizeof(frame));
+}
+
+static void sendSetpoint(uintptr_t context)
+{
+    sendFrame((options.control >= 0)? (uint8_t)(Command_ControlHysteresis + options.control) : Command_None);
+}
+
+static void sendCharacterize(uintptr_t context)
+{
+    sendFrame(Command_Characterize);
+}
+
+static void sendLid(uintptr_t open)
+{
+    sendFrame(open? Command_Open : Command_Close);
+}
+
+static void sendLink(uintptr_t command)
+{
+    sendFrame((uint8_t)command);
+}
+
+static void echoFrame(uintptr_t slot)
+{
+    sim_rn42_receive(echoFrames[slot], BLUESMIRF_LOOP_FRAME);
+}
+
+static void injectFault(uintptr_t fault)
+{
+    faultUs = sim_time_us();
+
+    if (fault == 5)
+        sim_rn42_set_noise(true);
+    else if (fault == 4)
+        sim_rn42_set_silent(true);
+    else if (fault == 3)
+        plant_block_lid(LID_OBSTACLE_ANGLE);
+    else if (fault == 2)
+        sim_hdc1080_set_stuck(true);
+    else
+        plant_set_fault((fault == 0)? PLANT_FAULT_CELL : PLANT_FAULT_FAN);
+}
+
+static double senseInput(uint8_t channel)
+{
+    if (channel == SENSE_CELL_CHANNEL)
+        return plant_cell_current_a() * SENSE_SUPPLY_V_PER_A;
+    if (channel == SENSE_FAN_CHANNEL)
+        return plant_fan_current_a() * SENSE_SUPPLY_V_PER_A;
+
+    return plant_servo_current_a(channel) * SENSE_SERVO_V_PER_A;
+}
+
+static void btOut(uint8_t data, uintptr_t context)
+{
+    BtDecoder* d = &btDecoder;
+
+    if (d->length == 0)
+    {
+        // status, step result, alerts; rollups are sized by their header
+        d->type = data;
+        d->expected = (data == '$')? 7 : (data == '&')? 14 : (data == '!')? 3 : (data == '%')? 4 :
+                      (data == '~')? BLUESMIRF_LOOP_FRAME : (data == '^')? LINK_REPORT_LENGTH : 1;
+    }
+    else if (d->type == '%' && d->length == 2)
+    {
+        d->expected += (size_t)data * sizeof(rollup_bucket_t);
+    }
+    else if (d->type == '!' && d->length == 1)
+    {
+        // first time each alert is raised
+        for (size_t i = 0; i < ALERT_COUNT; i++)
+            if ((data & (1 << i)) && !(d->alerts & (1 << i)) && alertUs[i] == SIM_TIME_NEVER)
+                alertUs[i] = sim_time_us();
+        d->alerts = data;
+    }
+
+    if ((d->type == '~' || d->type == '^') && d->length < sizeof(d->frame))
+        d->frame[d->length] = data;
+
+    if (++d->length < d->expected)
+        return;
+    d->length = 0;
+
+    if (d->type == '~')
+    {
+        // back once the frame is out, over the air and in at the module rate
+        uint64_t at = sim_bt_tx_done_us() + APP_ECHO_US +
+                      BLUESMIRF_LOOP_FRAME * SIM_UART_BYTE_NS(sim_rn42_baud()) / 1000;
+
+        memcpy(echoFrames[echoNext], d->frame, BLUESMIRF_LOOP_FRAME);
+        sim_schedule(at, echoFrame, echoNext);
+        echoNext = (echoNext + 1) % ECHO_SLOTS;
+    }
+    else if (d->type == '^' && loopbackCount < LOOPBACK_RUNS)
+    {
+        LoopbackRun* run = &loopbackRuns[loopbackCount++];
+
+        run->atUs = sim_time_us();
+        run->baud = ((d->frame[1] << 8) | d->frame[2]) * 100;
+        run->echoed = (d->frame[3] << 8) | d->frame[4];
+        run->lost = (d->frame[5] << 8) | d->frame[6];
+        run->bytesPerSec = (d->frame[7] << 8) | d->frame[8];
+    }
+}
+
+static void setDoor(uintptr_t open)
+{
+    if (open && doorOpenUs == SIM_TIME_NEVER)
+        doorOpenUs = sim_time_us();
+
+    plant_set_door(open != 0);
+}
+
+static void consoleOut(uint8_t data, uintptr_t context)
+{
+    putchar(data);
+}
+
+static void trace(uintptr_t context)
+{
+    printf("%10.1f min  air %6.2f C  hot %6.2f C  amb %5.2f C  rh %5.1f%%  cell %d  fan %d  lid %.2f\n",
+        (double)sim_time_us() / SIM_US_PER_MIN, plant_air_c(), plant_hot_c(),
+        plant_ambient_c(), plant_humidity(), plant_cell_on(), plant_fan_on(), plant_lid_open());
+
+    sim_schedule(sim_time_us() + (uint64_t)(options.traceMin * SIM_US_PER_MIN), trace, 0);
+}
+
+static void report(uintptr_t context)
+{
+    const plant_stats_t* st = plant_stats();
+    struct timespec wallEnd;
+    double wall;
+    double simSec = (double)sim_time_us() / SIM_US_PER_S;
+
+    clock_gettime(CLOCK_MONOTONIC, &wallEnd);
+    wall = (wallEnd.tv_sec - wallStart.tv_sec) + (wallEnd.tv_nsec - wallStart.tv_nsec) / 1e9;
+
+    printf("simulated      %.2f h in %.3f s wall (x%.0f), %llu idle skips\n",
+        simSec / 3600.0, wall, wall > 0 ? simSec / wall : 0.0,
+        (unsigned long long)sim_idle_count());
+    printf("air            %.2f C (ambient %.2f C, hot sink %.2f C)\n",
+        plant_air_c(), plant_ambient_c(), plant_hot_c());
+    printf("cell           %.1f%% on, %u starts, %.1f Wh\n",
+        100.0 * st->cell_on_us / sim_time_us(), st->cell_switches, st->cell_energy_j / 3600.0);
+    printf("fan            %.1f%% on, %u starts, %.1f Wh\n",
+        100.0 * st->fan_on_us / sim_time_us(), st->fan_switches, st->fan_energy_j / 3600.0);
+    printf("measured       cell %.1f Wh, fan %.1f Wh, door %.3f Wh; now %ld/%ld/%ld mA\n",
+        currentmon_energy_j(CURRENTMON_LOAD_CELL) / 3600.0, currentmon_energy_j(CURRENTMON_LOAD_FAN) / 3600.0,
+        currentmon_energy_j(CURRENTMON_LOAD_DOOR) / 3600.0, (long)currentmon_current_ma(CURRENTMON_LOAD_CELL),
+        (long)currentmon_current_ma(CURRENTMON_LOAD_FAN), (long)currentmon_current_ma(CURRENTMON_LOAD_DOOR));
+    printf("servos         %.3f Wh, PCA9685 awake %.2f%%\n",
+        st->servo_energy_j / 3600.0, 100.0 * sim_pca9685_awake_us() / sim_time_us());
+    printf("rn42           %u command lines answered, %lu baud, SERCOM3 at %lu baud\n", (unsigned)sim_rn42_commands(),
+        (unsigned long)sim_rn42_baud(), (unsigned long)sim_bt_baud());
+    printf("bt receive     %lu bytes by DMA, %lu lost\n", (unsigned long)btrx_received(),
+        (unsigned long)btrx_overruns());
+    printf("rgb led        %llu pattern frames by DMA, now %u/%u/%u\n", (unsigned long long)sim_led_frames(),
+        sim_led_level(SIM_LED_RED), sim_led_level(SIM_LED_GREEN), sim_led_level(SIM_LED_BLUE));
+    for (size_t i = 0; i < loopbackCount; i++)
+        printf("loopback       at %.2f min, %lu baud: %u echoed, %u lost, %u B/s\n",
+            (double)loopbackRuns[i].atUs / SIM_US_PER_MIN, (unsigned long)loopbackRuns[i].baud,
+            loopbackRuns[i].echoed, loopbackRuns[i].lost, loopbackRuns[i].bytesPerSec);
+    sim_i2c_report(stdout);
+
+    // where the start up went, as printed on the console
+    char line[80];
+    for (uint8_t i = 0; boot_trace(i, line, sizeof(line)) > 0; i++)
+    {
+        line[strcspn(line, "\r\n")] = '\0';
+        printf("%s\n", line);
+    }
+
+    // what the firmware left in flash
+    StepResult step;
+    if (nvstore_read(NVSTORE_ID_STEP_RESPONSE, &step, sizeof(step)))
+        printf("step response   status %u, baseline %.2f C, K %.2f C, tau %.0f s, L %.0f s, %.3f C/min, %u runs\n",
+            (unsigned)step.status, step.baselineC, step.gainC, step.tauS, step.deadTimeS,
+            step.maxRateCPerMin, (unsigned)step.runs);
+
+    // alerts as seen by the app, timed from the event that should raise them
+    for (size_t i = 0; i < ALERT_COUNT; i++)
+    {
+        uint64_t from = (i == 1)? doorOpenUs : (i == 4)? st->lid_stall_first_us : faultUs;
+        const char* what = (i == 1)? "door opened" : (i == 4)? "lid stalled" : "fault";
+
+        if (alertUs[i] == SIM_TIME_NEVER)
+            continue;
+        printf("alert %-16s at %.1f min", alertNames[i], (double)alertUs[i] / SIM_US_PER_MIN);
+        if (from != SIM_TIME_NEVER && from <= alertUs[i])
+            printf(", %.1f s after the %s", (double)(alertUs[i] - from) / SIM_US_PER_S, what);
+        printf("\n");
+    }
+    if (st->lid_stall_first_us != SIM_TIME_NEVER)
+        printf("lid stall      at %.1f min, %.0f ms at stall current\n",
+            (double)st->lid_stall_first_us / SIM_US_PER_MIN, (double)st->lid_stall_us / SIM_US_PER_MS);
+    if (faultUs != SIM_TIME_NEVER)
+        printf("fault          at %.1f min\n", (double)faultUs / SIM_US_PER_MIN);
+
+    // the hourly history the app would query, oldest first
+    rollup_bucket_t b;
+    for (int age = rollup_count(ROLLUP_HOUR) - 1; age >= 0; age--)
+    {
+        rollup_get(ROLLUP_HOUR, (uint16_t)age, &b);
+        printf("hour -%-3d      min %6.2f C  max %6.2f C  mean %6.2f C  cell %3u%%  fan %3u%%\n",
+            age + 1, b.min / 100.0, b.max / 100.0, b.mean / 100.0,
+            (unsigned)b.cell_duty, (unsigned)b.fan_duty);
+    }
+}
+
+static void benchDone(uintptr_t context)
+{
+    bench_metrics_t metrics;
+
+    bench_metrics(&metrics);
+    if (write(benchFd, &metrics, sizeof(metrics)) != sizeof(metrics))
+        exit(EXIT_FAILURE);
+    close(benchFd);
+}
+
+static void printBenchLine(const char* name, const bench_metrics_t* m)
+{
+    char settle[16];
+
+    if (m->settle_us == SIM_TIME_NEVER)
+        snprintf(settle, sizeof(settle), "never");
+    else
+        snprintf(settle, sizeof(settle), "%.1f min", (double)m->settle_us / SIM_US_PER_MIN);
+
+    printf("%-10s %11s %9.2f %9.2f %9.3f %8u %9.1f %8.1f\n", name, settle,
+        m->overshoot_c, m->peak_error_c, m->rms_error_c, m->cell_switches, m->cell_wh, m->fan_wh);
+}
+
+/* Forks one simulation per scenario, they run in parallel */
+static int runBenchmarks(const plant_params_t* defaults)
+{
+    pid_t pids[BENCH_SCENARIOS];
+    int fds[BENCH_SCENARIOS];
+    bench_metrics_t metrics;
+    int status;
+    int failed = 0;
+    size_t i;
+
+    fflush(stdout);
+
+    for (i = 0; i < BENCH_SCENARIOS; i++)
+    {
+        const BenchScenario* sc = &benchScenarios[i];
+        int fd[2];
+
+        if (pipe(fd) != 0)
+        {
+            perror("pipe");
+            return EXIT_FAILURE;
+        }
+
+        pids[i] = fork();
+        if (pids[i] < 0)
+        {
+            perror("fork");
+            return EXIT_FAILURE;
+        }
+
+        if (pids[i] == 0)
+        {
+            plant_params_t params = *defaults;
+
+            close(fd[0]);
+            benchFd = fd[1];
+
+            params.ambient_c = sc->ambient;
+            params.ambient_swing_c = sc->swing;
+            options.hours = sc->hours;
+            options.setpointSet = true;
+            options.traceMin = 0;
+            options.console = false;
+
+            if (sc->doorLenMin > 0)
+            {
+                sim_schedule((uint64_t)(sc->doorStartMin * SIM_US_PER_MIN), setDoor, 1);
+                sim_schedule((uint64_t)((sc->doorStartMin + sc->doorLenMin) * SIM_US_PER_MIN), setDoor, 0);
+            }
+
+            plant_init(&params);
+            bench_start(options.setpoint);
+
+            return runScenario(benchDone);
+        }
+
+        close(fd[1]);
+        fds[i] = fd[0];
+    }
+
+    printf("setpoint %.1f C, %s control, errors in C once within %.1f C of the setpoint\n\n",
+        options.setpoint, controlNames[(options.control >= 0)? options.control : 0], BENCH_SETTLE_C);
+    printf("%-10s %11s %9s %9s %9s %8s %9s %8s\n",
+        "scenario", "settle", "overshoot", "peak", "rms", "switches", "cell Wh", "fan Wh");
+
+    for (i = 0; i < BENCH_SCENARIOS; i++)
+    {
+        if ((read(fds[i], &metrics, sizeof(metrics)) == sizeof(metrics)) &&
+            (waitpid(pids[i], &status, 0) == pids[i]) && WIFEXITED(status) && (WEXITSTATUS(status) == 0))
+        {
+            printBenchLine(benchScenarios[i].name, &metrics);
+        }
+        else
+        {
+            printf("%-10s failed\n", benchScenarios[i].name);
+            failed = 1;
+        }
+        close(fds[i]);
+    }
+
+    return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/* Wires the board and runs the firmware until the end of the scenario */
+static int runScenario(SIM_EVENT_CALLBACK end)
+{
+    sim_hdc1080_attach(SIM_I2C_BUS_SERCOM0);
+    sim_pca9685_attach(SIM_I2C_BUS_SERCOM2);
+    sim_ltc2497_attach(SIM_I2C_BUS_SERCOM2);
+    sim_ltc2497_set_source(senseInput);
+
+    if (options.console)
+        sim_console_set_hook(consoleOut, 0);
+
+    for (size_t i = 0; i < ALERT_COUNT; i++)
+        alertUs[i] = SIM_TIME_NEVER;
+    sim_rn42_attach(btOut, 0);
+
+    // long press on the power switch to turn the case on
+    sim_schedule(POWER_PRESS_US, pressPowerSwitch, 1);
+    sim_schedule(POWER_PRESS_US + POWER_HOLD_US, pressPowerSwitch, 0);
+
+    if (options.setpointSet)
+        sim_schedule(SETPOINT_SEND_US, sendSetpoint, 0);
+
+    if (options.traceMin > 0)
+        sim_schedule(0, trace, 0);
+
+    sim_set_end((uint64_t)(options.hours * SIM_US_PER_HOUR), end, 0);
+
+    clock_gettime(CLOCK_MONOTONIC, &wallStart);
+
+    return app_main();
+}
+
+int main(int argc, char** argv)
+{
+    plant_params_t params;
+    double start, len;
+    bool benchmark = false;
+    int opt;
+
+    plant_default_params(&params);
+
+    while ((opt = getopt(argc, argv, "H:D:a:w:s:o:L:t:cm:bk:f:u:l:")) != -1)
+    {
+        switch (opt)
+        {
+            case 'H': options.hours = atof(optarg); break;
+            case 'D': options.hours = atof(optarg) * 24.0; break;
+            case 'a': params.ambient_c = atof(optarg); break;
+            case 'w': params.ambient_swing_c = atof(optarg); break;
+            case 's': options.setpoint = atof(optarg); options.setpointSet = true; break;
+            case 't': options.traceMin = atof(optarg); break;
+            case 'c': options.console = true; break;
+            case 'm':
+                for (opt = 0; opt < (int)(sizeof(controlNames) / sizeof(controlNames[0])); opt++)
+                    if (strcmp(optarg, controlNames[opt]) == 0)
+                        break;
+                if (opt == (int)(sizeof(controlNames) / sizeof(controlNames[0])))
+                    usage(argv[0]);
+#ifndef TEMPCONTROL_PREDICTIVE
+                // the firmware would stay in the mode it is in
+                if (opt == Control_Predictive)
+                    usage(argv[0]);
+#endif
+                options.control = opt;
+                options.setpointSet = true;
+                break;
+            case 'b': benchmark = true; break;
+            case 'k':
+                sim_schedule((uint64_t)(atof(optarg) * SIM_US_PER_MIN), sendCharacterize, 0);
+                break;
+            case 'u':
+                sim_schedule((uint64_t)(atof(optarg) * SIM_US_PER_MIN), sendLink, Command_FastLink);
+                break;
+            case 'l':
+                sim_schedule((uint64_t)(atof(optarg) * SIM_US_PER_MIN), sendLink, Command_LinkBenchmark);
+                break;
+            case 'f':
+                {
+                    char name[8];
+
+                    if (sscanf(optarg, "%7[a-z],%lf", name, &start) != 2)
+                        usage(argv[0]);
+                    for (opt = 0; opt < (int)(sizeof(faultNames) / sizeof(faultNames[0])); opt++)
+                        if (strcmp(name, faultNames[opt]) == 0)
+                            break;
+                    if (opt == (int)(sizeof(faultNames) / sizeof(faultNames[0])))
+                        usage(argv[0]);
+                    sim_schedule((uint64_t)(start * SIM_US_PER_MIN), injectFault, (uintptr_t)opt);
+                    break;
+                }
+            case 'o':
+                if (sscanf(optarg, "%lf,%lf", &start, &len) != 2)
+                    usage(argv[0]);
+                sim_schedule((uint64_t)(start * SIM_US_PER_MIN), setDoor, 1);
+                sim_schedule((uint64_t)((start + len) * SIM_US_PER_MIN), setDoor, 0);
+                break;
+            case 'L':
+                if (sscanf(optarg, "%lf,%lf", &start, &len) != 2)
+                    usage(argv[0]);
+                sim_schedule((uint64_t)(start * SIM_US_PER_MIN), sendLid, 1);
+                sim_schedule((uint64_t)((start + len) * SIM_US_PER_MIN), sendLid, 0);
+                break;
+            default:
+                usage(argv[0]);
+        }
+    }
+
+    if (benchmark)
+        return runBenchmarks(&params);
+
+    plant_init(&params);
+
+    return runScenario(report);
+}
@@ -0,0 +1,367 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include "definitions.h"
+#include "sim.h"
+#include "sim_pca9685.h"
+
+#define PCA9685_REG_MODE1           0x00
+#define PCA9685_REG_MODE2           0x01
+#define PCA9685_REG_SUBADR1         0x02
+#define PCA9685_REG_SUBADR2         0x03
+#define PCA9685_REG_SUBADR3         0x04
+#define PCA9685_REG_ALLCALLADR      0x05
+#define PCA9685_REG_LED0_ON_L       0x06
+#define PCA9685_REG_LED15_OFF_H     0x45
+#define PCA9685_REG_ALL_LED_ON_L    0xFA
+#define PCA9685_REG_ALL_LED_OFF_H   0xFD
+#define PCA9685_REG_PRE_SCALE       0xFE
+#define PCA9685_REG_TEST_MODE       0xFF
+
+#define PCA9685_MODE1_RESTART       0x80
+#define PCA9685_MODE1_EXTCLK        0x40
+#define PCA9685_MODE1_AI            0x20
+#define PCA9685_MODE1_SLEEP         0x10
+#define PCA9685_MODE1_SUB1          0x08
+#define PCA9685_MODE1_SUB2          0x04
+#define PCA9685_MODE1_SUB3          0x02
+#define PCA9685_MODE1_ALLCALL       0x01
+
+#define PCA9685_LED_FULL            0x10
+
+#define PCA9685_MODE1_DEFAULT       0x11
+#define PCA9685_MODE2_DEFAULT       0x04
+#define PCA9685_SUBADR1_DEFAULT     0xE2
+#define PCA9685_SUBADR2_DEFAULT     0xE4
+#define PCA9685_SUBADR3_DEFAULT     0xE8
+#define PCA9685_ALLCALLADR_DEFAULT  0xE0
+#define PCA9685_PRE_SCALE_DEFAULT   0x1E
+
+#define PCA9685_SWRST               0x06
+#define PCA9685_OSC_HZ              25000000.0
+
+/* The oscillator needs this long after SLEEP is cleared */
+#define PCA9685_OSC_STARTUP_US      500
+
+/**
+ * @brief Model ctx object definition.
+ */
+typedef struct
+{
+    sim_i2c_device_t dev;
+
+    uint8_t regs[ 256 ];
+    uint8_t pointer;
+
+    // outputs were stopped by SLEEP and can be resumed by RESTART
+    bool restart;
+
+    // oscillator stable from, time spent awake
+    uint64_t osc_us;
+    uint64_t awake_us;
+
+} sim_pca9685_t;
+
+static sim_pca9685_t pca9685_ctx;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static bool match_priv ( sim_i2c_device_t *dev, uint16_t address );
+static bool write_priv ( sim_i2c_device_t *dev, const uint8_t *data, uint32_t len );
+static bool read_priv ( sim_i2c_device_t *dev, uint8_t *data, uint32_t len );
+static void general_call_priv ( sim_i2c_device_t *dev, const uint8_t *data, uint32_t len );
+static void reset_priv ( );
+static void store_priv ( uint8_t reg, uint8_t value );
+static void mode1_priv ( uint8_t value );
+static void next_priv ( );
+static bool running_priv ( );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void sim_pca9685_attach ( SIM_I2C_BUS bus )
+{
+    pca9685_ctx.dev.name = "PCA9685";
+    pca9685_ctx.dev.address = SIM_PCA9685_ADDRESS;
+    pca9685_ctx.dev.match = match_priv;
+    pca9685_ctx.dev.write = write_priv;
+    pca9685_ctx.dev.read = read_priv;
+    pca9685_ctx.dev.general_call = general_call_priv;
+
+    reset_priv( );
+
+    sim_i2c_attach( bus, &pca9685_ctx.dev );
+}
+
+int sim_pca9685_pulse ( uint8_t channel )
+{
+    const uint8_t *led = &pca9685_ctx.regs[ PCA9685_REG_LED0_ON_L + 4 * channel ];
+    uint16_t on;
+    uint16_t off;
+
+    // OE is active low; outputs stopped by SLEEP wait for RESTART
+    if ( !running_priv( ) || pca9685_ctx.restart || SERVO_OE_Get( ) )
+    {
+        return SIM_PCA9685_NO_PULSE;
+    }
+
+    // full off has priority over full on
+    if ( led[ 3 ] & PCA9685_LED_FULL )
+    {
+        return 0;
+    }
+    if ( led[ 1 ] & PCA9685_LED_FULL )
+    {
+        return 4096;
+    }
+
+    on = ( ( led[ 1 ] & 0x0F ) << 8 ) | led[ 0 ];
+    off = ( ( led[ 3 ] & 0x0F ) << 8 ) | led[ 2 ];
+
+    return ( off - on ) & 0x0FFF;
+}
+
+double sim_pca9685_frequency ( )
+{
+    if ( !running_priv( ) )
+    {
+        return 0.0;
+    }
+
+    return PCA9685_OSC_HZ / ( 4096.0 * ( pca9685_ctx.regs[ PCA9685_REG_PRE_SCALE ] + 1 ) );
+}
+
+uint64_t sim_pca9685_awake_us ( )
+{
+    if ( pca9685_ctx.regs[ PCA9685_REG_MODE1 ] & PCA9685_MODE1_SLEEP )
+    {
+        return pca9685_ctx.awake_us;
+    }
+
+    return pca9685_ctx.awake_us + ( sim_time_us( ) - pca9685_ctx.osc_us + PCA9685_OSC_STARTUP_US );
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static bool match_priv ( sim_i2c_device_t *dev, uint16_t address )
+{
+    uint8_t mode1 = pca9685_ctx.regs[ PCA9685_REG_MODE1 ];
+
+    // the programmable addresses are stored as 8-bit write addresses
+    if ( ( mode1 & PCA9685_MODE1_ALLCALL ) && ( address == ( pca9685_ctx.regs[ PCA9685_REG_ALLCALLADR ] >> 1 ) ) )
+    {
+        return true;
+    }
+    if ( ( mode1 & PCA9685_MODE1_SUB1 ) && ( address == ( pca9685_ctx.regs[ PCA9685_REG_SUBADR1 ] >> 1 ) ) )
+    {
+        return true;
+    }
+    if ( ( mode1 & PCA9685_MODE1_SUB2 ) && ( address == ( pca9685_ctx.regs[ PCA9685_REG_SUBADR2 ] >> 1 ) ) )
+    {
+        return true;
+    }
+    if ( ( mode1 & PCA9685_MODE1_SUB3 ) && ( address == ( pca9685_ctx.regs[ PCA9685_REG_SUBADR3 ] >> 1 ) ) )
+    {
+        return true;
+    }
+
+    return false;
+}
+
+static bool write_priv ( sim_i2c_device_t *dev, const uint8_t *data, uint32_t len )
+{
+    uint32_t i;
+
+    if ( len == 0 )
+    {
+        return true;
+    }
+
+    pca9685_ctx.pointer = data[ 0 ];
+
+    for ( i = 1; i < len; i++ )
+    {
+        store_priv( pca9685_ctx.pointer, data[ i ] );
+        next_priv( );
+    }
+
+    return true;
+}
+
+static bool read_priv ( sim_i2c_device_t *dev, uint8_t *data, uint32_t len )
+{
+    uint8_t reg;
+    uint32_t i;
+
+    for ( i = 0; i < len; i++ )
+    {
+        reg = pca9685_ctx.pointer;
+
+        // the ALL_LED registers are write only
+        if ( ( reg >= PCA9685_REG_ALL_LED_ON_L ) && ( reg <= PCA9685_REG_ALL_LED_OFF_H ) )
+        {
+            data[ i ] = 0;
+        }
+        else
+        {
+            data[ i ] = pca9685_ctx.regs[ reg ];
+        }
+        next_priv( );
+    }
+
+    return true;
+}
+
+static void general_call_priv ( sim_i2c_device_t *dev, const uint8_t *data, uint32_t len )
+{
+    if ( ( len == 1 ) && ( data[ 0 ] == PCA9685_SWRST ) )
+    {
+        reset_priv( );
+    }
+}
+
+static void reset_priv ( )
+{
+    uint16_t i;
+
+    for ( i = 0; i < 256; i++ )
+    {
+        pca9685_ctx.regs[ i ] = 0;
+    }
+
+    // every output powers up full off
+    for ( i = 0; i < SIM_PCA9685_CHANNELS; i++ )
+    {
+        pca9685_ctx.regs[ PCA9685_REG_LED0_ON_L + 4 * i + 3 ] = PCA9685_LED_FULL;
+    }
+
+    pca9685_ctx.regs[ PCA9685_REG_MODE1 ] = PCA9685_MODE1_DEFAULT;
+    pca9685_ctx.regs[ PCA9685_REG_MODE2 ] = PCA9685_MODE2_DEFAULT;
+    pca9685_ctx.regs[ PCA9685_REG_SUBADR1 ] = PCA9685_SUBADR1_DEFAULT;
+    pca9685_ctx.regs[ PCA9685_REG_SUBADR2 ] = PCA9685_SUBADR2_DEFAULT;
+    pca9685_ctx.regs[ PCA9685_REG_SUBADR3 ] = PCA9685_SUBADR3_DEFAULT;
+    pca9685_ctx.regs[ PCA9685_REG_ALLCALLADR ] = PCA9685_ALLCALLADR_DEFAULT;
+    pca9685_ctx.regs[ PCA9685_REG_PRE_SCALE ] = PCA9685_PRE_SCALE_DEFAULT;
+    pca9685_ctx.pointer = 0;
+    pca9685_ctx.restart = false;
+    pca9685_ctx.osc_us = SIM_TIME_NEVER;
+}
+
+static void store_priv ( uint8_t reg, uint8_t value )
+{
+    uint8_t i;
+
+    if ( reg == PCA9685_REG_MODE1 )
+    {
+        mode1_priv( value );
+    }
+    else if ( ( reg >= PCA9685_REG_ALL_LED_ON_L ) && ( reg <= PCA9685_REG_ALL_LED_OFF_H ) )
+    {
+        for ( i = 0; i < SIM_PCA9685_CHANNELS; i++ )
+        {
+            pca9685_ctx.regs[ PCA9685_REG_LED0_ON_L + 4 * i + ( reg - PCA9685_REG_ALL_LED_ON_L ) ] = value;
+        }
+    }
+    else if ( reg == PCA9685_REG_PRE_SCALE )
+    {
+        // the prescaler can only be written while the oscillator is off
+        if ( pca9685_ctx.regs[ PCA9685_REG_MODE1 ] & PCA9685_MODE1_SLEEP )
+        {
+            pca9685_ctx.regs[ reg ] = value;
+        }
+    }
+    else if ( ( reg <= PCA9685_REG_LED15_OFF_H ) || ( reg == PCA9685_REG_TEST_MODE ) )
+    {
+        pca9685_ctx.regs[ reg ] = value;
+
+        // a new PWM value restarts the outputs as well
+        if ( ( reg >= PCA9685_REG_LED0_ON_L ) && !( pca9685_ctx.regs[ PCA9685_REG_MODE1 ] & PCA9685_MODE1_SLEEP ) )
+        {
+            pca9685_ctx.restart = false;
+        }
+    }
+
+    // 0x46 to 0xF9 are reserved, writes are ignored
+}
+
+static void mode1_priv ( uint8_t value )
+{
+    uint8_t mode1 = pca9685_ctx.regs[ PCA9685_REG_MODE1 ];
+
+    // entering sleep with outputs running arms RESTART
+    if ( !( mode1 & PCA9685_MODE1_SLEEP ) && ( value & PCA9685_MODE1_SLEEP ) )
+    {
+        pca9685_ctx.restart = true;
+    }
+
+    // writing 1 to RESTART clears it once the oscillator has been running
+    // for its start up time, before that it has no effect; 0 never has
+    if ( ( value & PCA9685_MODE1_RESTART ) && !( value & PCA9685_MODE1_SLEEP ) &&
+         !( mode1 & PCA9685_MODE1_SLEEP ) && running_priv( ) )
+    {
+        pca9685_ctx.restart = false;
+    }
+
+    if ( ( mode1 & PCA9685_MODE1_SLEEP ) && !( value & PCA9685_MODE1_SLEEP ) )
+    {
+        pca9685_ctx.osc_us = sim_time_us( ) + PCA9685_OSC_STARTUP_US;
+    }
+    else if ( !( mode1 & PCA9685_MODE1_SLEEP ) && ( value & PCA9685_MODE1_SLEEP ) )
+    {
+        pca9685_ctx.awake_us = sim_pca9685_awake_us( );
+        pca9685_ctx.osc_us = SIM_TIME_NEVER;
+    }
+
+    // EXTCLK is sticky and only latched while already in sleep
+    if ( !( mode1 & PCA9685_MODE1_SLEEP ) )
+    {
+        value = ( value & ~PCA9685_MODE1_EXTCLK ) | ( mode1 & PCA9685_MODE1_EXTCLK );
+    }
+    else
+    {
+        value |= mode1 & PCA9685_MODE1_EXTCLK;
+    }
+
+    value &= ~PCA9685_MODE1_RESTART;
+    if ( pca9685_ctx.restart )
+    {
+        value |= PCA9685_MODE1_RESTART;
+    }
+
+    pca9685_ctx.regs[ PCA9685_REG_MODE1 ] = value;
+}
+
+static void next_priv ( )
+{
+    if ( !( pca9685_ctx.regs[ PCA9685_REG_MODE1 ] & PCA9685_MODE1_AI ) )
+    {
+        return;
+    }
+
+    // the LED block wraps back to MODE1, the pointer wraps past 0xFF
+    if ( pca9685_ctx.pointer == PCA9685_REG_LED15_OFF_H )
+    {
+        pca9685_ctx.pointer = PCA9685_REG_MODE1;
+    }
+    else
+    {
+        pca9685_ctx.pointer++;
+    }
+}
+
+static bool running_priv ( )
+{
+    // the external clock input is not driven on this board
+    if ( pca9685_ctx.regs[ PCA9685_REG_MODE1 ] & ( PCA9685_MODE1_SLEEP | PCA9685_MODE1_EXTCLK ) )
+    {
+        return false;
+    }
+
+    return sim_time_us( ) >= pca9685_ctx.osc_us;
+}
+
+// ------------------------------------------------------------------------- END
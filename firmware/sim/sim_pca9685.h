@@ -0,0 +1,83 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the PCA9685 device model.
+ *
+ * The model keeps the register file of the Servo click PWM controller and
+ * exposes the pulse driven on each channel to the plant.
+ *
+ * \addtogroup sim_pca9685 PCA9685 Model
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef SIM_PCA9685_H
+#define SIM_PCA9685_H
+
+#include "sim_i2c.h"
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+#define SIM_PCA9685_ADDRESS         0x40
+#define SIM_PCA9685_CHANNELS        16
+
+/* Pulse returned for a channel that is not driven */
+#define SIM_PCA9685_NO_PULSE        -1
+
+/** \} */ // End group macro
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Attach function.
+ *
+ * @param bus          Bus the controller is wired to.
+ */
+void sim_pca9685_attach ( SIM_I2C_BUS bus );
+
+/**
+ * @brief Pulse function.
+ *
+ * @param channel      Output channel, 0 to 15.
+ *
+ * @returns High time of the output in 1/4096 of the period, or
+ * SIM_PCA9685_NO_PULSE when the oscillator or the outputs are off. A
+ * full on output returns 4096, a full off output 0.
+ */
+int sim_pca9685_pulse ( uint8_t channel );
+
+/**
+ * @brief Frequency function.
+ *
+ * @returns Output frequency set by the prescaler, 0 while the internal
+ * oscillator is stopped.
+ */
+double sim_pca9685_frequency ( );
+
+/**
+ * @brief Awake time function.
+ *
+ * @returns Time spent with the oscillator on since the simulation started,
+ * its start up included.
+ */
+uint64_t sim_pca9685_awake_us ( );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _SIM_PCA9685_H_
@@ -0,0 +1,1032 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * Host implementation of the plib subset declared in include/definitions.h.
+ * Registers are replaced by plain state; everything that takes time on the
+ * target advances the simulation clock by the same amount.
+ */
+
+#include <string.h>
+#include "definitions.h"
+#include "sim.h"
+#include "sim_plib.h"
+#include "sim_i2c.h"
+
+#define RTC_FREQ                    RTC_COUNTER_CLOCK_FREQUENCY
+#define RGBLED_PERIOD               30000
+
+/* Only the top of the flash is backed, the application image is not needed */
+#define FLASH_SIZE                  0x100000UL
+#define FLASH_BACKED                0x8000UL
+#define FLASH_BACKED_BASE           ( FLASH_SIZE - FLASH_BACKED )
+#define NVMCTRL_INTFLAG_ADDRE       0x0004
+#define DMAC_CHANNELS               5
+
+/* Channel 1 settings from the MHC configuration: BLOCKACT_INT, byte beats,
+   VALID, DSTINC */
+#define DMAC_BTCTRL_CH_1            0x0809
+
+/* Channels 2 to 4, the RGB LED: BLOCKACT_NOACT, word beats, VALID, SRCINC.
+   A beat on every RTC periodic event 2, one every 2^5 ticks */
+#define DMAC_BTCTRL_CH_LED          0x0601
+#define DMAC_EVENT_SHIFT            5
+
+/**
+ * @brief RTC MODE0 state, the counter is derived from the simulation clock.
+ */
+typedef struct
+{
+    bool running;
+    uint64_t start_us;
+
+    // counter value at an absolute tick, the count moves on from there
+    uint32_t count_ref;
+    uint64_t tick_ref;
+
+    uint32_t comp0;
+    uint32_t comp1;
+    uint32_t inten;
+    uint32_t intflag;
+    bool pending;
+
+    RTC_TIMER32_CALLBACK callback;
+    uintptr_t context;
+
+} sim_rtc_t;
+
+/**
+ * @brief DMAC channel state.
+ */
+typedef struct
+{
+    DMAC_CHANNEL_CALLBACK callback;
+    uintptr_t context;
+    bool busy;
+
+    // linked list transfers: the descriptor being run, the beats done in it
+    // and the transfer complete flag not yet taken by the interrupt
+    dmac_descriptor_registers_t desc;
+    uint16_t count;
+    bool complete;
+
+    // event triggered channels: RTC periodic events already taken
+    uint64_t events;
+
+} sim_dmac_t;
+
+/**
+ * @brief Peripherals ctx object definition.
+ */
+typedef struct
+{
+    bool irq_enabled;
+
+    uint32_t port[ SIM_PORT_GROUPS ];
+
+    bool systick_running;
+    uint64_t systick_start;
+
+    sim_rtc_t rtc;
+
+    EIC_CALLBACK eic_callback[ 16 ];
+    uintptr_t eic_context[ 16 ];
+
+    SERCOM_I2C_CALLBACK i2c_callback[ SIM_I2C_BUS_COUNT ];
+    uintptr_t i2c_context[ SIM_I2C_BUS_COUNT ];
+
+    sim_dmac_t dmac[ DMAC_CHANNELS ];
+
+    uint8_t bt_rx[ SIM_BT_RX_BUFFER_SIZE ];
+    size_t bt_rx_head;
+    size_t bt_rx_count;
+    // in ns, a byte is not a whole number of us at every rate
+    uint64_t bt_tx_done_ns;
+    uint32_t bt_baud;
+    SIM_UART_TX_HOOK bt_tx_hook;
+    uintptr_t bt_tx_context;
+
+    SIM_UART_TX_HOOK console_hook;
+    uintptr_t console_context;
+
+    uint64_t led_frames;
+
+    // erased state is all ones
+    uint8_t flash[ FLASH_BACKED ];
+    bool flash_ready;
+    uint16_t nvm_error;
+
+} sim_plib_t;
+
+sercom_registers_t sim_sercom3_regs;
+sercom_registers_t sim_sercom5_regs;
+
+// the LED is active low: a full period is off
+tcc_registers_t sim_tcc0_regs = { 0, { 0, 0, RGBLED_PERIOD, RGBLED_PERIOD, 0, 0 } };
+tcc_registers_t sim_tcc1_regs = { 0, { RGBLED_PERIOD, 0, 0, 0, 0, 0 } };
+
+static sim_plib_t plib_ctx =
+{
+    .irq_enabled = true,
+    // PS_SW is pulled up, SERVO_OE disables the outputs until cleared
+    .port = { ( 1UL << SIM_PIN_SERVO_OE ) | ( 1UL << SIM_PIN_PS_ON ), 1UL << ( SIM_PIN_PS_SW % 32 ) },
+    .bt_baud = SIM_UART_BAUD,
+};
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static uint64_t rtc_ticks_priv ( uint64_t t_us );
+static uint64_t rtc_events_priv ( );
+static uint64_t rtc_tick_time_priv ( uint64_t tick );
+static uint32_t rtc_count_priv ( );
+static void rtc_next_ticks_priv ( uint64_t *t0, uint64_t *t1 );
+static void rtc_dispatch_priv ( );
+static void dmac_complete_priv ( uintptr_t context );
+static void dmac_beat_priv ( DMAC_CHANNEL channel, uint8_t data );
+static void dmac_dispatch_priv ( );
+static void dmac_events_priv ( DMAC_CHANNEL channel );
+static bool i2c_transfer_priv ( SIM_I2C_BUS bus, uint16_t address, uint8_t *wr_data, uint32_t wr_len,
+                               uint8_t *rd_data, uint32_t rd_len );
+static void i2c_complete_priv ( uintptr_t context );
+static void flash_priv ( );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void SYS_Initialize( void *data )
+{
+    plib_ctx.irq_enabled = true;
+}
+
+void NVIC_INT_Enable( void )
+{
+    plib_ctx.irq_enabled = true;
+    rtc_dispatch_priv( );
+    dmac_dispatch_priv( );
+}
+
+bool NVIC_INT_Disable( void )
+{
+    bool state = plib_ctx.irq_enabled;
+
+    plib_ctx.irq_enabled = false;
+
+    return state;
+}
+
+void NVIC_INT_Restore( bool state )
+{
+    if ( state )
+    {
+        NVIC_INT_Enable( );
+    }
+}
+
+// ----------------------------------------------------------------------- PORT
+
+void sim_port_set( SIM_PIN pin )
+{
+    sim_port_group_set( pin / 32, 1UL << ( pin % 32 ) );
+}
+
+void sim_port_clear( SIM_PIN pin )
+{
+    sim_port_group_clear( pin / 32, 1UL << ( pin % 32 ) );
+}
+
+void sim_port_toggle( SIM_PIN pin )
+{
+    sim_port_group_toggle( pin / 32, 1UL << ( pin % 32 ) );
+}
+
+uint32_t sim_port_get( SIM_PIN pin )
+{
+    return sim_port_group_read( pin / 32, 1UL << ( pin % 32 ) ) ? 1U : 0U;
+}
+
+void sim_port_group_set( uint8_t group, uint32_t mask )
+{
+    plib_ctx.port[ group ] |= mask;
+}
+
+void sim_port_group_clear( uint8_t group, uint32_t mask )
+{
+    plib_ctx.port[ group ] &= ~mask;
+}
+
+void sim_port_group_toggle( uint8_t group, uint32_t mask )
+{
+    plib_ctx.port[ group ] ^= mask;
+}
+
+uint32_t sim_port_group_read( uint8_t group, uint32_t mask )
+{
+    return plib_ctx.port[ group ] & mask;
+}
+
+void sim_port_drive ( SIM_PIN pin, bool level )
+{
+    level ? sim_port_set( pin ) : sim_port_clear( pin );
+}
+
+// -------------------------------------------------------------------- SYSTICK
+
+void SYSTICK_TimerStart ( void )
+{
+    plib_ctx.systick_running = true;
+    plib_ctx.systick_start = sim_time_us( );
+}
+
+void SYSTICK_TimerStop ( void )
+{
+    plib_ctx.systick_running = false;
+}
+
+void SYSTICK_DelayMs ( uint32_t delay_ms )
+{
+    sim_advance_us( ( uint64_t )delay_ms * SIM_US_PER_MS );
+}
+
+void SYSTICK_DelayUs ( uint32_t delay_us )
+{
+    sim_advance_us( delay_us );
+}
+
+uint32_t SYSTICK_GetTickCounter( void )
+{
+    if ( !plib_ctx.systick_running )
+    {
+        return 0;
+    }
+
+    return ( uint32_t )( ( sim_time_us( ) - plib_ctx.systick_start ) / ( SYSTICK_INTERRUPT_PERIOD_IN_US ) );
+}
+
+// ------------------------------------------------------------------------ RTC
+
+void RTC_Timer32Start ( void )
+{
+    sim_rtc_t *rtc = &plib_ctx.rtc;
+
+    if ( rtc->running )
+    {
+        return;
+    }
+
+    rtc->running = true;
+    rtc->start_us = sim_time_us( );
+    rtc->tick_ref = 0;
+}
+
+void RTC_Timer32Stop ( void )
+{
+    sim_rtc_t *rtc = &plib_ctx.rtc;
+
+    rtc->count_ref = rtc_count_priv( );
+    rtc->running = false;
+}
+
+void RTC_Timer32CounterSet ( uint32_t count )
+{
+    sim_rtc_t *rtc = &plib_ctx.rtc;
+
+    rtc->count_ref = count;
+    rtc->tick_ref = rtc->running ? rtc_ticks_priv( sim_time_us( ) ) : 0;
+}
+
+uint32_t RTC_Timer32CounterGet ( void )
+{
+    return rtc_count_priv( );
+}
+
+uint32_t RTC_Timer32FrequencyGet ( void )
+{
+    return RTC_FREQ;
+}
+
+void RTC_Timer32Compare0Set ( uint32_t compareValue )
+{
+    plib_ctx.rtc.comp0 = compareValue;
+}
+
+void RTC_Timer32Compare1Set ( uint32_t compareValue )
+{
+    plib_ctx.rtc.comp1 = compareValue;
+}
+
+uint32_t RTC_Timer32PeriodGet ( void )
+{
+    return plib_ctx.rtc.comp0;
+}
+
+void RTC_Timer32InterruptEnable( RTC_TIMER32_INT_MASK interruptMask )
+{
+    plib_ctx.rtc.inten |= interruptMask;
+}
+
+void RTC_Timer32InterruptDisable( RTC_TIMER32_INT_MASK interruptMask )
+{
+    plib_ctx.rtc.inten &= ~interruptMask;
+}
+
+void RTC_Timer32CallbackRegister ( RTC_TIMER32_CALLBACK callback, uintptr_t context )
+{
+    plib_ctx.rtc.callback = callback;
+    plib_ctx.rtc.context = context;
+
+    // RTC_Initialize() enables the CMP0 interrupt
+    plib_ctx.rtc.inten |= RTC_TIMER32_INT_MASK_CMP0;
+}
+
+uint64_t sim_rtc_next_us ( )
+{
+    uint64_t t0;
+    uint64_t t1;
+
+    if ( !plib_ctx.rtc.running )
+    {
+        return SIM_TIME_NEVER;
+    }
+
+    rtc_next_ticks_priv( &t0, &t1 );
+
+    return rtc_tick_time_priv( ( t1 < t0 ) ? t1 : t0 );
+}
+
+void sim_rtc_expire ( )
+{
+    sim_rtc_t *rtc = &plib_ctx.rtc;
+    uint64_t t0;
+    uint64_t t1;
+    uint64_t tick;
+
+    rtc_next_ticks_priv( &t0, &t1 );
+    tick = ( t1 < t0 ) ? t1 : t0;
+
+    // flags are set on the counter cycle following the match
+    if ( tick == t0 )
+    {
+        rtc->count_ref = 0;
+        rtc->intflag |= RTC_TIMER32_INT_MASK_CMP0;
+    }
+    else
+    {
+        rtc->count_ref = rtc->comp1 + 1;
+    }
+    if ( tick == t1 )
+    {
+        rtc->intflag |= RTC_TIMER32_INT_MASK_CMP1;
+    }
+    rtc->tick_ref = tick;
+
+    if ( rtc->intflag & rtc->inten )
+    {
+        rtc->pending = true;
+        rtc_dispatch_priv( );
+    }
+}
+
+// ------------------------------------------------------------------------ EIC
+
+void EIC_CallbackRegister(EIC_PIN pin, EIC_CALLBACK callback, uintptr_t context)
+{
+    if ( pin < 16 )
+    {
+        plib_ctx.eic_callback[ pin ] = callback;
+        plib_ctx.eic_context[ pin ] = context;
+    }
+}
+
+// -------------------------------------------------------------------- NVMCTRL
+
+bool NVMCTRL_Read( uint32_t *data, uint32_t length, const uint32_t address )
+{
+    uint8_t *dst = ( uint8_t * )data;
+    uint32_t i;
+
+    flash_priv( );
+    for ( i = 0; i < length; i++ )
+    {
+        dst[ i ] = ( address + i >= FLASH_BACKED_BASE && address + i < FLASH_SIZE ) ?
+                   plib_ctx.flash[ address + i - FLASH_BACKED_BASE ] : 0xFF;
+    }
+
+    return true;
+}
+
+bool NVMCTRL_PageWrite( const uint32_t* data, const uint32_t address )
+{
+    const uint8_t *src = ( const uint8_t * )data;
+    uint32_t i;
+
+    flash_priv( );
+    plib_ctx.nvm_error = 0;
+
+    if ( ( address < FLASH_BACKED_BASE ) || ( address >= FLASH_SIZE ) ||
+         ( address % NVMCTRL_FLASH_PAGESIZE ) != 0 )
+    {
+        plib_ctx.nvm_error = NVMCTRL_INTFLAG_ADDRE;
+        return true;
+    }
+
+    // programming can only clear bits
+    for ( i = 0; i < NVMCTRL_FLASH_PAGESIZE; i++ )
+    {
+        plib_ctx.flash[ address + i - FLASH_BACKED_BASE ] &= src[ i ];
+    }
+
+    return true;
+}
+
+bool NVMCTRL_BlockErase( uint32_t address )
+{
+    flash_priv( );
+    plib_ctx.nvm_error = 0;
+
+    if ( ( address < FLASH_BACKED_BASE ) || ( address >= FLASH_SIZE ) )
+    {
+        plib_ctx.nvm_error = NVMCTRL_INTFLAG_ADDRE;
+        return true;
+    }
+
+    address &= ~( NVMCTRL_FLASH_BLOCKSIZE - 1 );
+    memset( &plib_ctx.flash[ address - FLASH_BACKED_BASE ], 0xFF, NVMCTRL_FLASH_BLOCKSIZE );
+
+    return true;
+}
+
+uint16_t NVMCTRL_ErrorGet( void )
+{
+    return plib_ctx.nvm_error;
+}
+
+bool NVMCTRL_IsBusy( void )
+{
+    return false;
+}
+
+// ----------------------------------------------------------------------- DMAC
+
+void DMAC_ChannelCallbackRegister (DMAC_CHANNEL channel, const DMAC_CHANNEL_CALLBACK callback, const uintptr_t context)
+{
+    plib_ctx.dmac[ channel ].callback = callback;
+    plib_ctx.dmac[ channel ].context = context;
+}
+
+bool DMAC_ChannelTransfer (DMAC_CHANNEL channel, const void *srcAddr, const void *destAddr, size_t blockSize)
+{
+    sim_dmac_t *ch = &plib_ctx.dmac[ channel ];
+
+    if ( ch->busy )
+    {
+        return false;
+    }
+
+    // the source is read as the bytes go out, see dmac_complete_priv(): a
+    // buffer written again before the end shows up on the console
+    ch->desc.DMAC_SRCADDR = ( uintptr_t )srcAddr + blockSize;
+    ch->desc.DMAC_DSTADDR = ( uintptr_t )destAddr;
+    ch->desc.DMAC_BTCNT = ( uint16_t )blockSize;
+
+    ch->busy = true;
+    sim_schedule( sim_time_us( ) + blockSize * SIM_UART_BYTE_US, dmac_complete_priv, channel );
+
+    return true;
+}
+
+bool DMAC_LinkedListTransfer (DMAC_CHANNEL channel, dmac_descriptor_registers_t* channelDesc)
+{
+    sim_dmac_t *ch = &plib_ctx.dmac[ channel ];
+
+    if ( ch->busy )
+    {
+        return false;
+    }
+
+    // channel 1 is triggered by the SERCOM3 receive, see sim_bt_receive(),
+    // the LED channels by the RTC events from now on
+    ch->desc = *channelDesc;
+    ch->count = 0;
+    ch->complete = false;
+    ch->busy = true;
+    ch->events = rtc_events_priv( );
+
+    return true;
+}
+
+void DMAC_ChannelDisable ( DMAC_CHANNEL channel )
+{
+    dmac_events_priv( channel );
+    plib_ctx.dmac[ channel ].busy = false;
+}
+
+bool DMAC_ChannelIsBusy ( DMAC_CHANNEL channel )
+{
+    return plib_ctx.dmac[ channel ].busy;
+}
+
+DMAC_CHANNEL_CONFIG DMAC_ChannelSettingsGet ( DMAC_CHANNEL channel )
+{
+    if ( channel >= DMAC_CHANNEL_2 )
+    {
+        return DMAC_BTCTRL_CH_LED;
+    }
+
+    return ( channel == DMAC_CHANNEL_1 ) ? DMAC_BTCTRL_CH_1 : 0;
+}
+
+uint16_t DMAC_ChannelGetTransferredCount( DMAC_CHANNEL channel )
+{
+    sim_dmac_t *ch = &plib_ctx.dmac[ channel ];
+
+    dmac_events_priv( channel );
+
+    // the write-back still holds the finished block until the next beat
+    return ( ch->complete && ( ch->count == 0 ) ) ? ch->desc.DMAC_BTCNT : ch->count;
+}
+
+DMAC_TRANSFER_EVENT DMAC_ChannelTransferStatusGet(DMAC_CHANNEL channel)
+{
+    return plib_ctx.dmac[ channel ].complete ? DMAC_TRANSFER_EVENT_COMPLETE : DMAC_TRANSFER_EVENT_NONE;
+}
+
+// --------------------------------------------------------------------- SERCOM
+
+bool SERCOM0_I2C_Read(uint16_t address, uint8_t* rdData, uint32_t rdLength)
+{
+    return i2c_transfer_priv( SIM_I2C_BUS_SERCOM0, address, NULL, 0, rdData, rdLength );
+}
+
+bool SERCOM0_I2C_Write(uint16_t address, uint8_t* wrData, uint32_t wrLength)
+{
+    return i2c_transfer_priv( SIM_I2C_BUS_SERCOM0, address, wrData, wrLength, NULL, 0 );
+}
+
+bool SERCOM0_I2C_WriteRead(uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength)
+{
+    return i2c_transfer_priv( SIM_I2C_BUS_SERCOM0, address, wrData, wrLength, rdData, rdLength );
+}
+
+bool SERCOM0_I2C_IsBusy(void)
+{
+    return sim_i2c_is_busy( SIM_I2C_BUS_SERCOM0 );
+}
+
+bool SERCOM2_I2C_Read(uint16_t address, uint8_t* rdData, uint32_t rdLength)
+{
+    return i2c_transfer_priv( SIM_I2C_BUS_SERCOM2, address, NULL, 0, rdData, rdLength );
+}
+
+bool SERCOM2_I2C_Write(uint16_t address, uint8_t* wrData, uint32_t wrLength)
+{
+    return i2c_transfer_priv( SIM_I2C_BUS_SERCOM2, address, wrData, wrLength, NULL, 0 );
+}
+
+bool SERCOM2_I2C_WriteRead(uint16_t address, uint8_t* wrData, uint32_t wrLength, uint8_t* rdData, uint32_t rdLength)
+{
+    return i2c_transfer_priv( SIM_I2C_BUS_SERCOM2, address, wrData, wrLength, rdData, rdLength );
+}
+
+bool SERCOM2_I2C_IsBusy(void)
+{
+    return sim_i2c_is_busy( SIM_I2C_BUS_SERCOM2 );
+}
+
+SERCOM_I2C_ERROR SERCOM2_I2C_ErrorGet(void)
+{
+    return sim_i2c_nacked( SIM_I2C_BUS_SERCOM2 ) ? SERCOM_I2C_ERROR_NAK : SERCOM_I2C_ERROR_NONE;
+}
+
+void SERCOM2_I2C_CallbackRegister(SERCOM_I2C_CALLBACK callback, uintptr_t contextHandle)
+{
+    plib_ctx.i2c_callback[ SIM_I2C_BUS_SERCOM2 ] = callback;
+    plib_ctx.i2c_context[ SIM_I2C_BUS_SERCOM2 ] = contextHandle;
+}
+
+size_t SERCOM3_USART_Write(uint8_t* pWrBuffer, const size_t size )
+{
+    size_t n = size;
+    size_t i;
+
+    // the ring buffer keeps what it has room for and drops the rest
+    if ( n > SERCOM3_USART_WriteFreeBufferCountGet( ) )
+    {
+        n = SERCOM3_USART_WriteFreeBufferCountGet( );
+    }
+
+    if ( plib_ctx.bt_tx_done_ns < sim_time_us( ) * 1000 )
+    {
+        plib_ctx.bt_tx_done_ns = sim_time_us( ) * 1000;
+    }
+    plib_ctx.bt_tx_done_ns += n * SIM_UART_BYTE_NS( plib_ctx.bt_baud );
+
+    if ( plib_ctx.bt_tx_hook != NULL )
+    {
+        for ( i = 0; i < n; i++ )
+        {
+            plib_ctx.bt_tx_hook( pWrBuffer[ i ], plib_ctx.bt_tx_context );
+        }
+    }
+
+    return n;
+}
+
+size_t SERCOM3_USART_WriteCountGet(void)
+{
+    uint64_t now = sim_time_us( ) * 1000;
+    uint64_t byte = SIM_UART_BYTE_NS( plib_ctx.bt_baud );
+
+    // bytes still waiting in the buffer at the line rate
+    if ( plib_ctx.bt_tx_done_ns <= now )
+    {
+        return 0;
+    }
+
+    return ( size_t )( ( plib_ctx.bt_tx_done_ns - now + byte - 1 ) / byte );
+}
+
+size_t SERCOM3_USART_WriteFreeBufferCountGet(void)
+{
+    size_t pending = SERCOM3_USART_WriteCountGet( );
+
+    return ( pending < SIM_BT_TX_BUFFER_SIZE - 1 ) ? ( SIM_BT_TX_BUFFER_SIZE - 1 ) - pending : 0;
+}
+
+bool SERCOM3_USART_SerialSetup( USART_SERIAL_SETUP * serialSetup, uint32_t clkFrequency )
+{
+    if ( ( serialSetup == NULL ) || ( serialSetup->baudRate == 0 ) )
+    {
+        return false;
+    }
+
+    // the plib disables the USART: what was still to go is lost
+    plib_ctx.bt_tx_done_ns = 0;
+    plib_ctx.bt_baud = serialSetup->baudRate;
+
+    return true;
+}
+
+size_t SERCOM3_USART_Read(uint8_t* pRdBuffer, const size_t size)
+{
+    size_t n = 0;
+
+    while ( ( n < size ) && ( plib_ctx.bt_rx_count > 0 ) )
+    {
+        pRdBuffer[ n++ ] = plib_ctx.bt_rx[ plib_ctx.bt_rx_head ];
+        plib_ctx.bt_rx_head = ( plib_ctx.bt_rx_head + 1 ) % SIM_BT_RX_BUFFER_SIZE;
+        plib_ctx.bt_rx_count--;
+    }
+
+    return n;
+}
+
+USART_ERROR SERCOM3_USART_ErrorGet( void )
+{
+    // the DMA keeps up at every rate the module has
+    return USART_ERROR_NONE;
+}
+
+size_t SERCOM3_USART_ReadCountGet(void)
+{
+    return plib_ctx.bt_rx_count;
+}
+
+size_t SERCOM3_USART_ReadFreeBufferCountGet(void)
+{
+    return ( SIM_BT_RX_BUFFER_SIZE - 1 ) - plib_ctx.bt_rx_count;
+}
+
+size_t sim_bt_receive ( const uint8_t *data, size_t len )
+{
+    size_t n = 0;
+    size_t tail;
+
+    // the DMA takes every byte off the DATA register
+    if ( plib_ctx.dmac[ DMAC_CHANNEL_1 ].busy )
+    {
+        for ( n = 0; n < len; n++ )
+        {
+            dmac_beat_priv( DMAC_CHANNEL_1, data[ n ] );
+        }
+        return n;
+    }
+
+    // the ring buffer keeps one slot free, like the Harmony implementation
+    while ( ( n < len ) && ( plib_ctx.bt_rx_count < SIM_BT_RX_BUFFER_SIZE - 1 ) )
+    {
+        tail = ( plib_ctx.bt_rx_head + plib_ctx.bt_rx_count ) % SIM_BT_RX_BUFFER_SIZE;
+        plib_ctx.bt_rx[ tail ] = data[ n++ ];
+        plib_ctx.bt_rx_count++;
+    }
+
+    return n;
+}
+
+uint32_t sim_bt_baud ( )
+{
+    return plib_ctx.bt_baud;
+}
+
+uint64_t sim_bt_tx_done_us ( )
+{
+    uint64_t done = ( plib_ctx.bt_tx_done_ns + 999 ) / 1000;
+
+    return ( done > sim_time_us( ) ) ? done : sim_time_us( );
+}
+
+void sim_bt_set_tx_hook ( SIM_UART_TX_HOOK hook, uintptr_t context )
+{
+    plib_ctx.bt_tx_hook = hook;
+    plib_ctx.bt_tx_context = context;
+}
+
+void sim_console_set_hook ( SIM_UART_TX_HOOK hook, uintptr_t context )
+{
+    plib_ctx.console_hook = hook;
+    plib_ctx.console_context = context;
+}
+
+// ------------------------------------------------------------------------ TCC
+
+void TCC0_PWMStart(void)
+{
+}
+
+void TCC0_PWMStop(void)
+{
+}
+
+bool TCC0_PWM24bitDutySet(TCC0_CHANNEL_NUM channel, uint32_t duty)
+{
+    TCC0_REGS->TCC_CCBUF[ channel ] = duty & 0xFFFFFFU;
+
+    return true;
+}
+
+void TCC1_PWMStart(void)
+{
+}
+
+void TCC1_PWMStop(void)
+{
+}
+
+bool TCC1_PWM24bitDutySet(TCC1_CHANNEL_NUM channel, uint32_t duty)
+{
+    TCC1_REGS->TCC_CCBUF[ channel ] = duty & 0xFFFFFFU;
+
+    return true;
+}
+
+uint8_t sim_led_level ( SIM_LED led )
+{
+    static const volatile uint32_t *const ccbuf[ SIM_LED_COUNT ] =
+    {
+        &sim_tcc1_regs.TCC_CCBUF[ TCC1_CHANNEL0 ],
+        &sim_tcc0_regs.TCC_CCBUF[ TCC0_CHANNEL3 ],
+        &sim_tcc0_regs.TCC_CCBUF[ TCC0_CHANNEL2 ]
+    };
+    uint32_t duty;
+
+    dmac_events_priv( DMAC_CHANNEL_2 + led );
+    duty = *ccbuf[ led ];
+
+    // the LED is active low: full period is off
+    if ( duty >= RGBLED_PERIOD )
+    {
+        return 0;
+    }
+
+    return ( uint8_t )( ( ( RGBLED_PERIOD - duty ) * 255UL ) / RGBLED_PERIOD );
+}
+
+uint64_t sim_led_frames ( )
+{
+    DMAC_CHANNEL channel;
+
+    for ( channel = DMAC_CHANNEL_2; channel <= DMAC_CHANNEL_4; channel++ )
+    {
+        dmac_events_priv( channel );
+    }
+
+    return plib_ctx.led_frames;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static uint64_t rtc_ticks_priv ( uint64_t t_us )
+{
+    return ( ( t_us - plib_ctx.rtc.start_us ) * RTC_FREQ ) / SIM_US_PER_S;
+}
+
+static uint64_t rtc_events_priv ( )
+{
+    if ( !plib_ctx.rtc.running )
+    {
+        return 0;
+    }
+
+    return rtc_ticks_priv( sim_time_us( ) ) >> DMAC_EVENT_SHIFT;
+}
+
+static uint64_t rtc_tick_time_priv ( uint64_t tick )
+{
+    return plib_ctx.rtc.start_us + ( tick * SIM_US_PER_S + RTC_FREQ - 1 ) / RTC_FREQ;
+}
+
+static uint32_t rtc_count_priv ( )
+{
+    sim_rtc_t *rtc = &plib_ctx.rtc;
+
+    if ( !rtc->running )
+    {
+        return rtc->count_ref;
+    }
+
+    return rtc->count_ref + ( uint32_t )( rtc_ticks_priv( sim_time_us( ) ) - rtc->tick_ref );
+}
+
+static void rtc_next_ticks_priv ( uint64_t *t0, uint64_t *t1 )
+{
+    sim_rtc_t *rtc = &plib_ctx.rtc;
+
+    // the counter clears on the cycle after matching COMP0
+    *t0 = rtc->tick_ref + ( uint32_t )( rtc->comp0 - rtc->count_ref ) + 1;
+
+    // COMP1 only matches if the counter gets there before clearing
+    *t1 = rtc->tick_ref + ( uint32_t )( rtc->comp1 - rtc->count_ref ) + 1;
+    if ( *t1 > *t0 )
+    {
+        *t1 = SIM_TIME_NEVER;
+    }
+}
+
+static void rtc_dispatch_priv ( )
+{
+    sim_rtc_t *rtc = &plib_ctx.rtc;
+    RTC_TIMER32_INT_MASK cause;
+
+    if ( !rtc->pending || !plib_ctx.irq_enabled )
+    {
+        return;
+    }
+
+    // RTC_InterruptHandler() passes and clears all the flags
+    rtc->pending = false;
+    cause = rtc->intflag;
+    rtc->intflag = 0;
+
+    plib_ctx.irq_enabled = false;
+    if ( rtc->callback != NULL )
+    {
+        rtc->callback( cause, rtc->context );
+    }
+    plib_ctx.irq_enabled = true;
+}
+
+static void dmac_complete_priv ( uintptr_t context )
+{
+    sim_dmac_t *ch = &plib_ctx.dmac[ context ];
+    const uint8_t *src = ( const uint8_t * )( ch->desc.DMAC_SRCADDR - ch->desc.DMAC_BTCNT );
+    uint16_t i;
+
+    // channel 0 is the beat-per-byte transfer to the SERCOM5 DATA register,
+    // echoed as the block ends
+    if ( ( ch->desc.DMAC_DSTADDR == ( uintptr_t )&SERCOM5_REGS->USART_INT.SERCOM_DATA ) &&
+         ( plib_ctx.console_hook != NULL ) )
+    {
+        for ( i = 0; i < ch->desc.DMAC_BTCNT; i++ )
+        {
+            plib_ctx.console_hook( src[ i ], plib_ctx.console_context );
+        }
+    }
+
+    ch->busy = false;
+
+    if ( ch->callback != NULL )
+    {
+        ch->callback( DMAC_TRANSFER_EVENT_COMPLETE, ch->context );
+    }
+}
+
+static void dmac_beat_priv ( DMAC_CHANNEL channel, uint8_t data )
+{
+    sim_dmac_t *ch = &plib_ctx.dmac[ channel ];
+    uint8_t *dst = ( uint8_t * )( ch->desc.DMAC_DSTADDR - ch->desc.DMAC_BTCNT );
+
+    dst[ ch->count++ ] = data;
+    if ( ch->count < ch->desc.DMAC_BTCNT )
+    {
+        return;
+    }
+
+    // block done: the next descriptor is fetched, or the channel stops
+    ch->count = 0;
+    ch->complete = true;
+    if ( ch->desc.DMAC_DESCADDR != 0 )
+    {
+        ch->desc = *( dmac_descriptor_registers_t * )ch->desc.DMAC_DESCADDR;
+    }
+    else
+    {
+        ch->busy = false;
+    }
+
+    dmac_dispatch_priv( );
+}
+
+static void dmac_dispatch_priv ( )
+{
+    sim_dmac_t *ch = &plib_ctx.dmac[ DMAC_CHANNEL_1 ];
+
+    if ( !ch->complete || !plib_ctx.irq_enabled )
+    {
+        return;
+    }
+
+    // DMAC_1_InterruptHandler() clears the flag before the callback
+    ch->complete = false;
+
+    plib_ctx.irq_enabled = false;
+    if ( ch->callback != NULL )
+    {
+        ch->callback( DMAC_TRANSFER_EVENT_COMPLETE, ch->context );
+    }
+    plib_ctx.irq_enabled = true;
+}
+
+static void dmac_events_priv ( DMAC_CHANNEL channel )
+{
+    sim_dmac_t *ch = &plib_ctx.dmac[ channel ];
+    uint64_t events = rtc_events_priv( );
+    const uint32_t *src;
+
+    if ( channel < DMAC_CHANNEL_2 )
+    {
+        return;
+    }
+
+    // the events since the last look, nothing wakes the core for them:
+    // a word beat each, no interrupt at the end of the block
+    while ( ch->busy && ( ch->events < events ) )
+    {
+        src = ( const uint32_t * )( ch->desc.DMAC_SRCADDR - ch->desc.DMAC_BTCNT * sizeof( uint32_t ) );
+        *( volatile uint32_t * )ch->desc.DMAC_DSTADDR = src[ ch->count++ ];
+        ch->events++;
+        plib_ctx.led_frames += ( channel == DMAC_CHANNEL_2 );
+
+        if ( ch->count < ch->desc.DMAC_BTCNT )
+        {
+            continue;
+        }
+
+        if ( ch->desc.DMAC_DESCADDR == 0 )
+        {
+            // the channel stops, its write-back keeps the finished block
+            ch->busy = false;
+            break;
+        }
+        ch->count = 0;
+        ch->desc = *( dmac_descriptor_registers_t * )ch->desc.DMAC_DESCADDR;
+    }
+    ch->events = events;
+}
+
+static bool i2c_transfer_priv ( SIM_I2C_BUS bus, uint16_t address, uint8_t *wr_data, uint32_t wr_len,
+                               uint8_t *rd_data, uint32_t rd_len )
+{
+    if ( !sim_i2c_transfer( bus, address, wr_data, wr_len, rd_data, rd_len ) )
+    {
+        return false;
+    }
+
+    // the interrupt after the STOP, whether the transfer was acknowledged or not
+    if ( plib_ctx.i2c_callback[ bus ] != NULL )
+    {
+        sim_schedule( sim_i2c_stop_us( ), i2c_complete_priv, ( uintptr_t )bus );
+    }
+
+    return true;
+}
+
+static void i2c_complete_priv ( uintptr_t context )
+{
+    SIM_I2C_BUS bus = ( SIM_I2C_BUS )context;
+
+    if ( plib_ctx.i2c_callback[ bus ] != NULL )
+    {
+        plib_ctx.i2c_callback[ bus ]( plib_ctx.i2c_context[ bus ] );
+    }
+}
+
+static void flash_priv ( )
+{
+    if ( !plib_ctx.flash_ready )
+    {
+        memset( plib_ctx.flash, 0xFF, sizeof( plib_ctx.flash ) );
+        plib_ctx.flash_ready = true;
+    }
+}
+
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,155 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains the host side of the simulated peripherals.
+ *
+ * The application sees the plib API declared in include/definitions.h; the
+ * functions below are used by the kernel, the plant and the scenarios to
+ * observe the outputs and drive the inputs of the board.
+ *
+ * \addtogroup sim_plib Simulated Peripherals
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef SIM_PLIB_H
+#define SIM_PLIB_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "definitions.h"
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+#define SIM_UART_BAUD               115200
+#define SIM_UART_BYTE_US            ( ( 10ULL * 1000000ULL ) / SIM_UART_BAUD )
+#define SIM_UART_BYTE_NS(baud)      ( ( 10ULL * 1000000000ULL ) / ( baud ) )
+
+/* Same size as the SERCOM3 ring buffers generated by Harmony */
+#define SIM_BT_RX_BUFFER_SIZE       128
+#define SIM_BT_TX_BUFFER_SIZE       128
+
+/** \} */ // End group macro
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup type Types
+ * \{
+ */
+
+typedef void ( *SIM_UART_TX_HOOK )( uint8_t data, uintptr_t context );
+
+typedef enum
+{
+    SIM_LED_RED = 0,
+    SIM_LED_GREEN,
+    SIM_LED_BLUE,
+    SIM_LED_COUNT
+
+} SIM_LED;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Input pin function.
+ *
+ * @param pin          Pin configured as input.
+ * @param level        Level applied by the outside world.
+ */
+void sim_port_drive ( SIM_PIN pin, bool level );
+
+/**
+ * @brief RTC next event function.
+ *
+ * @returns Time of the next RTC compare match, SIM_TIME_NEVER if stopped.
+ */
+uint64_t sim_rtc_next_us ( );
+
+/**
+ * @brief RTC event function.
+ *
+ * @description Called by the kernel at the time returned by sim_rtc_next_us():
+ * it updates the counter and flags and runs the interrupt handler.
+ */
+void sim_rtc_expire ( );
+
+/**
+ * @brief Bluetooth receive function.
+ *
+ * @param data         Bytes sent by the remote device.
+ * @param len          Number of bytes.
+ *
+ * @returns Number of bytes stored in the SERCOM3 receive buffer, all of
+ * them once the receive DMA runs.
+ */
+size_t sim_bt_receive ( const uint8_t *data, size_t len );
+
+/**
+ * @brief Bluetooth rate function.
+ *
+ * @returns Rate SERCOM3 was last set to, SIM_UART_BAUD from reset.
+ */
+uint32_t sim_bt_baud ( );
+
+/**
+ * @brief Bluetooth transmit end function.
+ *
+ * @returns Time the last byte written to SERCOM3 is on the line, now if
+ * the buffer is empty.
+ */
+uint64_t sim_bt_tx_done_us ( );
+
+/**
+ * @brief Bluetooth transmit hook.
+ *
+ * @param hook         Function called for every byte sent to the RN-42.
+ * @param context      Value passed to the hook.
+ */
+void sim_bt_set_tx_hook ( SIM_UART_TX_HOOK hook, uintptr_t context );
+
+/**
+ * @brief Debug console function.
+ *
+ * @param hook         Function called for every byte sent on SERCOM5, NULL
+ *                     to discard the debug output.
+ * @param context      Value passed to the hook.
+ */
+void sim_console_set_hook ( SIM_UART_TX_HOOK hook, uintptr_t context );
+
+/**
+ * @brief RGB LED function.
+ *
+ * @param led          Color component.
+ *
+ * @returns Brightness in 0..255, decoded from the TCC duty cycle.
+ */
+uint8_t sim_led_level ( SIM_LED led );
+
+/**
+ * @brief RGB LED pattern function.
+ *
+ * @returns Frames the DMA has moved to the TCC so far.
+ */
+uint64_t sim_led_frames ( );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _SIM_PLIB_H_
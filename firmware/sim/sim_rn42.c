@@ -0,0 +1,248 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "sim.h"
+#include "sim_rn42.h"
+
+/* Consecutive '$' that enter command mode */
+#define RN42_ESCAPE_COUNT           3
+
+/**
+ * @brief Model ctx object definition.
+ */
+typedef struct
+{
+    SIM_UART_TX_HOOK hook;
+    uintptr_t context;
+    bool silent;
+    bool noise;
+    uint32_t line_bytes;
+
+    // rate, the one a U command switches to after its reply
+    uint32_t baud;
+    uint32_t next_baud;
+
+    bool command_mode;
+    // '$' held back in data mode, they may be the escape sequence
+    uint8_t dollars;
+    char line[ SIM_RN42_LINE_LENGTH ];
+    uint8_t line_length;
+
+    uint32_t commands;
+
+} sim_rn42_t;
+
+static sim_rn42_t rn42_ctx;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static void tx_priv ( uint8_t data, uintptr_t context );
+static uint8_t line_priv ( uint8_t data );
+static uint32_t rate_priv ( const char *text );
+static void data_priv ( uint8_t data );
+static void command_priv ( uint8_t data );
+static void answer_priv ( const char *reply );
+static void reply_priv ( uintptr_t context );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void sim_rn42_attach ( SIM_UART_TX_HOOK hook, uintptr_t context )
+{
+    memset( &rn42_ctx, 0, sizeof( rn42_ctx ) );
+    rn42_ctx.hook = hook;
+    rn42_ctx.context = context;
+    rn42_ctx.baud = SIM_UART_BAUD;
+
+    sim_bt_set_tx_hook( tx_priv, 0 );
+}
+
+void sim_rn42_set_silent ( bool silent )
+{
+    rn42_ctx.silent = silent;
+}
+
+void sim_rn42_set_noise ( bool noise )
+{
+    rn42_ctx.noise = noise;
+}
+
+void sim_rn42_receive ( const uint8_t *data, size_t len )
+{
+    uint8_t c;
+    size_t i;
+
+    if ( rn42_ctx.command_mode )
+    {
+        return;
+    }
+
+    for ( i = 0; i < len; i++ )
+    {
+        c = line_priv( data[ i ] );
+        sim_bt_receive( &c, 1 );
+    }
+}
+
+uint32_t sim_rn42_baud ( )
+{
+    return rn42_ctx.baud;
+}
+
+uint32_t sim_rn42_commands ( )
+{
+    return rn42_ctx.commands;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void tx_priv ( uint8_t data, uintptr_t context )
+{
+    data = line_priv( data );
+
+    if ( rn42_ctx.command_mode )
+    {
+        command_priv( data );
+    }
+    else
+    {
+        data_priv( data );
+    }
+}
+
+static void data_priv ( uint8_t data )
+{
+    if ( data == '$' )
+    {
+        if ( ++rn42_ctx.dollars == RN42_ESCAPE_COUNT )
+        {
+            rn42_ctx.dollars = 0;
+            if ( !rn42_ctx.silent )
+            {
+                rn42_ctx.command_mode = true;
+                rn42_ctx.line_length = 0;
+                answer_priv( "CMD\r\n" );
+            }
+        }
+        return;
+    }
+
+    // not an escape after all, the held back ones go through first
+    while ( rn42_ctx.dollars > 0 )
+    {
+        rn42_ctx.dollars--;
+        if ( rn42_ctx.hook != NULL )
+        {
+            rn42_ctx.hook( '$', rn42_ctx.context );
+        }
+    }
+
+    if ( rn42_ctx.hook != NULL )
+    {
+        rn42_ctx.hook( data, rn42_ctx.context );
+    }
+}
+
+static void command_priv ( uint8_t data )
+{
+    if ( data != '\r' )
+    {
+        if ( rn42_ctx.line_length < SIM_RN42_LINE_LENGTH - 1 )
+        {
+            rn42_ctx.line[ rn42_ctx.line_length++ ] = ( char )data;
+        }
+        return;
+    }
+
+    rn42_ctx.line[ rn42_ctx.line_length ] = '\0';
+    rn42_ctx.line_length = 0;
+
+    if ( strcmp( rn42_ctx.line, "---" ) == 0 )
+    {
+        rn42_ctx.command_mode = false;
+        answer_priv( "END\r\n" );
+    }
+    else if ( ( strncmp( rn42_ctx.line, "U,", 2 ) == 0 ) && ( rate_priv( rn42_ctx.line + 2 ) != 0 ) )
+    {
+        rn42_ctx.next_baud = rate_priv( rn42_ctx.line + 2 );
+        answer_priv( "AOK\r\n" );
+    }
+    else if ( ( strlen( rn42_ctx.line ) > 2 ) && ( rn42_ctx.line[ 0 ] == 'S' ) && ( rn42_ctx.line[ 2 ] == ',' ) )
+    {
+        answer_priv( "AOK\r\n" );
+    }
+    else
+    {
+        answer_priv( "?\r\n" );
+    }
+}
+
+static void answer_priv ( const char *reply )
+{
+    rn42_ctx.commands++;
+    sim_schedule( sim_time_us( ) + SIM_RN42_REPLY_US, reply_priv, ( uintptr_t )reply );
+}
+
+static void reply_priv ( uintptr_t context )
+{
+    const char *reply = ( const char * )context;
+    uint8_t c;
+
+    while ( *reply != '\0' )
+    {
+        c = line_priv( ( uint8_t )*reply++ );
+        sim_bt_receive( &c, 1 );
+    }
+
+    if ( rn42_ctx.next_baud != 0 )
+    {
+        rn42_ctx.baud = rn42_ctx.next_baud;
+        rn42_ctx.next_baud = 0;
+        rn42_ctx.command_mode = false;
+    }
+}
+
+static uint8_t line_priv ( uint8_t data )
+{
+    // sampled at the wrong rate, the byte is garbage
+    if ( sim_bt_baud( ) != rn42_ctx.baud )
+    {
+        return ( uint8_t )( data * 7 + 0x5A );
+    }
+
+    if ( rn42_ctx.noise && ( rn42_ctx.baud > SIM_UART_BAUD ) && ( ++rn42_ctx.line_bytes % SIM_RN42_NOISE_BYTES == 0 ) )
+    {
+        return data ^ 0x08;
+    }
+
+    return data;
+}
+
+static uint32_t rate_priv ( const char *text )
+{
+    // "115K,N" as the module names its rates above 57600, plain below
+    char *end;
+    unsigned long k = strtoul( text, &end, 10 );
+
+    if ( ( *end != 'K' ) && ( *end != 'k' ) )
+    {
+        return ( ( *end == ',' ) && ( k >= 1200 ) ) ? ( uint32_t )k : 0;
+    }
+
+    switch ( k )
+    {
+        case 115: return 115200;
+        case 230: return 230400;
+        case 460: return 460800;
+        case 921: return 921600;
+        default: return 0;
+    }
+}
+
+// ------------------------------------------------------------------------- END
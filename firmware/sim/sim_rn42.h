@@ -0,0 +1,105 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the RN-42 Bluetooth module model.
+ *
+ * The model sits on the SERCOM3 transmit line of the BlueSMiRF. In data
+ * mode the bytes go on to the remote device; "$$$" enters command mode,
+ * where the lines ending in CR are answered as the module does: CMD on
+ * entering, AOK to the set commands, END to "---", which goes back to data
+ * mode, and ? to anything else. The answers come back on the receive line
+ * after SIM_RN42_REPLY_US. "U,<rate>,N" is answered AOK at the old rate,
+ * then the module is at the new one and back in data mode.
+ *
+ * The bytes cross the line intact only while SERCOM3 is at the rate of the
+ * module. With the noise fault one byte in SIM_RN42_NOISE_BYTES is hit
+ * above SIM_UART_BAUD, as a long or loaded line would.
+ *
+ * \addtogroup sim_rn42 RN-42 Model
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef SIM_RN42_H
+#define SIM_RN42_H
+
+#include <stdbool.h>
+#include "sim_plib.h"
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+#define SIM_RN42_REPLY_US           5000
+#define SIM_RN42_LINE_LENGTH        32
+#define SIM_RN42_NOISE_BYTES        200
+
+/** \} */ // End group macro
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Attach function.
+ *
+ * @param hook         Function called for every byte sent to the remote
+ *                     device in data mode.
+ * @param context      Value passed to the hook.
+ */
+void sim_rn42_attach ( SIM_UART_TX_HOOK hook, uintptr_t context );
+
+/**
+ * @brief Silent function.
+ *
+ * @param silent       true for a module that answers nothing, command
+ *                     mode included.
+ */
+void sim_rn42_set_silent ( bool silent );
+
+/**
+ * @brief Noise function.
+ *
+ * @param noise        true to corrupt bytes on the line above SIM_UART_BAUD.
+ */
+void sim_rn42_set_noise ( bool noise );
+
+/**
+ * @brief Receive function.
+ *
+ * @param data         Bytes sent by the remote device.
+ * @param len          Number of bytes.
+ *
+ * @description The bytes go on to SERCOM3 in data mode, through the line.
+ */
+void sim_rn42_receive ( const uint8_t *data, size_t len );
+
+/**
+ * @brief Rate function.
+ *
+ * @returns UART rate of the module.
+ */
+uint32_t sim_rn42_baud ( );
+
+/**
+ * @brief Commands function.
+ *
+ * @returns Number of command lines answered, "$$$" included.
+ */
+uint32_t sim_rn42_commands ( );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _SIM_RN42_H_
@@ -0,0 +1,630 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * Host benchmark of one control tick of the main loop.
+ *
+ * Days of HDC1080 temperature and humidity codes (5.5 C with a 1 C swing,
+ * 70 %RH with a slow drift, the noise of the readings) go through what the
+ * main loop does with every sample, with the mains on and the PID mode
+ * selected: conversion, sensor filters, rollup, online model, anomaly
+ * detectors, controller, LED, the status frame fields sent to the app,
+ * sampler and the console line.
+ *
+ * It is timed twice. The float path is the loop as it was before the
+ * fixed-point temperature: the readings converted in float, and the PID,
+ * the anomaly detectors and the sampler as they were, kept here as
+ * reference copies. The fixed path runs the firmware objects in
+ * CentiCelsius/DeciCelsius. Both call the same ThermalModel, RGBLed and
+ * rollup functions; the float path hands them its temperature converted.
+ * The two are then compared tick by tick.
+ *
+ * The value sent to the app is rounded to 0.1 C now, it was truncated: the
+ * "sent" count is the ticks where the two differ by that, not an error.
+ *
+ * The signal does not follow the cell, so the cooling failure detector
+ * fires for much of the run and the paths differ around the edges of its
+ * alerts; the cell decisions differ where the PID output sits on a window
+ * boundary. Every tick is a sample: the sampler period is worked out but
+ * not acted on, so both paths do the same number of ticks. Host cycles are only a
+ * relative measure: the float path promotes to double in places, which
+ * the host does in hardware and the Cortex-M4F in software.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "filter.h"
+#include "temphum11.h"
+#include "celsius.h"
+#include "rollup.h"
+#include "rgbled.h"
+#include "tempcontrol.h"
+#include "anomaly.h"
+#include "sampler.h"
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#define BENCH_CYCLES( )             __rdtsc( )
+#else
+#define BENCH_CYCLES( )             0ULL
+#endif
+
+#define BENCH_TICKS                 2000000
+#define BENCH_TICK_MS               500
+#define BENCH_NOISE_C               0.01
+#define BENCH_NOISE_RH              0.05
+#define BENCH_SETPOINT              50          // 0.1 C, as sent by the app
+
+/* The loop as it was, before the fixed-point temperature */
+#define BENCH_FLOAT_KP              0.35f
+#define BENCH_FLOAT_TI_S            900.0f
+#define BENCH_FLOAT_TD_S            60.0f
+#define BENCH_FLOAT_DERIVATIVE_N    8.0f
+
+/* What one tick leaves behind, to compare the two paths */
+typedef struct
+{
+    int16_t rollup;
+    int16_t sent;
+    uint8_t hum;
+    uint8_t cell;
+    uint8_t alerts;
+    uint8_t red;
+    uint8_t blue;
+
+} bench_tick_t;
+
+/* The PID of TempControl as it was, window and dwell included */
+typedef struct
+{
+    float integral;
+    float derivative;
+    float prev;
+    bool primed;
+    uint32_t window_elapsed_ms;
+    uint32_t window_on_ms;
+    uint32_t since_switch_ms;
+    bool cell;
+
+} float_control_t;
+
+/* AnomalyDetector as it was */
+typedef struct
+{
+    uint8_t alerts;
+    bool primed;
+    float cusum;
+    uint32_t model_samples;
+    uint32_t cell_on_ms;
+    float t;
+    float ts;
+    float t_min;
+    float t_max;
+    float hum_fast;
+    float hum_slow;
+    float hum_base;
+    float h;
+    uint32_t same_ms;
+
+} float_anomaly_t;
+
+/* The rate and period of AdaptiveSampler as they were */
+typedef struct
+{
+    bool primed;
+    float ts;
+    float rate;
+    bool cell;
+    uint32_t settle_ms;
+    uint32_t period_ms;
+
+} float_sampler_t;
+
+/* Everything one path keeps from tick to tick */
+typedef struct
+{
+    filter_t temp_filter;
+    filter_t hum_filter;
+    RGBLed led;
+    bool cell;
+    uint8_t alerts;
+    char line[ 128 ];
+
+    // float path
+    float_control_t control;
+    float_anomaly_t anomaly;
+    float_sampler_t sampler;
+    ThermalModel model;
+
+    // fixed path, the firmware objects
+    TempControl temp_ctrl;
+    AnomalyDetector detector;
+    AdaptiveSampler adaptive;
+
+} bench_path_t;
+
+static const filter_cfg_t bench_filter_cfg = { 1, 3, FILTER_SMOOTH_EMA, 1, { 0 } };
+
+static uint16_t *bench_temp_codes;
+static uint16_t *bench_hum_codes;
+
+// both paths drive the one LED and its DMA channels, one after the other
+static bench_path_t bench_float;
+static bench_path_t bench_fixed;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static void signal_priv ( );
+static double gauss_priv ( );
+static void path_init_priv ( bench_path_t *p );
+static bool float_tick_priv ( bench_path_t *p, uint32_t i, bench_tick_t *out );
+static bool fixed_tick_priv ( bench_path_t *p, uint32_t i, bench_tick_t *out );
+static bool float_control_priv ( float_control_t *c, float t, float sp, uint32_t dt_ms );
+static void float_anomaly_priv ( float_anomaly_t *a, float t, float h, bool cell, ThermalModel &model,
+                                 uint32_t dt_ms );
+static void float_sampler_priv ( float_sampler_t *s, float t, bool cell, bool fast, uint32_t dt_ms );
+static char *centi_str_priv ( char *buf, int32_t v );
+static void time_priv ( const char *name, bench_path_t *p,
+                        bool ( *tick )( bench_path_t *, uint32_t, bench_tick_t * ), bench_tick_t *outs );
+
+// -------------------------------------------------------------------- MAIN
+
+int main ( void )
+{
+    bench_tick_t *float_outs;
+    bench_tick_t *fixed_outs;
+    uint32_t mismatch[ 5 ] = { 0, 0, 0, 0, 0 };
+    uint32_t i;
+
+    bench_temp_codes = ( uint16_t * )malloc( BENCH_TICKS * sizeof( uint16_t ) );
+    bench_hum_codes = ( uint16_t * )malloc( BENCH_TICKS * sizeof( uint16_t ) );
+    float_outs = ( bench_tick_t * )calloc( BENCH_TICKS, sizeof( bench_tick_t ) );
+    fixed_outs = ( bench_tick_t * )calloc( BENCH_TICKS, sizeof( bench_tick_t ) );
+    if ( !bench_temp_codes || !bench_hum_codes || !float_outs || !fixed_outs )
+    {
+        return EXIT_FAILURE;
+    }
+
+    signal_priv( );
+    path_init_priv( &bench_float );
+    path_init_priv( &bench_fixed );
+
+    printf( "%u ticks of %u ms, setpoint %.1f C, PID\n\n", BENCH_TICKS, BENCH_TICK_MS, BENCH_SETPOINT / 10.0 );
+    printf( "%-18s %10s %10s\n", "path", "ns/tick", "cyc/tick" );
+
+    time_priv( "float", &bench_float, float_tick_priv, float_outs );
+    time_priv( "fixed", &bench_fixed, fixed_tick_priv, fixed_outs );
+
+    for ( i = 0; i < BENCH_TICKS; i++ )
+    {
+        const bench_tick_t *a = &float_outs[ i ];
+        const bench_tick_t *b = &fixed_outs[ i ];
+
+        mismatch[ 0 ] += ( a->rollup != b->rollup );
+        mismatch[ 1 ] += ( a->cell != b->cell );
+        mismatch[ 2 ] += ( a->alerts != b->alerts );
+        mismatch[ 3 ] += ( a->red != b->red ) || ( a->blue != b->blue );
+        mismatch[ 4 ] += ( a->sent != b->sent ) || ( a->hum != b->hum );
+    }
+
+    printf( "\nticks that differ: rollup %u, cell %u, alerts %u, led %u, sent %u (rounded, was truncated)\n",
+            mismatch[ 0 ], mismatch[ 1 ], mismatch[ 2 ], mismatch[ 3 ], mismatch[ 4 ] );
+
+    free( fixed_outs );
+    free( float_outs );
+    free( bench_hum_codes );
+    free( bench_temp_codes );
+
+    return EXIT_SUCCESS;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void signal_priv ( )
+{
+    double t;
+    double c;
+    double h;
+    long code;
+    uint32_t i;
+
+    srand( 1080 );
+
+    for ( i = 0; i < BENCH_TICKS; i++ )
+    {
+        t = i * BENCH_TICK_MS / 1000.0;
+
+        // 5.5 C with a 1 C swing every 20 minutes, across the hysteresis band
+        c = 5.5 + 1.0 * sin( 2.0 * M_PI * t / 1200.0 ) + BENCH_NOISE_C * gauss_priv( );
+        code = lround( ( c + 40.0 ) * 65536.0 / 165.0 );
+        bench_temp_codes[ i ] = ( uint16_t )( ( code < 0 ) ? 0 : ( ( code > 0xFFFF ) ? 0xFFFF : code ) );
+
+        // 70 %RH drifting by 3 %RH over 3 hours, at the 11-bit resolution
+        h = 70.0 + 3.0 * sin( 2.0 * M_PI * t / 10800.0 ) + BENCH_NOISE_RH * gauss_priv( );
+        code = lround( h * 65536.0 / 100.0 ) & ~0x1F;
+        bench_hum_codes[ i ] = ( uint16_t )( ( code < 0 ) ? 0 : ( ( code > 0xFFFF ) ? 0xFFE0 : code ) );
+    }
+}
+
+static double gauss_priv ( )
+{
+    double u1 = ( rand( ) + 1.0 ) / ( RAND_MAX + 2.0 );
+    double u2 = ( rand( ) + 1.0 ) / ( RAND_MAX + 2.0 );
+
+    return sqrt( -2.0 * log( u1 ) ) * cos( 2.0 * M_PI * u2 );
+}
+
+static void path_init_priv ( bench_path_t *p )
+{
+    filter_init( &p->temp_filter, &bench_filter_cfg );
+    filter_init( &p->hum_filter, &bench_filter_cfg );
+    p->led.init( );
+    p->led.setLoads( true, false, false );
+    p->cell = false;
+    p->alerts = Alert_None;
+
+    memset( &p->control, 0, sizeof( p->control ) );
+    p->control.window_elapsed_ms = TEMPCONTROL_WINDOW_S * 1000UL;
+    // TempControl::reset() starts the dwell from the switch as it is
+    p->control.since_switch_ms = 0;
+    memset( &p->anomaly, 0, sizeof( p->anomaly ) );
+    memset( &p->sampler, 0, sizeof( p->sampler ) );
+    p->sampler.settle_ms = SAMPLER_SETTLE_MS;
+    p->sampler.period_ms = BENCH_TICK_MS;
+
+    p->temp_ctrl.setMode( Control_PID, p->cell );
+    p->adaptive.init( BENCH_TICK_MS );
+}
+
+static bool float_tick_priv ( bench_path_t *p, uint32_t i, bench_tick_t *out )
+{
+    // temphum11_get_temperature() and temphum11_get_humidity() as they were
+    float t_raw = ( float )( bench_temp_codes[ i ] / 65536.0 ) * 165.0 - 40;
+    float h_raw = ( float )( bench_hum_codes[ i ] / 65536.0 ) * 100.0;
+    int32_t t_out;
+    int32_t h_out;
+    bool ready;
+    uint8_t green;
+
+    ready = filter_push( &p->hum_filter, ( int32_t )lroundf( h_raw * 100.0f ), &h_out );
+    ready &= filter_push( &p->temp_filter, ( int32_t )lroundf( t_raw * 100.0f ), &t_out );
+    if ( !ready )
+    {
+        return false;
+    }
+
+    float h = ( float )h_out / 100.0f;
+    float t = ( float )t_out / 100.0f;
+    float sp = ( float )BENCH_SETPOINT / 10.0f;
+
+    rollup_add( i * BENCH_TICK_MS / 1000, ( int16_t )( t * 100.0f ), p->cell, p->cell, BENCH_TICK_MS );
+
+    p->model.observe( CentiCelsius::fromFloat( t ), p->cell, BENCH_TICK_MS );
+    float_anomaly_priv( &p->anomaly, t_raw, h_raw, p->cell, p->model, BENCH_TICK_MS );
+    p->alerts = p->anomaly.alerts;
+
+    p->cell = float_control_priv( &p->control, t, sp, BENCH_TICK_MS );
+
+    p->led.updateFromTemp( CentiCelsius::fromFloat( t ), DeciCelsius::fromFloat( sp ) );
+    p->led.updateFromAlerts( p->alerts );
+
+    // setTemperature( int ) and setHumidity( int ) as they were
+    out->sent = ( int16_t )( int )( t * 10 );
+    out->hum = ( uint8_t )( int )h;
+
+    float_sampler_priv( &p->sampler, t, p->cell, p->alerts != Alert_None, BENCH_TICK_MS );
+
+    sprintf( p->line, "Temp=%f, Hum=%f, SW=%d, Conn=%d, Mains=%d, Fan=%d, Cell=%d, SP: %f\r\n", t, h, 1, 0, 1,
+             p->cell, p->cell, sp );
+
+    out->rollup = ( int16_t )( t * 100.0f );
+    out->cell = p->cell;
+    out->alerts = p->alerts;
+    p->led.color( out->red, green, out->blue );
+
+    return true;
+}
+
+static bool fixed_tick_priv ( bench_path_t *p, uint32_t i, bench_tick_t *out )
+{
+    int32_t t_raw = temphum11_temperature_centi( bench_temp_codes[ i ] );
+    int32_t h_raw = temphum11_humidity_centi( bench_hum_codes[ i ] );
+    DeciCelsius sp = DeciCelsius::fromRaw( BENCH_SETPOINT );
+    int32_t t_out;
+    int32_t h_out;
+    bool ready;
+    char t_str[ 16 ];
+    char h_str[ 16 ];
+    char sp_str[ 16 ];
+    uint8_t green;
+
+    ready = filter_push( &p->hum_filter, h_raw, &h_out );
+    ready &= filter_push( &p->temp_filter, t_raw, &t_out );
+    if ( !ready )
+    {
+        return false;
+    }
+
+    CentiCelsius tc = CentiCelsius::fromRaw( t_out );
+
+    rollup_add( i * BENCH_TICK_MS / 1000, ( int16_t )tc.raw( ), p->cell, p->cell, BENCH_TICK_MS );
+
+    p->temp_ctrl.observe( tc, p->cell, BENCH_TICK_MS );
+    p->detector.update( CentiCelsius::fromRaw( t_raw ), h_raw, p->cell, false, p->temp_ctrl.model( ), BENCH_TICK_MS );
+    p->alerts = p->detector.alerts( );
+
+    p->cell = p->temp_ctrl.update( tc, sp, BENCH_TICK_MS );
+
+    p->led.updateFromTemp( tc, sp );
+    p->led.updateFromAlerts( p->alerts );
+
+    out->sent = ( int16_t )tc.to<10>( ).raw( );
+    out->hum = ( uint8_t )( h_out / 100 );
+
+    p->adaptive.update( tc, p->cell, p->cell, p->alerts != Alert_None );
+
+    snprintf( p->line, sizeof( p->line ), "Temp=%s, Hum=%s, SW=%d, Conn=%d, Mains=%d, Fan=%d, Cell=%d, SP: %s\r\n",
+              centi_str_priv( t_str, tc.raw( ) ), centi_str_priv( h_str, h_out ), 1, 0, 1, p->cell, p->cell,
+              centi_str_priv( sp_str, sp.to<100>( ).raw( ) ) );
+
+    out->rollup = ( int16_t )tc.raw( );
+    out->cell = p->cell;
+    out->alerts = p->alerts;
+    p->led.color( out->red, green, out->blue );
+
+    return true;
+}
+
+static bool float_control_priv ( float_control_t *c, float t, float sp, uint32_t dt_ms )
+{
+    float dt = ( float )dt_ms / 1000.0f;
+    float e = t - sp;
+    float p = BENCH_FLOAT_KP * e;
+    float d = 0.0f;
+    float u;
+    uint32_t window_ms = TEMPCONTROL_WINDOW_S * 1000UL;
+    uint32_t min_on_ms = TEMPCONTROL_MIN_ON_S * 1000UL;
+    uint32_t min_off_ms = TEMPCONTROL_MIN_OFF_S * 1000UL;
+
+    if ( c->primed )
+    {
+        float alpha = BENCH_FLOAT_TD_S / ( BENCH_FLOAT_TD_S + BENCH_FLOAT_DERIVATIVE_N * dt );
+        c->derivative = alpha * c->derivative + ( 1.0f - alpha ) * ( t - c->prev ) / dt;
+        d = BENCH_FLOAT_KP * BENCH_FLOAT_TD_S * c->derivative;
+    }
+    c->prev = t;
+    c->primed = true;
+
+    u = p + c->integral + d;
+    if ( ( u < 1.0f || e < 0.0f ) && ( u > 0.0f || e > 0.0f ) )
+    {
+        c->integral += BENCH_FLOAT_KP * e * dt / BENCH_FLOAT_TI_S;
+        c->integral = ( c->integral > 1.0f ) ? 1.0f : ( ( c->integral < 0.0f ) ? 0.0f : c->integral );
+    }
+    u = p + c->integral + d;
+    u = ( u > 1.0f ) ? 1.0f : ( ( u < 0.0f ) ? 0.0f : u );
+
+    if ( c->window_elapsed_ms >= window_ms )
+    {
+        uint32_t on = ( uint32_t )( u * ( float )window_ms );
+
+        if ( on < min_on_ms )
+        {
+            on = ( on < min_on_ms / 2 ) ? 0 : min_on_ms;
+        }
+        else if ( window_ms - on < min_off_ms )
+        {
+            on = ( window_ms - on < min_off_ms / 2 ) ? window_ms : window_ms - min_off_ms;
+        }
+        c->window_elapsed_ms = 0;
+        c->window_on_ms = on;
+    }
+
+    bool on = c->window_elapsed_ms < c->window_on_ms;
+    if ( on != c->cell && c->since_switch_ms >= ( c->cell ? min_on_ms : min_off_ms ) )
+    {
+        c->cell = on;
+        c->since_switch_ms = 0;
+    }
+    c->window_elapsed_ms += dt_ms;
+    c->since_switch_ms += dt_ms;
+
+    return c->cell;
+}
+
+static void float_anomaly_priv ( float_anomaly_t *a, float t, float h, bool cell, ThermalModel &model,
+                                 uint32_t dt_ms )
+{
+    float dt = dt_ms / 1000.0f;
+
+    if ( !a->primed )
+    {
+        a->t = t;
+        a->ts = t;
+        a->t_max = t;
+        a->h = h;
+        a->hum_fast = h;
+        a->hum_slow = h;
+        a->model_samples = model.samples( );
+        a->primed = true;
+        return;
+    }
+
+    a->ts += ( dt / ANOMALY_SMOOTH_TAU_S ) * ( t - a->ts );
+    if ( !( a->alerts & ( Alert_CoolingFailure | Alert_DoorOpen ) ) || ( a->ts > a->t_max ) )
+    {
+        a->t_max = a->ts;
+    }
+
+    // stuck sensor
+    if ( ( t != a->t ) || ( h != a->h ) )
+    {
+        a->same_ms = 0;
+        a->alerts &= ~Alert_SensorStuck;
+    }
+    else if ( ( a->same_ms += dt_ms ) >= ANOMALY_STUCK_S * 1000UL )
+    {
+        a->alerts |= Alert_SensorStuck;
+    }
+
+    // door open
+    a->hum_fast += ( dt / ANOMALY_HUM_FAST_TAU_S ) * ( h - a->hum_fast );
+    a->hum_slow += ( dt / ANOMALY_HUM_SLOW_TAU_S ) * ( h - a->hum_slow );
+    if ( !( a->alerts & Alert_DoorOpen ) )
+    {
+        if ( fabsf( a->hum_fast - a->hum_slow ) > ANOMALY_HUM_JUMP / 100.0f )
+        {
+            a->alerts |= Alert_DoorOpen;
+            a->hum_base = a->hum_slow;
+        }
+    }
+    else if ( ( fabsf( a->hum_fast - a->hum_base ) < ANOMALY_HUM_SETTLED / 100.0f ) ||
+              ( cell && ( a->ts < a->t_max - ANOMALY_RISE.toFloat( ) ) ) )
+    {
+        a->alerts &= ~Alert_DoorOpen;
+    }
+
+    // cooling failure
+    if ( !cell || ( a->alerts & Alert_DoorOpen ) || ( a->same_ms >= ANOMALY_STUCK_SUSPECT_S * 1000UL ) )
+    {
+        a->cusum = 0.0f;
+        a->cell_on_ms = 0;
+        a->model_samples = model.samples( );
+    }
+    else
+    {
+        if ( a->cell_on_ms == 0 )
+        {
+            a->t_min = a->ts;
+        }
+        a->cell_on_ms += ( uint32_t )( dt * 1000.0f );
+        if ( a->ts < a->t_min )
+        {
+            a->t_min = a->ts;
+        }
+
+        if ( model.ready( ) )
+        {
+            if ( model.samples( ) != a->model_samples )
+            {
+                a->model_samples = model.samples( );
+                a->cusum += model.residual( ).toFloat( ) - ANOMALY_CUSUM_SLACK.toFloat( );
+                if ( a->cusum < 0.0f )
+                {
+                    a->cusum = 0.0f;
+                }
+            }
+            if ( a->cusum > ANOMALY_CUSUM_LIMIT.toFloat( ) )
+            {
+                a->alerts |= Alert_CoolingFailure;
+            }
+        }
+        else if ( ( a->cell_on_ms >= ANOMALY_COOLING_GRACE_S * 1000UL ) &&
+                  ( a->ts > a->t_min + ANOMALY_RISE.toFloat( ) ) )
+        {
+            a->alerts |= Alert_CoolingFailure;
+        }
+
+        if ( ( a->alerts & Alert_CoolingFailure ) && ( a->ts < a->t_max - ANOMALY_RISE.toFloat( ) ) )
+        {
+            a->alerts &= ~Alert_CoolingFailure;
+            a->cusum = 0.0f;
+        }
+    }
+
+    a->t = t;
+    a->h = h;
+}
+
+static void float_sampler_priv ( float_sampler_t *s, float t, bool cell, bool fast, uint32_t dt_ms )
+{
+    float dt = dt_ms / 1000.0f;
+    float step = SAMPLER_STEP.toFloat( );
+
+    if ( !s->primed )
+    {
+        s->ts = t;
+        s->cell = cell;
+        s->primed = true;
+    }
+
+    float alpha = dt / SAMPLER_SMOOTH_TAU_S;
+    if ( alpha > 1.0f )
+    {
+        alpha = 1.0f;
+    }
+
+    float prev = s->ts;
+    s->ts += alpha * ( t - s->ts );
+    s->rate += alpha * ( ( s->ts - prev ) * 60.0f / dt - s->rate );
+
+    if ( cell != s->cell )
+    {
+        s->settle_ms = 0;
+        s->period_ms = BENCH_TICK_MS;
+    }
+    s->cell = cell;
+
+    if ( s->settle_ms < SAMPLER_SETTLE_MS )
+    {
+        s->settle_ms += dt_ms;
+    }
+
+    float rate = fabsf( s->rate );
+    uint32_t target = SAMPLER_MAX_PERIOD_MS;
+    if ( rate * SAMPLER_MAX_PERIOD_MS > step * 60000.0f )
+    {
+        target = ( uint32_t )( step * 60000.0f / rate );
+    }
+    if ( fast || ( s->settle_ms < SAMPLER_SETTLE_MS ) )
+    {
+        target = BENCH_TICK_MS;
+    }
+
+    uint32_t period = BENCH_TICK_MS;
+    while ( ( period * 2 <= target ) && ( period < 2 * s->period_ms ) )
+    {
+        period *= 2;
+    }
+    s->period_ms = period;
+}
+
+// centi_str() of main.cpp
+static char *centi_str_priv ( char *buf, int32_t v )
+{
+    uint32_t a = ( v < 0 ) ? -( uint32_t )v : ( uint32_t )v;
+
+    sprintf( buf, "%s%lu.%02lu", ( v < 0 ) ? "-" : "", ( unsigned long )( a / 100 ), ( unsigned long )( a % 100 ) );
+    return buf;
+}
+
+static void time_priv ( const char *name, bench_path_t *p,
+                        bool ( *tick )( bench_path_t *, uint32_t, bench_tick_t * ), bench_tick_t *outs )
+{
+    struct timespec start;
+    struct timespec end;
+    uint64_t cycles;
+    double ns;
+    uint32_t i;
+
+    rollup_init( );
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    cycles = BENCH_CYCLES( );
+    for ( i = 0; i < BENCH_TICKS; i++ )
+    {
+        tick( p, i, &outs[ i ] );
+    }
+    cycles = BENCH_CYCLES( ) - cycles;
+    clock_gettime( CLOCK_MONOTONIC, &end );
+    ns = ( end.tv_sec - start.tv_sec ) * 1e9 + ( end.tv_nsec - start.tv_nsec );
+
+    printf( "%-18s %10.2f %10.1f\n", name, ns / BENCH_TICKS, ( double )cycles / BENCH_TICKS );
+}
+
+// ------------------------------------------------------------------------- END
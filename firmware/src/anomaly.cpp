@@ -0,0 +1,167 @@
+/* ************************************************************************** */
+/** Online anomaly detection
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <stdlib.h>
+#include "anomaly.h"
+
+/* A first order low pass on humidity, in Q16 so that a step of dt/tau of
+   a small difference is not rounded away */
+static int32_t humLowPass(int32_t y, int32_t h, uint32_t dtMs, uint32_t tauS)
+{
+    return y + (int32_t)(((int64_t)h * 65536 - y) * dtMs / ((int64_t)tauS * 1000));
+}
+
+AnomalyDetector::AnomalyDetector()
+{
+    reset();
+}
+
+void AnomalyDetector::reset()
+{
+    _alerts = Alert_None;
+    _primed = false;
+    _cusum = MilliCelsius();
+    _modelSamples = 0;
+    _cellOnMs = 0;
+    _t = CentiCelsius();
+    _ts = FilterCelsius();
+    _tMin = FilterCelsius();
+    _tMax = FilterCelsius();
+    _humFast = 0;
+    _humSlow = 0;
+    _humBase = 0;
+    _h = 0;
+    _sameMs = 0;
+}
+
+uint8_t AnomalyDetector::update(CentiCelsius t, int32_t h, bool cell, bool doorOpen, ThermalModel& model, uint32_t dtMs)
+{
+    uint8_t prev = _alerts;
+
+    if (!_primed)
+    {
+        _t = t;
+        _ts = t.to<FilterCelsius::perDegree>();
+        _tMax = _ts;
+        _h = h;
+        _humFast = h * 65536;
+        _humSlow = _humFast;
+        _modelSamples = model.samples();
+        _primed = true;
+        return Alert_None;
+    }
+
+    _ts.follow(t, dtMs, ANOMALY_SMOOTH_TAU_S * 1000UL);
+    if (!(_alerts & (Alert_CoolingFailure | Alert_DoorOpen)))
+        _tMax = _ts;
+    else if (_ts > _tMax)
+        _tMax = _ts;
+
+    stuck(t, h, dtMs);
+    humidity(h, cell, dtMs);
+    cooling(cell, doorOpen, model, dtMs);
+
+    _t = t;
+    _h = h;
+
+    return _alerts & ~prev;
+}
+
+void AnomalyDetector::cooling(bool cell, bool doorOpen, ThermalModel& model, uint32_t dtMs)
+{
+    // heat let in through the door, or readings that may not be real
+    bool masked = doorOpen || (_alerts & Alert_DoorOpen) || (_sameMs >= ANOMALY_STUCK_SUSPECT_S * 1000UL);
+
+    if (!cell || masked)
+    {
+        _cusum = MilliCelsius();
+        _cellOnMs = 0;
+        _modelSamples = model.samples();
+        return;
+    }
+
+    if (_cellOnMs == 0)
+        _tMin = _ts;
+    _cellOnMs += dtMs;
+    if (_ts < _tMin)
+        _tMin = _ts;
+
+    if (model.ready())
+    {
+        // one step per model sample
+        if (model.samples() != _modelSamples)
+        {
+            _modelSamples = model.samples();
+            _cusum += model.residual() - ANOMALY_CUSUM_SLACK;
+            if (_cusum < MilliCelsius())
+                _cusum = MilliCelsius();
+        }
+
+        if (_cusum > ANOMALY_CUSUM_LIMIT)
+            _alerts |= Alert_CoolingFailure;
+    }
+    else if ((_cellOnMs >= ANOMALY_COOLING_GRACE_S * 1000UL) && (_ts - _tMin > ANOMALY_RISE))
+    {
+        // no model yet: the air must not warm up with the cell on
+        _alerts |= Alert_CoolingFailure;
+    }
+
+    if ((_alerts & Alert_CoolingFailure) && recovering(cell))
+    {
+        _alerts &= ~Alert_CoolingFailure;
+        _cusum = MilliCelsius();
+    }
+}
+
+bool AnomalyDetector::recovering(bool cell)
+{
+    // the cell brings the air down from the highest point of the alert
+    return cell && (_tMax - _ts > ANOMALY_RISE);
+}
+
+void AnomalyDetector::humidity(int32_t h, bool cell, uint32_t dtMs)
+{
+    _humFast = humLowPass(_humFast, h, dtMs, ANOMALY_HUM_FAST_TAU_S);
+    _humSlow = humLowPass(_humSlow, h, dtMs, ANOMALY_HUM_SLOW_TAU_S);
+
+    if (!(_alerts & Alert_DoorOpen))
+    {
+        if (labs(_humFast - _humSlow) > ANOMALY_HUM_JUMP * 65536L)
+        {
+            _alerts |= Alert_DoorOpen;
+            _humBase = _humSlow;
+        }
+        return;
+    }
+
+    // the slow average follows an open door too: the alert holds until the
+    // humidity is back or the cell brings the air down again
+    if ((labs(_humFast - _humBase) < ANOMALY_HUM_SETTLED * 65536L) || recovering(cell))
+        _alerts &= ~Alert_DoorOpen;
+}
+
+void AnomalyDetector::stuck(CentiCelsius t, int32_t h, uint32_t dtMs)
+{
+    // the noise of a working part moves the last bits of every conversion
+    if ((t != _t) || (h != _h))
+    {
+        _sameMs = 0;
+        _alerts &= ~Alert_SensorStuck;
+        return;
+    }
+
+    _sameMs += dtMs;
+    if (_sameMs >= ANOMALY_STUCK_S * 1000UL)
+        _alerts |= Alert_SensorStuck;
+}
+
+/* *****************************************************************************
+ End of File
+ */
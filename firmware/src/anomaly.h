@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/** Online anomaly detection
+
+  @Summary
+    Streaming detectors for cooling failure, door left open and a stuck
+    temperature/humidity sensor.
+
+  @Description
+    Every detector keeps a handful of running values, no sample history:
+
+    - cooling failure: while the cell is on, a one-sided CUSUM of the online
+      model residual, i.e. the air warming up against what the model expects.
+      Until the model is ready, the air must not warm up by ANOMALY_RISE
+      once the cell has been on for ANOMALY_COOLING_GRACE_S.
+    - door open: a fast and a slow average of the relative humidity drifting
+      apart, outside air coming in. It holds until the humidity is back to
+      where it was or the cell brings the air down again.
+    - stuck sensor: temperature and humidity readings bit for bit the same
+      for ANOMALY_STUCK_S, which the noise of a working part never allows.
+      0.01 C and 0.01 %RH are finer than a step of the 14-bit temperature
+      and the 11-bit humidity, so no two codes read the same.
+
+    Cooling failure and door alerts clear when the cell brings the air
+    ANOMALY_RISE down from its highest point. Alerts are reported as a
+    bit mask. All of it is in integers, humidity in 0.01 %RH.
+ */
+/* ************************************************************************** */
+
+#ifndef _ANOMALY_H    /* Guard against multiple inclusion */
+#define _ANOMALY_H
+
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <stdint.h>
+#include <stdbool.h>
+#include "celsius.h"
+#include "tempmodel.h"
+
+#define ANOMALY_CUSUM_SLACK         MilliCelsius::fromRaw(4)    // per model sample, below it the residual is noise
+#define ANOMALY_CUSUM_LIMIT         MilliCelsius::fromRaw(100)
+#define ANOMALY_COOLING_GRACE_S     300
+#define ANOMALY_SMOOTH_TAU_S        60
+#define ANOMALY_RISE                CentiCelsius::fromRaw(30)
+#define ANOMALY_HUM_FAST_TAU_S      10
+#define ANOMALY_HUM_SLOW_TAU_S      600
+#define ANOMALY_HUM_JUMP            500     // 0.01 %RH
+#define ANOMALY_HUM_SETTLED         150
+#define ANOMALY_STUCK_SUSPECT_S     60
+#define ANOMALY_STUCK_S             300
+
+typedef enum
+{
+  Alert_None = 0x00,
+  Alert_CoolingFailure = 0x01,
+  Alert_DoorOpen = 0x02,
+  Alert_SensorStuck = 0x04,
+  Alert_ActuatorMismatch = 0x08,    // raised by the current monitor
+  Alert_DoorStall = 0x10,           // raised by the door, until its next move
+} AlertEnum;
+
+class AnomalyDetector
+{
+public:
+    AnomalyDetector();
+
+    // *****************************************************************************
+    /**
+      @Function
+        void reset()
+
+      @Summary
+        Clear the alerts and the detectors, e.g. when the mains is switched off
+     */
+    void reset();
+
+    /**
+      @Function
+        uint8_t update(CentiCelsius t, int32_t h, bool cell, bool doorOpen,
+                       ThermalModel& model, uint32_t dtMs)
+
+      @Summary
+        Feed the readings taken dtMs after the previous ones, with the cell in
+        the given state. doorOpen is set while the door is open on purpose:
+        the heat coming in is no cooling failure then. The model must already
+        have been fed with the same temperature
+
+      @Returns
+        The alerts raised by this sample
+     */
+    uint8_t update(CentiCelsius t, int32_t h, bool cell, bool doorOpen, ThermalModel& model, uint32_t dtMs);
+
+    uint8_t alerts() { return _alerts; }
+
+private:
+    void cooling(bool cell, bool doorOpen, ThermalModel& model, uint32_t dtMs);
+    void humidity(int32_t h, bool cell, uint32_t dtMs);
+    void stuck(CentiCelsius t, int32_t h, uint32_t dtMs);
+    bool recovering(bool cell);
+
+    uint8_t _alerts;
+    bool _primed;
+
+    MilliCelsius _cusum;
+    uint32_t _modelSamples;
+    uint32_t _cellOnMs;
+    CentiCelsius _t;
+    FilterCelsius _ts;      // smoothed over ANOMALY_SMOOTH_TAU_S
+    FilterCelsius _tMin;    // since the cell was switched on
+    FilterCelsius _tMax;    // since a cooling or door alert was raised
+
+    int32_t _humFast;       // 0.01 %RH, Q16
+    int32_t _humSlow;
+    int32_t _humBase;
+
+    int32_t _h;
+    uint32_t _sameMs;
+};
+
+#endif /* _ANOMALY_H */
+
+/* *****************************************************************************
+ End of File
+ */
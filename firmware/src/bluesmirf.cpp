@@ -1,6 +1,88 @@
+#include <string.h>
 #include "bluesmirf.h"
+#include "btrx.h"
+#include "drivers/bttx.h"
 #include "definitions.h"
 
+/* Temporary rate commands of the RN-42, the stored one is set with SU */
+static const struct
+{
+  uint32_t baud;
+  const char* command;
+} baudCommands[] =
+{
+  { 115200, "U,115K,N\r" },
+  { 230400, "U,230K,N\r" },
+  { 460800, "U,460K,N\r" },
+  { 921600, "U,921K,N\r" },
+};
+
+static const char* baudCommand(uint32_t baud)
+{
+  for (size_t i = 0; i < sizeof(baudCommands) / sizeof(baudCommands[0]); i++)
+    if (baudCommands[i].baud == baud)
+      return baudCommands[i].command;
+
+  return NULL;
+}
+
+// CRC-16/CCITT, as the flash records
+static uint16_t crc16Update(uint16_t crc, uint8_t data)
+{
+  crc ^= (uint16_t)data << 8;
+  for (uint8_t bit = 0; bit < 8; bit++)
+    crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : (crc << 1);
+
+  return crc;
+}
+
+static uint16_t crc16(const uint8_t* data, size_t length)
+{
+  uint16_t crc = 0xFFFF;
+
+  for (size_t i = 0; i < length; i++)
+    crc = crc16Update(crc, data[i]);
+
+  return crc;
+}
+
+/* A frame encoded into the room bttx reserves as it is built; it goes out
+   whole on end() or not at all */
+class TxFrame
+{
+public:
+  bool begin(size_t length)
+  {
+    size_t room;
+
+    _buffer = bttx_reserve(&room);
+    _pos = 0;
+    _length = length;
+    return room >= length;
+  }
+
+  void put(uint8_t c)
+  {
+    _buffer[_pos++] = c;
+  }
+
+  void put16(uint16_t value)
+  {
+    put((uint8_t)(value >> 8));
+    put((uint8_t)value);
+  }
+
+  void end()
+  {
+    bttx_commit(_length);
+  }
+
+private:
+  uint8_t* _buffer;
+  size_t _pos;
+  size_t _length;
+};
+
 BlueSmirf::BlueSmirf()
 {
   _protoStatus = Proto_WaitSTX;
@@ -10,78 +92,451 @@ BlueSmirf::BlueSmirf()
   _cell = false;
   _mains = false;
   _appStatus = 0;
-  _lastMsgMs = 0;
   _connected = false;
-  _tempSetpoint = 50; // 5C
+  memset(&_linkTimer, 0, sizeof(_linkTimer));
+  _cmdHead = 0;
+  _cmdCount = 0;
+  memset(&_cmdTimer, 0, sizeof(_cmdTimer));
+  _lastReply = Reply_None;
+  _reply[0] = '\0';
+  _replyLength = 0;
+  _linkStep = Link_Idle;
+  _baud = BLUESMIRF_BAUD_DEFAULT;
+  _loopFrames = 0;
+  memset(&_loopTimer, 0, sizeof(_loopTimer));
+  _loopDone = false;
+  _rollupStatus = Rollup_Idle;
+  _tempSetpoint = DeciCelsius::fromRaw(50); // 5C
 }
         
 void BlueSmirf::init()
 {
-    SERCOM3_USART_Write((uint8_t*)"$$$", 3);
-    SYSTICK_DelayMs(100);
-    
-    SERCOM3_USART_Write((uint8_t*)"SM,0\r", 5);
-    SYSTICK_DelayMs(100);
-    
-    SERCOM3_USART_Write((uint8_t*)"---\r", 4);
-    SYSTICK_DelayMs(100);
+  // still going from the last link timeout, the module is slow or absent
+  if (_cmdCount > 0)
+    return;
+
+  // checks the rate as well, see linkUpdate()
+  if (_linkStep == Link_Idle)
+    _linkStep = Link_Init;
+
+  sendCommand("$$$", "CMD", BLUESMIRF_CMD_TIMEOUT_MS, true);
+  sendCommand("SM,0\r", "AOK");
+  sendCommand("---\r", "END");
+}
+
+bool BlueSmirf::sendCommand(const char* text, const char* reply, uint32_t timeoutMs, bool required)
+{
+  ModuleCommand* cmd;
+
+  if (_cmdCount >= BLUESMIRF_CMD_QUEUE)
+    return false;
+
+  cmd = &_cmdQueue[(_cmdHead + _cmdCount) % BLUESMIRF_CMD_QUEUE];
+  cmd->text = text;
+  cmd->reply = reply;
+  cmd->timeoutMs = timeoutMs;
+  cmd->required = required;
+
+  if (_cmdCount++ == 0)
+    commandSend();
+
+  return true;
+}
+
+void BlueSmirf::commandSend()
+{
+  const ModuleCommand* cmd = &_cmdQueue[_cmdHead];
+
+  // a reply line cut by the last timeout is not this one's
+  _replyLength = 0;
+
+  SERCOM3_USART_Write((uint8_t*)cmd->text, strlen(cmd->text));
+  swtimer_start(&_cmdTimer, cmd->timeoutMs, commandTimeout, (uintptr_t)this);
+}
+
+void BlueSmirf::commandDone(ReplyEnum reply)
+{
+  bool dropRest = (reply != Reply_Ok) && _cmdQueue[_cmdHead].required;
+
+  swtimer_cancel(&_cmdTimer);
+  _lastReply = reply;
+
+  _cmdHead = (_cmdHead + 1) % BLUESMIRF_CMD_QUEUE;
+  _cmdCount--;
+
+  if (dropRest)
+    _cmdCount = 0;
+
+  if (_cmdCount > 0)
+    commandSend();
+}
+
+void BlueSmirf::commandTimeout(uintptr_t context)
+{
+  BlueSmirf* self = (BlueSmirf*)context;
+
+  if (self->_cmdCount > 0)
+    self->commandDone(Reply_Timeout);
+}
+
+void BlueSmirf::replyUpdate(uint8_t c)
+{
+  const char* expected = _cmdQueue[_cmdHead].reply;
+
+  // the module ends its lines with CR LF
+  if (c != '\r' && c != '\n')
+  {
+    if (_replyLength < BLUESMIRF_REPLY_LENGTH - 1)
+      _reply[_replyLength++] = (char)c;
+    return;
+  }
+
+  if (_replyLength == 0)
+    return;
+
+  _reply[_replyLength] = '\0';
+  _replyLength = 0;
+
+  if (expected == NULL || strncmp(_reply, expected, strlen(expected)) == 0)
+    commandDone(Reply_Ok);
+  else if (strncmp(_reply, "ERR", 3) == 0 || strcmp(_reply, "?") == 0)
+    commandDone(Reply_Error);
+
+  // anything else is status text the module prints on its own
 }
 
 bool BlueSmirf::update()
 {
   bool newMessage = false;
+
+  // in command mode the module answers in text lines
+  receive(false);
+
+  // a rate change goes on once the module has answered
+  if (_cmdCount == 0 && linkUpdate())
+    return false;
+
+  // the data frames wait for the module to be back in data mode
+  if (_cmdCount > 0)
+    return false;
   
-  while (SERCOM3_USART_ReadCountGet())
+  // a loopback frame may end a rate check and send the module commands
+  newMessage = receive(true);
+
+  if (_cmdCount == 0)
   {
-    newMessage |= protoUpdate();
+    rollupUpdate();
+    loopUpdate();
   }
 
   if (!newMessage)
+    return false;
+
+  // link is considered lost when the app stays silent for 5 seconds
+  swtimer_start(&_linkTimer, BLUESMIRF_LINK_TIMEOUT_MS, linkTimeout, (uintptr_t)this);
+  _connected = true;
+
+  if (_cmdCount > 0)
+    return true;
+
+  TxFrame frame;
+  uint8_t tmp;
+
+  // the answer goes out whole or not at all, the app asks again
+  if (!frame.begin(7))
+    return true;
+
+  frame.put('$');
+  frame.put((uint8_t)_appStatus);
+  frame.put16((uint16_t)_temperature.raw());
+  frame.put((uint8_t)_humidity);
+
+  tmp = 0x00;
+  if (_fan) tmp |= 0x01;
+  if (_cell) tmp |= 0x02;
+  if (_mains) tmp |= 0x04;
+
+  frame.put(tmp);
+  frame.put('#');
+  frame.end();
+
+  return true;
+}
+
+bool BlueSmirf::setBaud(uint32_t baud)
+{
+  const char* command = baudCommand(baud);
+
+  if (command == NULL || _linkStep != Link_Idle || _cmdCount > 0)
+    return false;
+
+  // the module leaves command mode as it changes rate, no "---"
+  _linkBaud = baud;
+  _linkStep = Link_Switch;
+  sendCommand("$$$", "CMD", BLUESMIRF_CMD_TIMEOUT_MS, true);
+  sendCommand(command, "AOK", BLUESMIRF_CMD_TIMEOUT_MS, true);
+
+  return true;
+}
+
+bool BlueSmirf::startLoopback(uint16_t frames)
+{
+  if (_linkStep != Link_Idle || _cmdCount > 0 || frames == 0)
+    return false;
+
+  _linkStep = Link_Bench;
+  loopStart(frames);
+
+  return true;
+}
+
+bool BlueSmirf::loopbackDone(LoopbackResult& result)
+{
+  if (!_loopDone)
+    return false;
+
+  result = _loopResult;
+  _loopDone = false;
+
+  return true;
+}
+
+/* Called with no command pending, returns true to hold the data frames */
+bool BlueSmirf::linkUpdate()
+{
+  switch (_linkStep)
   {
-    if (_lastMsgMs == 0)
+    case Link_Init:
+      // a module that does not answer at a changed rate has been reset
+      if (_lastReply != Reply_Ok && _baud != BLUESMIRF_BAUD_DEFAULT)
+        serialSetup(BLUESMIRF_BAUD_DEFAULT);
+      _linkStep = Link_Idle;
       return false;
 
-    unsigned long delta = SYSTICK_GetTickCounter() - _lastMsgMs;
-    if (delta > 5000)
-    {
-      init();
-        
-      _command = Command_None;
-      _connected = false;
+    case Link_Switch:
+      if (_lastReply != Reply_Ok)
+      {
+        // refused: still in command mode; no answer: still at the old rate
+        if (_lastReply == Reply_Error)
+          sendCommand("---\r", "END");
+        _loopResult.baud = _linkBaud;
+        _loopResult.echoed = 0;
+        _loopResult.lost = 0;
+        _loopResult.bytesPerSec = 0;
+        _loopDone = true;
+        _linkStep = Link_Idle;
+        return false;
+      }
+
+      // what is still to go was written for the old rate
+      if (SERCOM3_USART_WriteCountGet() > 0)
+        return true;
+      serialSetup(_linkBaud);
+      _linkStep = Link_Verify;
+      loopStart(BLUESMIRF_VERIFY_FRAMES);
+      return false;
+
+    case Link_Fallback:
+      // back to the default whether the module answered or not
+      if (SERCOM3_USART_WriteCountGet() > 0)
+        return true;
+      serialSetup(BLUESMIRF_BAUD_DEFAULT);
+      _loopDone = true;
+      _linkStep = Link_Idle;
+      return false;
+
+    default:
+      return false;
+  }
+}
+
+void BlueSmirf::serialSetup(uint32_t baud)
+{
+  USART_SERIAL_SETUP setup;
+
+  setup.baudRate = baud;
+  setup.parity = USART_PARITY_NONE;
+  setup.dataWidth = USART_DATA_8_BIT;
+  setup.stopBits = USART_STOP_1_BIT;
+
+  if (SERCOM3_USART_SerialSetup(&setup, 0))
+    _baud = baud;
+
+  _protoStatus = Proto_WaitSTX;
+}
+
+void BlueSmirf::loopStart(uint16_t frames)
+{
+  _loopFrames = frames;
+  _loopSent = 0;
+  _loopEchoed = 0;
+  _loopLost = 0;
+  _loopStart = swtimer_now();
+  _loopLast = _loopStart;
+
+  swtimer_start(&_loopTimer, BLUESMIRF_LOOP_TIMEOUT_MS, loopTimeout, (uintptr_t)this);
+  loopUpdate();
+}
+
+void BlueSmirf::loopUpdate()
+{
+  TxFrame frame;
+  uint16_t crc;
+  uint8_t c;
 
-      _lastMsgMs = 0;
+  if (_linkStep != Link_Verify && _linkStep != Link_Bench)
+    return;
+
+  while (_loopSent < _loopFrames && (uint16_t)(_loopSent - _loopEchoed - _loopLost) < BLUESMIRF_LOOP_WINDOW &&
+         frame.begin(BLUESMIRF_LOOP_FRAME))
+  {
+    frame.put('~');
+    frame.put((uint8_t)_loopSent);
+    crc = crc16Update(0xFFFF, (uint8_t)_loopSent);
+    // every byte value over the run, the frame markers included
+    for (uint8_t i = 0; i < BLUESMIRF_LOOP_PAYLOAD; i++)
+    {
+      c = (uint8_t)(_loopSent * BLUESMIRF_LOOP_PAYLOAD + i);
+      frame.put(c);
+      crc = crc16Update(crc, c);
     }
+    frame.put16(crc);
+    frame.put('#');
+    frame.end();
 
-    return false;
+    _loopSent++;
   }
+}
 
-  _lastMsgMs = SYSTICK_GetTickCounter();
-  _connected = true;
+void BlueSmirf::loopEcho()
+{
+  uint16_t crc = crc16(&_loopRx[1], BLUESMIRF_LOOP_PAYLOAD + 1);
+  uint8_t gap = (uint8_t)(_loopRx[1] - (uint8_t)(_loopEchoed + _loopLost));
 
-  uint8_t tmp;
-  
-  SERCOM3_USART_Write((uint8_t*)"$", 1);
-  
-  tmp = (uint8_t)_appStatus;
-  SERCOM3_USART_Write(&tmp, 1);
+  if (_linkStep != Link_Verify && _linkStep != Link_Bench)
+    return;
 
-  tmp = (uint8_t)_temperature >> 8;
-  SERCOM3_USART_Write(&tmp, 1);
+  if (_loopRx[BLUESMIRF_LOOP_PAYLOAD + 2] != (uint8_t)(crc >> 8) || _loopRx[BLUESMIRF_LOOP_PAYLOAD + 3] != (uint8_t)crc ||
+      _loopRx[BLUESMIRF_LOOP_PAYLOAD + 4] != '#')
+  {
+    // a bad frame at a rate on trial is enough
+    _loopLost++;
+    if (_linkStep == Link_Verify)
+      loopEnd();
+    return;
+  }
 
-  tmp = (uint8_t)_temperature & 0xff;
-  SERCOM3_USART_Write(&tmp, 1);
+  // frames come back in order, a gap was lost; older ones are from a run
+  // that ended
+  if (gap >= BLUESMIRF_LOOP_WINDOW)
+    return;
 
-  tmp = (uint8_t)_humidity;
-  SERCOM3_USART_Write(&tmp, 1);
+  _loopLost += gap;
+  _loopEchoed++;
+  _loopLast = swtimer_now();
+  swtimer_start(&_loopTimer, BLUESMIRF_LOOP_TIMEOUT_MS, loopTimeout, (uintptr_t)this);
 
-  tmp = 0x00;
-  if (_fan) tmp |= 0x01;
-  if (_cell) tmp |= 0x02;
-  if (_mains) tmp |= 0x04;
-              
-  SERCOM3_USART_Write(&tmp, 1);
+  if (_loopEchoed + _loopLost >= _loopFrames || (_loopLost > 0 && _linkStep == Link_Verify))
+    loopEnd();
+}
+
+void BlueSmirf::loopEnd()
+{
+  uint32_t ticks = _loopLast - _loopStart;
+  TxFrame frame;
+
+  swtimer_cancel(&_loopTimer);
+
+  _loopResult.baud = _baud;
+  _loopResult.echoed = _loopEchoed;
+  _loopResult.lost = _loopSent - _loopEchoed;
+  _loopResult.bytesPerSec = (ticks > 0) ?
+      (uint32_t)(((uint64_t)_loopEchoed * BLUESMIRF_LOOP_PAYLOAD * SWTIMER_TICK_FREQ) / ticks) : 0;
+
+  if (_linkStep == Link_Verify && _loopResult.lost > 0)
+  {
+    // the module may not get these, the rate goes back anyway
+    _linkStep = Link_Fallback;
+    sendCommand("$$$", "CMD", BLUESMIRF_CMD_TIMEOUT_MS, true);
+    sendCommand(baudCommand(BLUESMIRF_BAUD_DEFAULT), "AOK", BLUESMIRF_CMD_TIMEOUT_MS, true);
+    return;
+  }
+
+  if (_linkStep == Link_Bench && frame.begin(10))
+  {
+    uint16_t rate = (_loopResult.bytesPerSec > 65535) ? 65535 : (uint16_t)_loopResult.bytesPerSec;
+
+    frame.put('^');
+    frame.put16((uint16_t)(_loopResult.baud / 100));
+    frame.put16(_loopResult.echoed);
+    frame.put16(_loopResult.lost);
+    frame.put16(rate);
+    frame.put('#');
+    frame.end();
+  }
+
+  _loopDone = true;
+  _linkStep = Link_Idle;
+}
+
+void BlueSmirf::loopTimeout(uintptr_t context)
+{
+  BlueSmirf* self = (BlueSmirf*)context;
+
+  if (self->_linkStep == Link_Verify || self->_linkStep == Link_Bench)
+    self->loopEnd();
+}
+
+bool BlueSmirf::sendStepResult(const StepResult& result)
+{
+  TxFrame frame;
+  int16_t baseline = (int16_t)(result.baselineC * 10.0f);
+  int16_t gain = (int16_t)(result.gainC * 100.0f);
+  uint16_t tau = (result.tauS > 65535.0f)? 65535 : (uint16_t)result.tauS;
+  uint16_t dead = (uint16_t)result.deadTimeS;
+  int16_t rate = (int16_t)(result.maxRateCPerMin * 100.0f);
+
+  if (_cmdCount > 0 || !frame.begin(14))
+    return false;
+
+  frame.put('&');
+  frame.put((uint8_t)result.status);
+  frame.put16((uint16_t)baseline);
+  frame.put16((uint16_t)gain);
+  frame.put16(tau);
+  frame.put16(dead);
+  frame.put16((uint16_t)rate);
+  frame.put((uint8_t)result.runs);
+  frame.put('#');
+  frame.end();
+
+  return true;
+}
+
+void BlueSmirf::sendRollups(ROLLUP_LEVEL level)
+{
+  // a query arriving while the previous answer is still going out restarts it
+  _rollupLevel = level;
+  _rollupCount = rollup_count(level);
+  _rollupNext = 0;
+  _rollupStatus = Rollup_Header;
+
+  // or from update() once the module is back in data mode
+  if (_cmdCount == 0)
+    rollupUpdate();
+}
+
+bool BlueSmirf::sendAlerts(uint8_t alerts)
+{
+  TxFrame frame;
 
-  SERCOM3_USART_Write((uint8_t*)'#', 1);
+  if (_cmdCount > 0 || !frame.begin(3))
+    return false;
+
+  frame.put('!');
+  frame.put(alerts);
+  frame.put('#');
+  frame.end();
 
   return true;
 }
@@ -92,9 +547,9 @@ void BlueSmirf::setSwitches(bool fan, bool cell)
   _cell = cell;
 }
 
-void BlueSmirf::setTemperature(float temp)
+void BlueSmirf::setTemperature(DeciCelsius temp)
 {
-    _temperature = (int)(temp * 10);
+    _temperature = temp;
 }
 void BlueSmirf::setHumidity(int hum)
 {
@@ -119,18 +574,117 @@ CommandEnum BlueSmirf::command()
   return tmp;
 }
 
-bool BlueSmirf::protoUpdate()
+void BlueSmirf::linkTimeout(uintptr_t context)
+{
+  BlueSmirf* self = (BlueSmirf*)context;
+
+  self->init();
+
+  self->_command = Command_None;
+  self->_connected = false;
+}
+
+void BlueSmirf::rollupUpdate()
+{
+  TxFrame frame;
+  rollup_bucket_t b;
+
+  // only whole pieces are written, the rest waits for room
+  while (_rollupStatus != Rollup_Idle)
+  {
+    switch (_rollupStatus)
+    {
+      case Rollup_Header:
+        if (!frame.begin(3))
+          return;
+        frame.put('%');
+        frame.put((uint8_t)_rollupLevel);
+        frame.put((uint8_t)_rollupCount);
+        frame.end();
+        _rollupStatus = Rollup_Buckets;
+        break;
+      case Rollup_Buckets:
+        if (_rollupNext >= _rollupCount)
+        {
+          _rollupStatus = Rollup_Trailer;
+          break;
+        }
+        if (!frame.begin(8))
+          return;
+        // buckets closed in the meantime shift the ring: the answer may
+        // repeat one, never mixes resolutions
+        if (!rollup_get(_rollupLevel, _rollupNext, &b))
+          memset(&b, 0, sizeof(b));
+        frame.put16((uint16_t)b.min);
+        frame.put16((uint16_t)b.max);
+        frame.put16((uint16_t)b.mean);
+        frame.put(b.cell_duty);
+        frame.put(b.fan_duty);
+        frame.end();
+        _rollupNext++;
+        break;
+      case Rollup_Trailer:
+        if (!frame.begin(1))
+          return;
+        frame.put('#');
+        frame.end();
+        _rollupStatus = Rollup_Idle;
+        break;
+      default:
+        _rollupStatus = Rollup_Idle;
+        break;
+    }
+  }
+}
+
+bool BlueSmirf::receive(bool frames)
+{
+  bool newMessage = false;
+  const uint8_t* data;
+  size_t count;
+  size_t i;
+  bool idle;
+
+  // parsed where the DMA wrote them; each side stops as soon as the module
+  // goes in or out of command mode, the rest is for the other one
+  while ((_cmdCount == 0) == frames && (count = btrx_peek(&data, &idle)) > 0)
+  {
+    // a frame or a line cut short by a quiet line or lost bytes is dropped
+    if (idle)
+    {
+      _protoStatus = Proto_WaitSTX;
+      _replyLength = 0;
+    }
+
+    for (i = 0; i < count && (_cmdCount == 0) == frames; i++)
+    {
+      if (frames)
+        newMessage |= protoUpdate(data[i]);
+      else
+        replyUpdate(data[i]);
+    }
+
+    btrx_consume(i);
+  }
+
+  return newMessage;
+}
+
+bool BlueSmirf::protoUpdate(uint8_t c)
 {
   bool newMessage = false;
-  uint8_t c;
-  
-  SERCOM3_USART_Read(&c, 1);
 
   switch (_protoStatus)
   {
     case Proto_WaitSTX:
       if (c == '$')
         _protoStatus = Proto_WaitMode;
+      else if (c == '~')
+      {
+        _loopRx[0] = c;
+        _loopRxLength = 1;
+        _protoStatus = Proto_Loopback;
+      }
       break;
     case Proto_WaitMode:
       _manual = (c != 0);
@@ -146,7 +700,7 @@ bool BlueSmirf::protoUpdate()
       break;
     case Proto_WaitSetpointLSB:
       _tempTmp = (_tempTmp << 8) | c;
-      _tempSetpoint = _tempTmp;
+      _tempSetpoint = DeciCelsius::fromRaw(_tempTmp);
       _protoStatus = Proto_WaitOutput;
       break;
     case Proto_WaitOutput:
@@ -159,6 +713,14 @@ bool BlueSmirf::protoUpdate()
       newMessage = true;
       _protoStatus = Proto_WaitSTX;
       break;
+    case Proto_Loopback:
+      _loopRx[_loopRxLength++] = c;
+      if (_loopRxLength == BLUESMIRF_LOOP_FRAME)
+      {
+        loopEcho();
+        _protoStatus = Proto_WaitSTX;
+      }
+      break;
   }
 
   return newMessage;
@@ -27,30 +27,124 @@
 
 /* This section lists the other files that are included in this file.
  */
+#include "swtimer.h"
+#include "celsius.h"
+#include "stepresponse.h"
+#include "rollup.h"
+
+#define BLUESMIRF_LINK_TIMEOUT_MS   5000
+#define BLUESMIRF_CMD_TIMEOUT_MS    500     // for the module to answer a command
+#define BLUESMIRF_CMD_QUEUE         4
+#define BLUESMIRF_REPLY_LENGTH      24
+
+#define BLUESMIRF_BAUD_DEFAULT      115200  // stored in the module
+#define BLUESMIRF_BAUD_FAST         460800
+#define BLUESMIRF_LOOP_PAYLOAD      32
+#define BLUESMIRF_LOOP_FRAME        (BLUESMIRF_LOOP_PAYLOAD + 5)
+#define BLUESMIRF_LOOP_WINDOW       16      // their echoes fit the receive buffer
+#define BLUESMIRF_LOOP_TIMEOUT_MS   1000    // for the next echo
+#define BLUESMIRF_VERIFY_FRAMES     16      // echoed intact to keep a new rate
+#define BLUESMIRF_BENCH_FRAMES      512
 
 typedef enum 
 {
   Command_None = 0,
   Command_Open = 1,
   Command_Close = 2,
+  Command_ControlHysteresis = 3,
+  Command_ControlPI = 4,
+  Command_ControlPID = 5,
+  Command_ControlPredictive = 6,
+  Command_Characterize = 7,
+  Command_ReportCharacterization = 8,
+  Command_QueryMinutes = 9,
+  Command_QueryHours = 10,
+  Command_QueryDays = 11,
+  Command_FastLink = 12,
+  Command_LinkBenchmark = 13,
 } CommandEnum;
 
+typedef enum
+{
+  Reply_None = 0,
+  Reply_Ok,
+  Reply_Error,
+  Reply_Timeout
+} ReplyEnum;
+
+typedef struct
+{
+  uint32_t baud;
+  uint16_t echoed;
+  uint16_t lost;          // never came back or failed the CRC
+  uint32_t bytesPerSec;   // payload echoed
+} LoopbackResult;
+
 class BlueSmirf
 {
 public:
     BlueSmirf();
 
+    /* Queues the configuration commands, returns at once; ready() is true
+       once the module has answered the last one or failed to */
     void init();
+    bool ready() { return _cmdCount == 0; }
     bool update();
 
+    /* Queues an RN-42 command, text and reply are not copied. It is sent
+       when the ones before it are done and is done when a line starting
+       with reply comes back (any line if reply is NULL), failed on ERR, ?
+       or after timeoutMs. A failed required command drops the ones queued
+       after it: without "$$$" they would reach the remote device as data.
+       The replies are read by update(), which holds the data frames back
+       until the queue is empty */
+    bool sendCommand(const char* text, const char* reply, uint32_t timeoutMs = BLUESMIRF_CMD_TIMEOUT_MS,
+                     bool required = false);
+    ReplyEnum lastReply() { return _lastReply; }
+    const char* lastLine() { return _reply; }
+
+    /* Moves the module and SERCOM3 to baud together: "U,<rate>,N", which
+       the module answers at the old rate before switching, then
+       BLUESMIRF_VERIFY_FRAMES loopback frames at the new one. A frame lost
+       or failing its CRC puts both back to BLUESMIRF_BAUD_DEFAULT; so does
+       a failed init(), the module forgets the rate when it is reset */
+    bool setBaud(uint32_t baud);
+    uint32_t baud() { return _baud; }
+
+    /* '~', sequence, BLUESMIRF_LOOP_PAYLOAD bytes, CRC-16/CCITT of both,
+       '#'; the app sends the frame back as it is. Up to
+       BLUESMIRF_LOOP_WINDOW frames are on the way, then '^', baud / 100,
+       echoed, lost, payload bytes/s echoed, '#' reports the run; 16-bit
+       fields MSB first */
+    bool startLoopback(uint16_t frames);
+
+    /* true once after a loopback run or a rate change ended */
+    bool loopbackDone(LoopbackResult& result);
+
     void setAppStatus(int status);
     void setSwitches(bool fan, bool cell);
-    void setTemperature(float temp);
+    /* The status frame temperature, sent as is in 0.1 C; the caller rounds */
+    void setTemperature(DeciCelsius temp);
     void setHumidity(int hum);
 
+    /* '&', status, baseline (0.1 C), gain (0.01 C), tau (s), dead time (s),
+       max cooling rate (0.01 C/min), runs, '#'; 16-bit fields MSB first.
+       Not sent while the module is in command mode or without room for
+       the whole frame in the transmit buffer, returns false */
+    bool sendStepResult(const StepResult& result);
+
+    /* '%', level, count, count x (min, max, mean in 0.01 C, cell %, fan %),
+       '#'; latest bucket first. The frame is longer than the transmit
+       buffer, so it is queued here and written by update() as room frees up */
+    void sendRollups(ROLLUP_LEVEL level);
+
+    /* '!', active alerts (AlertEnum bits), '#'; sent when they change,
+       false as for sendStepResult() */
+    bool sendAlerts(uint8_t alerts);
+
     bool connected();
     CommandEnum command();
-    float temperatureSetpoint() { return (float)_tempSetpoint / 10.0; }
+    DeciCelsius temperatureSetpoint() { return _tempSetpoint; }
 
     bool manual(){ return _manual; }
     void setFan(bool on) { _fan = on; }
@@ -71,15 +165,53 @@ private:
     Proto_WaitSetpointLSB,
     Proto_WaitCommand,
     Proto_WaitOutput,
-    Proto_WaitETX
+    Proto_WaitETX,
+    Proto_Loopback
   } ProtoStatusEnum;
 
-  bool protoUpdate();
+  typedef enum {
+    Link_Idle,
+    Link_Init,
+    Link_Switch,
+    Link_Verify,
+    Link_Fallback,
+    Link_Bench
+  } LinkStepEnum;
+
+  typedef struct {
+    const char* text;
+    const char* reply;
+    uint32_t timeoutMs;
+    bool required;
+  } ModuleCommand;
+
+  typedef enum {
+    Rollup_Idle,
+    Rollup_Header,
+    Rollup_Buckets,
+    Rollup_Trailer
+  } RollupStatusEnum;
+
+  bool receive(bool frames);
+  bool protoUpdate(uint8_t c);
+  void rollupUpdate();
+  static void linkTimeout(uintptr_t context);
+  void replyUpdate(uint8_t c);
+  void commandSend();
+  void commandDone(ReplyEnum reply);
+  static void commandTimeout(uintptr_t context);
+  bool linkUpdate();
+  void serialSetup(uint32_t baud);
+  void loopStart(uint16_t frames);
+  void loopUpdate();
+  void loopEcho();
+  void loopEnd();
+  static void loopTimeout(uintptr_t context);
     
   ProtoStatusEnum _protoStatus;  
   bool _connected;
-  int _temperature;
-  int _tempSetpoint;
+  DeciCelsius _temperature;
+  DeciCelsius _tempSetpoint;
   int _tempTmp;
   int _humidity;
   bool _manual;
@@ -91,7 +223,32 @@ private:
   bool _cellCommand;
   bool _mainsCommand;
   int _appStatus;
-  unsigned long _lastMsgMs;
+  swtimer_t _linkTimer;
+  ModuleCommand _cmdQueue[BLUESMIRF_CMD_QUEUE];
+  uint8_t _cmdHead;
+  uint8_t _cmdCount;
+  swtimer_t _cmdTimer;
+  ReplyEnum _lastReply;
+  char _reply[BLUESMIRF_REPLY_LENGTH];
+  uint8_t _replyLength;
+  LinkStepEnum _linkStep;
+  uint32_t _baud;
+  uint32_t _linkBaud;
+  uint16_t _loopFrames;
+  uint16_t _loopSent;
+  uint16_t _loopEchoed;
+  uint16_t _loopLost;
+  uint32_t _loopStart;
+  uint32_t _loopLast;
+  swtimer_t _loopTimer;
+  uint8_t _loopRx[BLUESMIRF_LOOP_FRAME];
+  uint8_t _loopRxLength;
+  LoopbackResult _loopResult;
+  bool _loopDone;
+  RollupStatusEnum _rollupStatus;
+  ROLLUP_LEVEL _rollupLevel;
+  uint16_t _rollupCount;
+  uint16_t _rollupNext;
 };
 
 #endif /* _BLUESMIRF_H */
@@ -0,0 +1,65 @@
+/* ************************************************************************** */
+/** Board wiring
+
+  @Summary
+    The pins the application drives or polls, as Pin types.
+
+  @Description
+    The group, index and polarity of each pin are written only here. A
+    board with different wiring gets its own block under its own
+    COLDCASE_BOARD value, picked at compile time; nothing of it is left at
+    run time.
+
+    The MHC still configures the pins (direction, pull-up, input buffer)
+    from pin_configurations.csv at PORT_Initialize(). Where the generated
+    PS_ON_PIN and alike are there, the wiring below is checked against
+    them, so the two cannot drift apart unnoticed.
+ */
+/* ************************************************************************** */
+
+#ifndef _BOARD_H    /* Guard against multiple inclusion */
+#define _BOARD_H
+
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include "definitions.h"
+#include "pin.h"
+
+#define COLDCASE_BOARD_V1           1   // SAME51J20A with the click boards of the cold case
+
+#ifndef COLDCASE_BOARD
+#define COLDCASE_BOARD              COLDCASE_BOARD_V1
+#endif
+
+#if COLDCASE_BOARD == COLDCASE_BOARD_V1
+
+typedef Pin<0, 2, PinPolarity::ActiveLow> PsOn;         // PA02, ATX supply on
+typedef Pin<0, 14, PinPolarity::ActiveLow> Led0;        // PA14, user LED
+typedef Pin<0, 18, PinPolarity::ActiveLow> ServoOe;     // PA18, PCA9685 output enable
+typedef Pin<1, 3, PinPolarity::ActiveLow> PsSw;         // PB03, power push button, pulled up
+
+// the servos are on the switched supply, their PWM is enabled with it
+typedef PinSet<PsOn, ServoOe> PsOnServoOe;
+
+#else
+#error "COLDCASE_BOARD is not a known board"
+#endif
+
+// both active low in one group: on() is a single OUTCLR store and off() a
+// single OUTSET store of the same constant mask
+static_assert(PsOnServoOe::mask == (PsOn::mask | ServoOe::mask), "PS_ON and SERVO_OE are not in the set");
+static_assert(PsOnServoOe::activeHigh == 0 && PsOnServoOe::activeLow == PsOnServoOe::mask,
+              "PS_ON and SERVO_OE would not switch in one store");
+
+#ifdef PS_ON_PIN
+static_assert(PsOn::port * 32 + PsOn::index == PS_ON_PIN, "PS_ON is not where the MHC put it");
+static_assert(Led0::port * 32 + Led0::index == LED0_PIN, "LED0 is not where the MHC put it");
+static_assert(ServoOe::port * 32 + ServoOe::index == SERVO_OE_PIN, "SERVO_OE is not where the MHC put it");
+static_assert(PsSw::port * 32 + PsSw::index == PS_SW_PIN, "PS_SW is not where the MHC put it");
+#endif
+
+#endif /* _BOARD_H */
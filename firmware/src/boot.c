@@ -0,0 +1,159 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include <stdio.h>
+#include "swtimer.h"
+#include "boot.h"
+
+/**
+ * @brief Sequencer ctx object definition.
+ */
+typedef struct
+{
+    const boot_step_t *steps;
+    uint8_t count;
+
+    uint32_t started;
+    uint32_t done;
+
+    // swtimer ticks, from base
+    uint32_t base;
+    uint32_t start_tick[ BOOT_MAX_STEPS ];
+    uint32_t done_tick[ BOOT_MAX_STEPS ];
+
+} boot_t;
+
+static boot_t boot_ctx;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static bool all_done_priv ( );
+static uint32_t tenths_priv ( uint32_t ticks );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void boot_start ( const boot_step_t *steps, uint8_t count )
+{
+    boot_ctx.steps = steps;
+    boot_ctx.count = ( count > BOOT_MAX_STEPS ) ? BOOT_MAX_STEPS : count;
+    boot_ctx.started = 0;
+    boot_ctx.done = 0;
+    boot_ctx.base = swtimer_now( );
+
+    boot_task( );
+}
+
+bool boot_task ( )
+{
+    const boot_step_t *step;
+    bool changed = true;
+    uint8_t i;
+
+    // a step that is done at once may let the next ones start in this call
+    while ( changed && !all_done_priv( ) )
+    {
+        changed = false;
+
+        for ( i = 0; i < boot_ctx.count; i++ )
+        {
+            step = &boot_ctx.steps[ i ];
+
+            if ( !( boot_ctx.started & BOOT_STEP( i ) ) )
+            {
+                if ( ( step->after & boot_ctx.done ) != step->after )
+                {
+                    continue;
+                }
+
+                boot_ctx.started |= BOOT_STEP( i );
+                boot_ctx.start_tick[ i ] = swtimer_now( ) - boot_ctx.base;
+                if ( step->start != NULL )
+                {
+                    step->start( );
+                }
+                changed = true;
+            }
+
+            if ( !( boot_ctx.done & BOOT_STEP( i ) ) && ( ( step->ready == NULL ) || step->ready( ) ) )
+            {
+                boot_ctx.done |= BOOT_STEP( i );
+                boot_ctx.done_tick[ i ] = swtimer_now( ) - boot_ctx.base;
+                changed = true;
+            }
+        }
+    }
+
+    return all_done_priv( );
+}
+
+uint32_t boot_elapsed_ms ( )
+{
+    uint32_t end = 0;
+    uint8_t i;
+
+    if ( !all_done_priv( ) )
+    {
+        return tenths_priv( swtimer_now( ) - boot_ctx.base ) / 10;
+    }
+
+    for ( i = 0; i < boot_ctx.count; i++ )
+    {
+        if ( boot_ctx.done_tick[ i ] > end )
+        {
+            end = boot_ctx.done_tick[ i ];
+        }
+    }
+
+    return tenths_priv( end ) / 10;
+}
+
+size_t boot_trace ( uint8_t line, char *buf, size_t len )
+{
+    uint32_t from;
+    uint32_t to;
+    int n;
+
+    if ( line < boot_ctx.count )
+    {
+        from = tenths_priv( boot_ctx.start_tick[ line ] );
+        to = tenths_priv( boot_ctx.done_tick[ line ] );
+        n = snprintf( buf, len, "BOOT %-10s %5lu.%lu .. %5lu.%lu ms %5lu.%lu ms\r\n", boot_ctx.steps[ line ].name,
+                      ( unsigned long )( from / 10 ), ( unsigned long )( from % 10 ),
+                      ( unsigned long )( to / 10 ), ( unsigned long )( to % 10 ),
+                      ( unsigned long )( ( to - from ) / 10 ), ( unsigned long )( ( to - from ) % 10 ) );
+    }
+    else if ( line == boot_ctx.count )
+    {
+        n = snprintf( buf, len, "BOOT done in %lu ms\r\n", ( unsigned long )boot_elapsed_ms( ) );
+    }
+    else
+    {
+        return 0;
+    }
+
+    if ( n < 0 )
+    {
+        return 0;
+    }
+
+    return ( ( size_t )n < len ) ? ( size_t )n : len - 1;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static bool all_done_priv ( )
+{
+    return boot_ctx.done == ( ( 1UL << boot_ctx.count ) - 1 );
+}
+
+static uint32_t tenths_priv ( uint32_t ticks )
+{
+    return ( uint32_t )( ( ( uint64_t )ticks * 10000 ) / SWTIMER_TICK_FREQ );
+}
+
+// ------------------------------------------------------------------------- END
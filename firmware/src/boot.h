@@ -0,0 +1,123 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the boot sequencer.
+ *
+ * The start up is a table of steps, each naming the steps it needs done
+ * first. A step is started as soon as those are done and is done when its
+ * ready function says so, so a step waiting on a device (an oscillator, a
+ * module answering, a servo reaching its position) does not hold up the
+ * steps that do not need it. The waits are timers or readiness flags, the
+ * sequencer never blocks.
+ *
+ * The start and end of every step are recorded from the software timer
+ * clock and can be printed as a boot trace.
+ *
+ * \addtogroup boot Boot Sequencer
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef BOOT_H
+#define BOOT_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+#define BOOT_MAX_STEPS              16
+
+/* Mask of a step, for the after field */
+#define BOOT_STEP(step)             ( 1UL << ( step ) )
+
+/** \} */ // End group macro
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup type Types
+ * \{
+ */
+
+typedef void ( *BOOT_START )( );
+typedef bool ( *BOOT_READY )( );
+
+/**
+ * @brief Boot step, the table is owned by the caller.
+ */
+typedef struct
+{
+    const char *name;
+    uint32_t after;             // BOOT_STEP() of the steps to be done first
+    BOOT_START start;
+    BOOT_READY ready;           // NULL: done when start returns
+
+} boot_step_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Start function.
+ *
+ * @param steps        Step table, kept by the sequencer.
+ * @param count        Number of steps, up to BOOT_MAX_STEPS.
+ *
+ * @description This function starts the steps that need nothing, the
+ * software timers have to be running.
+ */
+void boot_start ( const boot_step_t *steps, uint8_t count );
+
+/**
+ * @brief Task function.
+ *
+ * @returns true once every step is done.
+ *
+ * @description This function ends the steps that are ready and starts the
+ * ones they were holding up, called from the main loop after
+ * swtimer_task().
+ */
+bool boot_task ( );
+
+/**
+ * @brief Elapsed function.
+ *
+ * @returns Time from boot_start() to the end of the last step in ms, or
+ * to now while steps are still running.
+ */
+uint32_t boot_elapsed_ms ( );
+
+/**
+ * @brief Trace function.
+ *
+ * @param line         Step, or the step count for the total.
+ * @param buf          Buffer for the text.
+ * @param len          Size of the buffer.
+ *
+ * @returns Length of the text, 0 past the last line.
+ *
+ * @description The times are in ms from boot_start(): when the step started,
+ * when it was done and how long it took.
+ */
+size_t boot_trace ( uint8_t line, char *buf, size_t len );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _BOOT_H_
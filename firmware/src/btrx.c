@@ -0,0 +1,211 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include "definitions.h"
+#include "swtimer.h"
+#include "btrx.h"
+
+/**
+ * @brief Receiver ctx object definition.
+ */
+typedef struct
+{
+    // stream positions, in bytes from btrx_init(); the one in the buffer is
+    // the position modulo its size
+    uint32_t tail;
+    uint32_t seen;
+
+    // where the line went quiet or bytes were lost
+    uint32_t mark;
+    bool marked;
+
+    volatile uint32_t laps;
+    uint32_t overruns;
+    swtimer_t timer;
+
+} btrx_t;
+
+static btrx_t btrx_ctx;
+
+/* Fetched again by the DMA at every lap, descriptors are 128-bit aligned */
+static dmac_descriptor_registers_t btrx_desc __ALIGNED( 16 );
+static uint8_t btrx_buffer[ BTRX_BUFFER_SIZE ];
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static uint32_t head_priv ( );
+static void lost_priv ( uint32_t head );
+static void lap_priv ( DMAC_TRANSFER_EVENT event, uintptr_t context );
+static void idle_priv ( uintptr_t context );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void btrx_init ( )
+{
+    swtimer_cancel( &btrx_ctx.timer );
+    btrx_ctx.tail = 0;
+    btrx_ctx.seen = 0;
+    btrx_ctx.marked = false;
+    btrx_ctx.laps = 0;
+    btrx_ctx.overruns = 0;
+
+    // the plib interrupt would read DATA before the DMA does
+    SERCOM3_REGS->USART_INT.SERCOM_INTENCLR = ( uint8_t )SERCOM_USART_INT_INTENCLR_RXC_Msk;
+
+    // one block over the whole buffer, linked to itself
+    btrx_desc.DMAC_BTCTRL = ( uint16_t )DMAC_ChannelSettingsGet( DMAC_CHANNEL_1 );
+    btrx_desc.DMAC_BTCNT = BTRX_BUFFER_SIZE;
+    btrx_desc.DMAC_SRCADDR = ( uintptr_t )&SERCOM3_REGS->USART_INT.SERCOM_DATA;
+    // an incremented address is the end of the block
+    btrx_desc.DMAC_DSTADDR = ( uintptr_t )&btrx_buffer[ BTRX_BUFFER_SIZE ];
+    btrx_desc.DMAC_DESCADDR = ( uintptr_t )&btrx_desc;
+
+    DMAC_ChannelCallbackRegister( DMAC_CHANNEL_1, lap_priv, 0 );
+    DMAC_LinkedListTransfer( DMAC_CHANNEL_1, &btrx_desc );
+}
+
+size_t btrx_peek ( const uint8_t **data, bool *idle )
+{
+    uint32_t head = head_priv( );
+    uint32_t end = head;
+    size_t index;
+    size_t count;
+
+    lost_priv( head );
+
+    if ( head != btrx_ctx.seen )
+    {
+        // the idle time runs from the last byte
+        btrx_ctx.seen = head;
+        swtimer_start( &btrx_ctx.timer, BTRX_IDLE_MS, idle_priv, 0 );
+    }
+
+    if ( btrx_ctx.marked && ( ( int32_t )( btrx_ctx.mark - btrx_ctx.tail ) > 0 ) )
+    {
+        end = btrx_ctx.mark;
+    }
+
+    index = btrx_ctx.tail % BTRX_BUFFER_SIZE;
+    count = end - btrx_ctx.tail;
+    if ( count > BTRX_BUFFER_SIZE - index )
+    {
+        count = BTRX_BUFFER_SIZE - index;
+    }
+
+    *data = &btrx_buffer[ index ];
+    if ( idle != NULL )
+    {
+        *idle = btrx_ctx.marked && ( btrx_ctx.tail == btrx_ctx.mark );
+    }
+
+    return count;
+}
+
+void btrx_consume ( size_t count )
+{
+    btrx_ctx.tail += count;
+
+    if ( btrx_ctx.marked && ( ( int32_t )( btrx_ctx.tail - btrx_ctx.mark ) > 0 ) )
+    {
+        btrx_ctx.marked = false;
+    }
+}
+
+uint32_t btrx_received ( )
+{
+    return head_priv( );
+}
+
+uint32_t btrx_overruns ( )
+{
+    return btrx_ctx.overruns;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static uint32_t head_priv ( )
+{
+    uint32_t laps;
+    uint16_t count;
+    bool pending;
+    bool irq;
+
+    irq = NVIC_INT_Disable( );
+    laps = btrx_ctx.laps;
+
+    // with the lap interrupt pending the count is either the whole block
+    // or already from the next lap, both right past the lap; the lap may end
+    // between the two reads
+    do
+    {
+        pending = ( DMAC_ChannelTransferStatusGet( DMAC_CHANNEL_1 ) == DMAC_TRANSFER_EVENT_COMPLETE );
+        count = DMAC_ChannelGetTransferredCount( DMAC_CHANNEL_1 );
+    }
+    while ( !pending && ( DMAC_ChannelTransferStatusGet( DMAC_CHANNEL_1 ) == DMAC_TRANSFER_EVENT_COMPLETE ) );
+
+    NVIC_INT_Restore( irq );
+
+    if ( pending )
+    {
+        laps++;
+    }
+
+    return laps * BTRX_BUFFER_SIZE + ( count % BTRX_BUFFER_SIZE );
+}
+
+static void lost_priv ( uint32_t head )
+{
+    USART_ERROR error = SERCOM3_USART_ErrorGet( );
+
+    // only the last lap is still in the buffer
+    if ( head - btrx_ctx.tail > BTRX_BUFFER_SIZE )
+    {
+        btrx_ctx.overruns += head - btrx_ctx.tail - BTRX_BUFFER_SIZE;
+        btrx_ctx.tail = head - BTRX_BUFFER_SIZE;
+        btrx_ctx.mark = btrx_ctx.tail;
+        btrx_ctx.marked = true;
+    }
+
+    // the plib drops the bytes in error, the USART does not say how many
+    // it overran
+    if ( error != USART_ERROR_NONE )
+    {
+        if ( ( error & USART_ERROR_OVERRUN ) != 0 )
+        {
+            btrx_ctx.overruns++;
+        }
+        btrx_ctx.mark = head;
+        btrx_ctx.marked = true;
+    }
+}
+
+static void lap_priv ( DMAC_TRANSFER_EVENT event, uintptr_t context )
+{
+    if ( event == DMAC_TRANSFER_EVENT_COMPLETE )
+    {
+        btrx_ctx.laps++;
+    }
+}
+
+static void idle_priv ( uintptr_t context )
+{
+    uint32_t head = head_priv( );
+
+    if ( head != btrx_ctx.seen )
+    {
+        // not peeked since, the line is still busy
+        btrx_ctx.seen = head;
+        swtimer_start( &btrx_ctx.timer, BTRX_IDLE_MS, idle_priv, 0 );
+        return;
+    }
+
+    btrx_ctx.mark = head;
+    btrx_ctx.marked = true;
+}
+
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,108 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the Bluetooth UART receiver.
+ *
+ * SERCOM3 receives by DMA: channel 1 moves every byte from the DATA register
+ * into a circular buffer, its descriptor links to itself so the transfer
+ * never ends and the core takes no interrupt per byte, only one per lap of
+ * the buffer. The write position is read back from the DMA write-back
+ * descriptor.
+ *
+ * The bytes are parsed where the DMA left them: btrx_peek() gives the
+ * longest run that is contiguous in the buffer and btrx_consume() releases
+ * it. A line quiet for BTRX_IDLE_MS ends a burst, the first bytes after it
+ * are flagged so a parser can drop a frame that was cut short.
+ *
+ * The bytes have to be consumed before the DMA laps them: the ones it has
+ * written over are counted as overruns and skipped, as the bytes the
+ * USART itself lost.
+ *
+ * \addtogroup btrx Bluetooth UART Receiver
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef BTRX_H
+#define BTRX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+/* About 90 ms of line at 115200, 22 ms at 460800 */
+#define BTRX_BUFFER_SIZE            1024
+
+/* A frame from the app arrives in one burst, a gap this long ends it */
+#define BTRX_IDLE_MS                10
+
+/** \} */ // End group macro
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Initialization function.
+ *
+ * @description This function takes the receive side of SERCOM3 from the
+ * plib ring buffer, whose interrupt it disables, and starts the DMA. The
+ * software timers have to be running.
+ */
+void btrx_init ( );
+
+/**
+ * @brief Peek function.
+ *
+ * @param data         Set to the first byte not consumed yet.
+ * @param idle         Set when the line was quiet, or bytes were lost,
+ *                     just before that byte; NULL if not needed.
+ *
+ * @returns Number of bytes from data that can be read, 0 if none.
+ *
+ * @description The run stops at the end of the buffer and where the line
+ * went quiet, the rest is returned by the next call.
+ */
+size_t btrx_peek ( const uint8_t **data, bool *idle );
+
+/**
+ * @brief Consume function.
+ *
+ * @param count        Bytes done with, up to what btrx_peek() returned.
+ */
+void btrx_consume ( size_t count );
+
+/**
+ * @brief Received function.
+ *
+ * @returns Bytes received since btrx_init().
+ */
+uint32_t btrx_received ( );
+
+/**
+ * @brief Overruns function.
+ *
+ * @returns Bytes lost since btrx_init(), written over in the buffer or
+ * overrun in the USART.
+ */
+uint32_t btrx_overruns ( );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _BTRX_H_
@@ -0,0 +1,116 @@
+/* ************************************************************************** */
+/** Fixed-point temperature
+
+  @Summary
+    A temperature as an integer count of 1/PerDegree C, with the scale in
+    the type.
+
+  @Description
+    The sensor filters, the rollups and the control loop work in 0.01 C
+    (CentiCelsius), the Bluetooth protocol and the setpoint in 0.1 C
+    (DeciCelsius), the model residual in 0.001 C (MilliCelsius). The state
+    of a slow low pass is a FilterCelsius, 1/65536 of 0.01 C: a step of
+    dt/tau of a small difference is not lost to the rounding. Mixing them
+    up does not compile: a value changes scale only through to<>(), which
+    rounds half away from zero. Comparisons between scales are exact, so
+    a reading is compared with the setpoint without converting either.
+
+    Sums and differences saturate at the int32_t range instead of wrapping.
+    Everything is inline, no float is involved but in fromFloat() and
+    toFloat(), for the model fit and the reports that work in float.
+ */
+/* ************************************************************************** */
+
+#ifndef _CELSIUS_H    /* Guard against multiple inclusion */
+#define _CELSIUS_H
+
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <stdint.h>
+
+template <int32_t PerDegree>
+class FixedCelsius
+{
+    static_assert(PerDegree > 0, "the scale has to be positive");
+
+public:
+    static constexpr int32_t perDegree = PerDegree;
+
+    constexpr FixedCelsius() : _v(0) {}
+
+    static constexpr FixedCelsius fromRaw(int32_t v) { return FixedCelsius(v); }
+    static constexpr FixedCelsius fromDegrees(int32_t c) { return FixedCelsius(saturate((int64_t)c * PerDegree)); }
+    static constexpr FixedCelsius fromFloat(float c)
+    {
+        return FixedCelsius(saturate((int64_t)(c * PerDegree + ((c < 0.0f)? -0.5f : 0.5f))));
+    }
+
+    constexpr int32_t raw() const { return _v; }
+    constexpr float toFloat() const { return (float)_v / (float)PerDegree; }
+
+    template <int32_t To>
+    constexpr FixedCelsius<To> to() const
+    {
+        return FixedCelsius<To>::fromRaw(saturate(divRound((int64_t)_v * To, PerDegree)));
+    }
+
+    constexpr FixedCelsius operator+(FixedCelsius o) const { return FixedCelsius(saturate((int64_t)_v + o._v)); }
+    constexpr FixedCelsius operator-(FixedCelsius o) const { return FixedCelsius(saturate((int64_t)_v - o._v)); }
+    constexpr FixedCelsius operator-() const { return FixedCelsius(saturate(-(int64_t)_v)); }
+    constexpr FixedCelsius operator*(int32_t k) const { return FixedCelsius(saturate((int64_t)_v * k)); }
+
+    FixedCelsius& operator+=(FixedCelsius o) { return *this = *this + o; }
+    FixedCelsius& operator-=(FixedCelsius o) { return *this = *this - o; }
+
+    // this * num / den in 64 bits, rounded, den > 0; e.g. a difference into a rate
+    constexpr FixedCelsius scaled(int32_t num, int32_t den) const
+    {
+        return FixedCelsius(saturate(divRound((int64_t)_v * num, den)));
+    }
+
+    // one step of a first order low pass of time constant tauMs towards x,
+    // dtMs after the previous one; a step as long as tauMs lands on x
+    template <int32_t P>
+    FixedCelsius& follow(FixedCelsius<P> x, uint32_t dtMs, uint32_t tauMs)
+    {
+        FixedCelsius d = x.template to<PerDegree>() - *this;
+        return *this += (dtMs < tauMs)? d.scaled((int32_t)dtMs, (int32_t)tauMs) : d;
+    }
+
+    // exact between scales: both sides are brought to the product of the two
+    template <int32_t P>
+    constexpr int64_t compare(FixedCelsius<P> o) const { return (int64_t)_v * P - (int64_t)o.raw() * PerDegree; }
+
+    template <int32_t P> constexpr bool operator==(FixedCelsius<P> o) const { return compare(o) == 0; }
+    template <int32_t P> constexpr bool operator!=(FixedCelsius<P> o) const { return compare(o) != 0; }
+    template <int32_t P> constexpr bool operator<(FixedCelsius<P> o) const { return compare(o) < 0; }
+    template <int32_t P> constexpr bool operator<=(FixedCelsius<P> o) const { return compare(o) <= 0; }
+    template <int32_t P> constexpr bool operator>(FixedCelsius<P> o) const { return compare(o) > 0; }
+    template <int32_t P> constexpr bool operator>=(FixedCelsius<P> o) const { return compare(o) >= 0; }
+
+private:
+    constexpr explicit FixedCelsius(int32_t v) : _v(v) {}
+
+    static constexpr int32_t saturate(int64_t v)
+    {
+        return (v > INT32_MAX)? INT32_MAX : ((v < INT32_MIN)? INT32_MIN : (int32_t)v);
+    }
+
+    static constexpr int64_t divRound(int64_t n, int64_t d)
+    {
+        return (n < 0)? -((-n + d / 2) / d) : (n + d / 2) / d;
+    }
+
+    int32_t _v;
+};
+
+typedef FixedCelsius<10> DeciCelsius;
+typedef FixedCelsius<100> CentiCelsius;
+typedef FixedCelsius<1000> MilliCelsius;
+typedef FixedCelsius<6553600> FilterCelsius;   // +-327 C
+
+#endif /* _CELSIUS_H */
@@ -68,6 +68,7 @@ void SysTick_Handler (void);
 void RTC_InterruptHandler (void);
 void EIC_EXTINT_15_InterruptHandler (void);
 void DMAC_0_InterruptHandler (void);
+void DMAC_1_InterruptHandler (void);
 void SERCOM0_I2C_InterruptHandler (void);
 void SERCOM2_I2C_InterruptHandler (void);
 void SERCOM3_USART_InterruptHandler (void);
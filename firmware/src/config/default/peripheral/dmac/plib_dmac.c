@@ -44,6 +44,7 @@
 *******************************************************************************/
 // DOM-IGNORE-END
 
+#include <string.h>
 #include "plib_dmac.h"
 #include "interrupts.h"
 
@@ -54,7 +55,7 @@
 // *****************************************************************************
 // *****************************************************************************
 
-#define DMAC_CHANNELS_NUMBER        (1U)
+#define DMAC_CHANNELS_NUMBER        (5U)
 
 #define DMAC_CRC_CHANNEL_OFFSET     (0x20U)
 
@@ -120,6 +121,50 @@ void DMAC_Initialize( void )
 
    DMAC_REGS->CHANNEL[0].DMAC_CHINTENSET = (DMAC_CHINTENSET_TERR_Msk | DMAC_CHINTENSET_TCMPL_Msk);
 
+   /***************** Configure DMA channel 1 ********************/
+   DMAC_REGS->CHANNEL[1].DMAC_CHCTRLA = DMAC_CHCTRLA_TRIGACT(2U) | DMAC_CHCTRLA_TRIGSRC(10U) | DMAC_CHCTRLA_THRESHOLD(0U) | DMAC_CHCTRLA_BURSTLEN(0U) ;
+
+   descriptor_section[1].DMAC_BTCTRL = DMAC_BTCTRL_BLOCKACT_INT | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_DSTINC_Msk ;
+
+   DMAC_REGS->CHANNEL[1].DMAC_CHPRILVL = DMAC_CHPRILVL_PRILVL(1U);
+
+   dmacChannelObj[1].inUse = true;
+
+   DMAC_REGS->CHANNEL[1].DMAC_CHINTENSET = (DMAC_CHINTENSET_TERR_Msk | DMAC_CHINTENSET_TCMPL_Msk);
+
+   /***************** Configure DMA channel 2 ********************/
+   DMAC_REGS->CHANNEL[2].DMAC_CHCTRLA = DMAC_CHCTRLA_TRIGACT(2U) | DMAC_CHCTRLA_TRIGSRC(0U) | DMAC_CHCTRLA_THRESHOLD(0U) | DMAC_CHCTRLA_BURSTLEN(0U) ;
+
+   descriptor_section[2].DMAC_BTCTRL = DMAC_BTCTRL_BLOCKACT_NOACT | DMAC_BTCTRL_BEATSIZE_WORD | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_SRCINC_Msk ;
+
+   DMAC_REGS->CHANNEL[2].DMAC_CHPRILVL = DMAC_CHPRILVL_PRILVL(0U);
+
+   DMAC_REGS->CHANNEL[2].DMAC_CHEVCTRL = (uint8_t)(DMAC_CHEVCTRL_EVACT_TRIG | DMAC_CHEVCTRL_EVIE_Msk);
+
+   dmacChannelObj[2].inUse = true;
+
+   /***************** Configure DMA channel 3 ********************/
+   DMAC_REGS->CHANNEL[3].DMAC_CHCTRLA = DMAC_CHCTRLA_TRIGACT(2U) | DMAC_CHCTRLA_TRIGSRC(0U) | DMAC_CHCTRLA_THRESHOLD(0U) | DMAC_CHCTRLA_BURSTLEN(0U) ;
+
+   descriptor_section[3].DMAC_BTCTRL = DMAC_BTCTRL_BLOCKACT_NOACT | DMAC_BTCTRL_BEATSIZE_WORD | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_SRCINC_Msk ;
+
+   DMAC_REGS->CHANNEL[3].DMAC_CHPRILVL = DMAC_CHPRILVL_PRILVL(0U);
+
+   DMAC_REGS->CHANNEL[3].DMAC_CHEVCTRL = (uint8_t)(DMAC_CHEVCTRL_EVACT_TRIG | DMAC_CHEVCTRL_EVIE_Msk);
+
+   dmacChannelObj[3].inUse = true;
+
+   /***************** Configure DMA channel 4 ********************/
+   DMAC_REGS->CHANNEL[4].DMAC_CHCTRLA = DMAC_CHCTRLA_TRIGACT(2U) | DMAC_CHCTRLA_TRIGSRC(0U) | DMAC_CHCTRLA_THRESHOLD(0U) | DMAC_CHCTRLA_BURSTLEN(0U) ;
+
+   descriptor_section[4].DMAC_BTCTRL = DMAC_BTCTRL_BLOCKACT_NOACT | DMAC_BTCTRL_BEATSIZE_WORD | DMAC_BTCTRL_VALID_Msk | DMAC_BTCTRL_SRCINC_Msk ;
+
+   DMAC_REGS->CHANNEL[4].DMAC_CHPRILVL = DMAC_CHPRILVL_PRILVL(0U);
+
+   DMAC_REGS->CHANNEL[4].DMAC_CHEVCTRL = (uint8_t)(DMAC_CHEVCTRL_EVACT_TRIG | DMAC_CHEVCTRL_EVIE_Msk);
+
+   dmacChannelObj[4].inUse = true;
+
     /* Enable the DMAC module & Priority Level x Enable */
     DMAC_REGS->DMAC_CTRL = DMAC_CTRL_DMAENABLE_Msk | DMAC_CTRL_LVLEN0_Msk | DMAC_CTRL_LVLEN1_Msk | DMAC_CTRL_LVLEN2_Msk | DMAC_CTRL_LVLEN3_Msk;
 }
@@ -195,6 +240,40 @@ bool DMAC_ChannelTransfer( DMAC_CHANNEL channel, const void *srcAddr, const void
     return returnStatus;
 }
 
+/*******************************************************************************
+    This function submit a list of DMA transfers.
+********************************************************************************/
+
+bool DMAC_LinkedListTransfer (DMAC_CHANNEL channel, dmac_descriptor_registers_t* channelDesc)
+{
+    bool returnStatus = false;
+
+    if ((!dmacChannelObj[channel].isBusy) || ((DMAC_REGS->CHANNEL[channel].DMAC_CHINTFLAG & (DMAC_CHINTENCLR_TCMPL_Msk | DMAC_CHINTENCLR_TERR_Msk)) != 0U))
+    {
+        /* Clear the transfer complete flag */
+        DMAC_REGS->CHANNEL[channel].DMAC_CHINTFLAG = DMAC_CHINTENCLR_TCMPL_Msk | DMAC_CHINTENCLR_TERR_Msk;
+
+        dmacChannelObj[channel].isBusy = true;
+
+        (void) memcpy(&descriptor_section[channel], channelDesc, sizeof(dmac_descriptor_registers_t));
+
+        /* Enable the channel */
+        DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA |= DMAC_CHCTRLA_ENABLE_Msk;
+
+        /* Verify if Trigger source is Software Trigger */
+        if ((((DMAC_REGS->CHANNEL[channel].DMAC_CHCTRLA & DMAC_CHCTRLA_TRIGSRC_Msk) >> DMAC_CHCTRLA_TRIGSRC_Pos) == 0x00U)
+                                                && (((DMAC_REGS->CHANNEL[channel].DMAC_CHEVCTRL & DMAC_CHEVCTRL_EVIE_Msk)) != DMAC_CHEVCTRL_EVIE_Msk))
+        {
+            /* Trigger the DMA transfer */
+            DMAC_REGS->DMAC_SWTRIGCTRL |= ((uint32_t)1U << channel);
+        }
+
+        returnStatus = true;
+    }
+
+    return returnStatus;
+}
+
 /*******************************************************************************
     This function returns the status of the channel.
 ********************************************************************************/
@@ -478,3 +557,7 @@ void DMAC_0_InterruptHandler( void )
    DMAC_channel_interruptHandler(0U);
 }
 
+void DMAC_1_InterruptHandler( void )
+{
+   DMAC_channel_interruptHandler(1U);
+}
@@ -47,6 +47,12 @@
 void EVSYS_Initialize( void )
 {
     /*Event Channel User Configuration*/
+    EVSYS_REGS->EVSYS_USER[7] = EVSYS_USER_CHANNEL(0x1UL);
+    EVSYS_REGS->EVSYS_USER[8] = EVSYS_USER_CHANNEL(0x1UL);
+    EVSYS_REGS->EVSYS_USER[9] = EVSYS_USER_CHANNEL(0x1UL);
+
+    /* Event Channel 0 Configuration */
+    EVSYS_REGS->CHANNEL[0].EVSYS_CHANNEL = EVSYS_CHANNEL_EVGEN(6UL) | EVSYS_CHANNEL_PATH(2UL) | EVSYS_CHANNEL_EDGSEL(0UL) ;
 
 }
 
@@ -65,6 +65,8 @@ void NVIC_Initialize( void )
     NVIC_EnableIRQ(EIC_EXTINT_15_IRQn);
     NVIC_SetPriority(DMAC_0_IRQn, 7);
     NVIC_EnableIRQ(DMAC_0_IRQn);
+    NVIC_SetPriority(DMAC_1_IRQn, 7);
+    NVIC_EnableIRQ(DMAC_1_IRQn);
     NVIC_SetPriority(SERCOM0_0_IRQn, 7);
     NVIC_EnableIRQ(SERCOM0_0_IRQn);
     NVIC_SetPriority(SERCOM0_1_IRQn, 7);
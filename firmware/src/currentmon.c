@@ -0,0 +1,297 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include <stddef.h>
+#include "definitions.h"
+#include "servo.h"
+#include "swtimer.h"
+#include "filter.h"
+#include "currentmon.h"
+
+/* No conversion selected yet: the first result is the power-up one */
+#define CURRENTMON_NONE             0xFF
+
+/* The software timers count from the current tick, 2 ms cover the part of
+   it already gone */
+#define CURRENTMON_WAIT_MS          ( SERVO_LTC2497_CONVERSION_MS + 2 )
+
+/**
+ * @brief Load wiring and limits.
+ */
+typedef struct
+{
+    uint8_t channel;            // LTC2497 single-ended input
+    uint16_t uv_per_ma;         // sense resistor times amplifier gain
+    uint16_t supply_mv;
+    uint16_t on_ma;             // at least this much when on, 0 not checked
+    uint16_t off_ma;            // at most this much when off
+
+} currentmon_load_t;
+
+/**
+ * @brief Monitor ctx object definition.
+ */
+typedef struct
+{
+    filter_t filter[ CURRENTMON_LOADS ];
+    int32_t current_ma[ CURRENTMON_LOADS ];
+    uint64_t energy_nj[ CURRENTMON_LOADS ];
+    uint32_t last_tick[ CURRENTMON_LOADS ];
+    bool sampled[ CURRENTMON_LOADS ];
+
+    bool commanded[ CURRENTMON_LOADS ];
+    uint32_t settle_tick[ CURRENTMON_LOADS ];
+    uint32_t wrong_tick[ CURRENTMON_LOADS ];
+    bool wrong[ CURRENTMON_LOADS ];
+    uint8_t mismatch;
+
+    // the transfer collects the conversion of one load and starts the next
+    uint8_t converting;
+    uint8_t next;
+    uint8_t focus;
+    CURRENTMON_CALLBACK callback;
+    uintptr_t context;
+    uint8_t rx[ SERVO_LTC2497_READ_LEN ];
+    volatile bool reading;
+    volatile bool done;
+    volatile bool nack;
+    swtimer_t timer;
+
+} currentmon_t;
+
+static currentmon_t currentmon_ctx;
+
+/* The door servo on the Click sense resistor of its output, 0.1 ohm; the
+   12 V cell and fan lines through 10 mohm shunts and gain 20 amplifiers,
+   wired to the inputs of the unused outputs 13 and 14 */
+static const currentmon_load_t currentmon_loads[ CURRENTMON_LOADS ] =
+{
+    { SERVO_POSITIVE_CH12, 200, 12000, 1000, 300 },
+    { SERVO_POSITIVE_CH13, 200, 12000, 50, 25 },
+    { SERVO_POSITIVE_CH15, 100, 5000, 0, 400 },
+};
+
+/* Median of 3 drops the reading taken while a servo moves, alpha 1/2 */
+static const filter_cfg_t currentmon_filter_cfg = { 1, 3, FILTER_SMOOTH_EMA, 1, { 0 } };
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static void start_priv ( uintptr_t context );
+static void transfer_priv ( uintptr_t context );
+static void sample_priv ( uint8_t load, int32_t uv );
+static void check_priv ( uint8_t load, uint32_t now );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void currentmon_init ( )
+{
+    uint8_t load;
+
+    for ( load = 0; load < CURRENTMON_LOADS; load++ )
+    {
+        filter_init( &currentmon_ctx.filter[ load ], &currentmon_filter_cfg );
+        currentmon_ctx.current_ma[ load ] = 0;
+        currentmon_ctx.energy_nj[ load ] = 0;
+        currentmon_ctx.sampled[ load ] = false;
+        currentmon_ctx.commanded[ load ] = false;
+        currentmon_ctx.settle_tick[ load ] = swtimer_now( );
+        currentmon_ctx.wrong[ load ] = false;
+    }
+    currentmon_ctx.mismatch = 0;
+
+    currentmon_ctx.converting = CURRENTMON_NONE;
+    currentmon_ctx.next = 0;
+    currentmon_ctx.focus = CURRENTMON_LOADS;
+    currentmon_ctx.callback = NULL;
+    currentmon_ctx.reading = false;
+    currentmon_ctx.done = false;
+
+    // the other users of the bus wait for their transfers, only ours call back
+    SERCOM2_I2C_CallbackRegister( transfer_priv, 0 );
+
+    // a conversion starts at power up, it may be under way
+    swtimer_start( &currentmon_ctx.timer, CURRENTMON_WAIT_MS, start_priv, 0 );
+}
+
+void currentmon_task ( )
+{
+    if ( !currentmon_ctx.done )
+    {
+        return;
+    }
+
+    currentmon_ctx.done = false;
+
+    // still converting, the next input was not selected either
+    if ( currentmon_ctx.nack )
+    {
+        swtimer_start( &currentmon_ctx.timer, CURRENTMON_RETRY_MS, start_priv, 0 );
+        return;
+    }
+
+    if ( currentmon_ctx.converting != CURRENTMON_NONE )
+    {
+        sample_priv( currentmon_ctx.converting, servo_ltc2497_to_uv( currentmon_ctx.rx ) );
+    }
+
+    currentmon_ctx.converting = currentmon_ctx.next;
+    if ( currentmon_ctx.focus < CURRENTMON_LOADS )
+    {
+        currentmon_ctx.next = currentmon_ctx.focus;
+    }
+    else
+    {
+        currentmon_ctx.next = ( currentmon_ctx.next + 1 ) % CURRENTMON_LOADS;
+    }
+
+    swtimer_start( &currentmon_ctx.timer, CURRENTMON_WAIT_MS, start_priv, 0 );
+}
+
+void currentmon_set_commanded ( CURRENTMON_LOAD load, bool on )
+{
+    if ( currentmon_ctx.commanded[ load ] == on )
+    {
+        return;
+    }
+
+    // the mismatch stays until a reading settled on the new command says so
+    currentmon_ctx.commanded[ load ] = on;
+    currentmon_ctx.settle_tick[ load ] = swtimer_now( ) + swtimer_ms_to_ticks( CURRENTMON_SETTLE_MS );
+    currentmon_ctx.wrong[ load ] = false;
+}
+
+int32_t currentmon_current_ma ( CURRENTMON_LOAD load )
+{
+    return currentmon_ctx.current_ma[ load ];
+}
+
+uint32_t currentmon_energy_j ( CURRENTMON_LOAD load )
+{
+    return ( uint32_t )( currentmon_ctx.energy_nj[ load ] / 1000000000ULL );
+}
+
+void currentmon_focus ( CURRENTMON_LOAD load )
+{
+    currentmon_ctx.focus = load;
+
+    // the next transfer selects it, unless it is already on its way
+    if ( ( load < CURRENTMON_LOADS ) && !currentmon_ctx.reading && !currentmon_ctx.done )
+    {
+        currentmon_ctx.next = load;
+    }
+}
+
+void currentmon_set_callback ( CURRENTMON_CALLBACK callback, uintptr_t context )
+{
+    currentmon_ctx.callback = NULL;
+    currentmon_ctx.context = context;
+    currentmon_ctx.callback = callback;
+}
+
+uint8_t currentmon_mismatch ( )
+{
+    return currentmon_ctx.mismatch;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void start_priv ( uintptr_t context )
+{
+    const currentmon_load_t *l = &currentmon_loads[ currentmon_ctx.next ];
+
+    // mark it first, the end of the transfer may come before the call returns
+    currentmon_ctx.reading = true;
+    if ( !servo_start_read_of_ltc2497( l->channel, currentmon_ctx.rx, SERVO_LTC2497_READ_LEN ) )
+    {
+        currentmon_ctx.reading = false;
+        swtimer_start( &currentmon_ctx.timer, CURRENTMON_RETRY_MS, start_priv, 0 );
+    }
+}
+
+static void transfer_priv ( uintptr_t context )
+{
+    // interrupt context; the servo writes that follow ours call back too
+    if ( currentmon_ctx.reading )
+    {
+        currentmon_ctx.nack = ( SERCOM2_I2C_ErrorGet( ) != SERCOM_I2C_ERROR_NONE );
+        currentmon_ctx.reading = false;
+        currentmon_ctx.done = true;
+    }
+}
+
+static void sample_priv ( uint8_t load, int32_t uv )
+{
+    const currentmon_load_t *l = &currentmon_loads[ load ];
+    uint32_t now = swtimer_now( );
+    uint32_t dt_ms;
+    int32_t ma = uv / ( int32_t )l->uv_per_ma;
+
+    if ( ma < 0 )
+    {
+        ma = 0;
+    }
+
+    // mA times mV is uW, times ms is nJ
+    if ( currentmon_ctx.sampled[ load ] )
+    {
+        dt_ms = ( uint32_t )( ( ( uint64_t )( now - currentmon_ctx.last_tick[ load ] ) * 1000 ) / SWTIMER_TICK_FREQ );
+        currentmon_ctx.energy_nj[ load ] += ( uint64_t )ma * l->supply_mv * dt_ms;
+    }
+    currentmon_ctx.last_tick[ load ] = now;
+    currentmon_ctx.sampled[ load ] = true;
+
+    filter_push( &currentmon_ctx.filter[ load ], ma, &currentmon_ctx.current_ma[ load ] );
+
+    check_priv( load, now );
+
+    if ( currentmon_ctx.callback != NULL )
+    {
+        currentmon_ctx.callback( ( CURRENTMON_LOAD )load, ma, currentmon_ctx.context );
+    }
+}
+
+static void check_priv ( uint8_t load, uint32_t now )
+{
+    const currentmon_load_t *l = &currentmon_loads[ load ];
+    int32_t ma = currentmon_ctx.current_ma[ load ];
+    bool wrong;
+
+    if ( ( int32_t )( now - currentmon_ctx.settle_tick[ load ] ) < 0 )
+    {
+        return;
+    }
+
+    if ( currentmon_ctx.commanded[ load ] )
+    {
+        wrong = ( l->on_ma != 0 ) && ( ma < l->on_ma );
+    }
+    else
+    {
+        wrong = ( ma > l->off_ma );
+    }
+
+    if ( !wrong )
+    {
+        currentmon_ctx.wrong[ load ] = false;
+        currentmon_ctx.mismatch &= ~( 1 << load );
+        return;
+    }
+
+    if ( !currentmon_ctx.wrong[ load ] )
+    {
+        currentmon_ctx.wrong[ load ] = true;
+        currentmon_ctx.wrong_tick[ load ] = now;
+    }
+
+    if ( now - currentmon_ctx.wrong_tick[ load ] >= swtimer_ms_to_ticks( CURRENTMON_MISMATCH_MS ) )
+    {
+        currentmon_ctx.mismatch |= ( 1 << load );
+    }
+}
+
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,154 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the background load current monitor.
+ *
+ * The LTC2497 on the Servo Click converts one input at a time in about
+ * 150 ms and holds the bus off until it is done. The monitor cycles through
+ * the loads from the main loop without waiting for it: a software timer
+ * covers the conversion, the transfer that collects the result also selects
+ * the next input and its end is signalled by the SERCOM2 interrupt.
+ *
+ * A load can be given every conversion for a while, the door servo during a
+ * move: its readings then come every 150 ms and go to a callback as they
+ * are collected, so the caller reacts within a conversion.
+ *
+ * Every load has its readings filtered, the energy it drew integrated, and
+ * the current compared with what it was commanded to do: a cell or fan that
+ * is switched on and draws nothing, or the other way round, is reported as
+ * a mismatch within a few seconds instead of when the temperature shows it.
+ *
+ * \addtogroup currentmon Load Current Monitor
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef CURRENTMON_H
+#define CURRENTMON_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+/* A command has to settle, rocker servo and filter, before it is checked */
+#define CURRENTMON_SETTLE_MS        3000
+#define CURRENTMON_MISMATCH_MS      2000
+
+/* Retry after a NACK or with the bus taken by a servo write */
+#define CURRENTMON_RETRY_MS         5
+
+/** \} */ // End group macro
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup type Types
+ * \{
+ */
+
+typedef enum
+{
+    CURRENTMON_LOAD_CELL = 0,
+    CURRENTMON_LOAD_FAN,
+    CURRENTMON_LOAD_DOOR,
+    CURRENTMON_LOADS
+
+} CURRENTMON_LOAD;
+
+/**
+ * @brief Reading callback, called from currentmon_task() with every new
+ * unfiltered reading in mA.
+ */
+typedef void ( *CURRENTMON_CALLBACK )( CURRENTMON_LOAD load, int32_t ma, uintptr_t context );
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Initialization function.
+ *
+ * @description This function clears the readings and the counters and
+ * starts the acquisition, servo_init() has to be called first.
+ */
+void currentmon_init ( );
+
+/**
+ * @brief Task function.
+ *
+ * @description This function collects a completed conversion, called from
+ * the main loop after swtimer_task(). It never waits for the converter.
+ */
+void currentmon_task ( );
+
+/**
+ * @brief Command function.
+ *
+ * @param load         Load.
+ * @param on           true if the load should be drawing current.
+ */
+void currentmon_set_commanded ( CURRENTMON_LOAD load, bool on );
+
+/**
+ * @brief Current function.
+ *
+ * @param load         Load.
+ *
+ * @returns Filtered current in mA, 0 until the first reading.
+ */
+int32_t currentmon_current_ma ( CURRENTMON_LOAD load );
+
+/**
+ * @brief Energy function.
+ *
+ * @param load         Load.
+ *
+ * @returns Energy drawn since currentmon_init(), in J.
+ */
+uint32_t currentmon_energy_j ( CURRENTMON_LOAD load );
+
+/**
+ * @brief Focus function.
+ *
+ * @param load         Load converted every time, CURRENTMON_LOADS to go
+ *                     back to cycling through all of them.
+ *
+ * @description The conversion under way is not affected, the change applies
+ * from the next one.
+ */
+void currentmon_focus ( CURRENTMON_LOAD load );
+
+/**
+ * @brief Callback function.
+ *
+ * @param callback     Called with every new reading, NULL to stop.
+ * @param context      Passed to the callback.
+ */
+void currentmon_set_callback ( CURRENTMON_CALLBACK callback, uintptr_t context );
+
+/**
+ * @brief Mismatch function.
+ *
+ * @returns Mask of the loads whose current disagrees with the command,
+ * 1 << CURRENTMON_LOAD_x.
+ */
+uint8_t currentmon_mismatch ( );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _CURRENTMON_H_
@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/** Door servo
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <stddef.h>
+#include "door.h"
+#include "servo.h"
+
+Door::Door()
+{
+    _motor = 0;
+    _closedPos = 0;
+    _openPos = 0;
+    _target = 0;
+    _readingPos = 0;
+    _moving = false;
+    _finished = false;
+    _stalled = false;
+    _stallMa = 0;
+}
+
+void Door::init(uint8_t motor, uint8_t closedPos, uint8_t openPos)
+{
+    _motor = motor;
+    _closedPos = closedPos;
+    _openPos = openPos;
+    _target = closedPos;
+
+    motion_axis_init(&_axis, _motor, closedPos, DOOR_SPEED_DPS, DOOR_ACCEL_DPS2);
+}
+
+void Door::setSpeed(float speed, float accel)
+{
+    motion_set_limits(&_axis, speed, accel);
+}
+
+void Door::move(bool open)
+{
+    _target = open? _openPos : _closedPos;
+    _stalled = false;
+    _stallMa = 0;
+
+    // nothing to do, the move is over already
+    if (!_moving && motion_position(&_axis) == _target)
+    {
+        _finished = true;
+        return;
+    }
+
+    // a move under way brakes and turns around
+    motion_move(&_axis, _target);
+
+    if (!_moving)
+    {
+        _moving = true;
+        _readingPos = motion_position(&_axis);
+        currentmon_set_commanded(CURRENTMON_LOAD_DOOR, true);
+        currentmon_set_callback(currentHandler, (uintptr_t)this);
+        currentmon_focus(CURRENTMON_LOAD_DOOR);
+    }
+}
+
+bool Door::finished()
+{
+    poll();
+
+    bool f = _finished;
+
+    _finished = false;
+    return f;
+}
+
+void Door::wait()
+{
+    while (_moving)
+    {
+        swtimer_task();
+        currentmon_task();
+        poll();
+    }
+}
+
+void Door::currentHandler(CURRENTMON_LOAD load, int32_t ma, uintptr_t context)
+{
+    Door* door = (Door*)context;
+
+    if (load != CURRENTMON_LOAD_DOOR || !door->_moving)
+        return;
+
+    if (ma < DOOR_STALL_MA)
+    {
+        door->_readingPos = motion_position(&door->_axis);
+        return;
+    }
+
+    float lo = (door->_openPos < door->_closedPos)? door->_openPos : door->_closedPos;
+    float hi = (door->_openPos < door->_closedPos)? door->_closedPos : door->_openPos;
+
+    // the servo is still behind where it was commanded to, back away from
+    // where it had got to at the reading before
+    float pos;
+
+    door->_stalled = true;
+    door->_stallMa = ma;
+    if (door->_target > door->_readingPos)
+        pos = door->_readingPos - DOOR_BACKOFF;
+    else
+        pos = door->_readingPos + DOOR_BACKOFF;
+
+    if (pos < lo)
+        pos = lo;
+    if (pos > hi)
+        pos = hi;
+
+    motion_set(&door->_axis, pos);
+    door->stop();
+}
+
+void Door::poll()
+{
+    if (_moving && !motion_busy(&_axis))
+        stop();
+}
+
+void Door::stop()
+{
+    currentmon_focus(CURRENTMON_LOADS);
+    currentmon_set_callback(NULL, 0);
+    currentmon_set_commanded(CURRENTMON_LOAD_DOOR, false);
+
+    _moving = false;
+    _finished = true;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,132 @@
+/* ************************************************************************** */
+/** Door servo
+
+  @Summary
+    Moves the door in the background and stops it when it stalls.
+
+  @Description
+    The door follows a trapezoidal profile from the motion planner, so it
+    starts and stops softly and the main loop keeps running during the move.
+    The current monitor converts only the door servo while it moves and
+    hands every reading over as it is collected: a reading above
+    DOOR_STALL_MA means something is in the way. The door is then sent back
+    by DOOR_BACKOFF degrees from where it was at the reading before, which
+    the servo had reached, and the move ends there, so the servo stops
+    pushing from the next PWM frame on instead of drawing the stall current
+    until the end of the move.
+
+    A stall is detected within one conversion of the LTC2497, 150 ms; the
+    servo supply is relieved one PWM frame later.
+ */
+/* ************************************************************************** */
+
+#ifndef _DOOR_H    /* Guard against multiple inclusion */
+#define _DOOR_H
+
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <stdint.h>
+#include <stdbool.h>
+#include "swtimer.h"
+#include "currentmon.h"
+#include "motion.h"
+
+#define DOOR_SPEED_DPS          120
+#define DOOR_ACCEL_DPS2         240
+#define DOOR_STALL_MA           500
+#define DOOR_BACKOFF            10
+
+class Door
+{
+public:
+    Door();
+
+    // *****************************************************************************
+    /**
+      @Function
+        void init(uint8_t motor, uint8_t closedPos, uint8_t openPos)
+
+      @Summary
+        Drive the door closed, positions in degrees of the servo
+     */
+    void init(uint8_t motor, uint8_t closedPos, uint8_t openPos);
+
+    /**
+      @Function
+        void move(bool open)
+
+      @Summary
+        Start moving the door, returns at once. A move under way is turned
+        around from where it is
+     */
+    void move(bool open);
+
+    /**
+      @Function
+        bool finished()
+
+      @Summary
+        true once after each move has ended, stalled or not
+     */
+    bool finished();
+
+    /**
+      @Function
+        void wait()
+
+      @Summary
+        Run the timers until the move is over, for the self tests
+     */
+    void wait();
+
+    /**
+      @Function
+        void setSpeed(float speed, float accel)
+
+      @Summary
+        Top speed in deg/s and acceleration in deg/s^2 of the moves
+     */
+    void setSpeed(float speed, float accel);
+
+    bool moving() { return _moving; }
+    bool isOpen() { return motion_position(&_axis) != _closedPos; }
+
+    /**
+      @Function
+        bool stalled()
+
+      @Summary
+        The last move stopped on an obstacle, until the next move
+     */
+    bool stalled() { return _stalled; }
+    uint8_t position() { return (uint8_t)(motion_position(&_axis) + 0.5f); }
+    int32_t stallCurrentMa() { return _stallMa; }
+
+private:
+    static void currentHandler(CURRENTMON_LOAD load, int32_t ma, uintptr_t context);
+    void poll();
+    void stop();
+
+    uint8_t _motor;
+    uint8_t _closedPos;
+    uint8_t _openPos;
+    uint8_t _target;
+    float _readingPos;
+
+    bool _moving;
+    bool _finished;
+    bool _stalled;
+    int32_t _stallMa;
+
+    motion_axis_t _axis;
+};
+
+#endif /* _DOOR_H */
+
+/* *****************************************************************************
+ End of File
+ */
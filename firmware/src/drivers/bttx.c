@@ -0,0 +1,38 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include "definitions.h"
+#include "bttx.h"
+
+static uint8_t bttx_buffer[ BTTX_BUFFER_SIZE ];
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+uint8_t *bttx_reserve ( size_t *room )
+{
+    *room = SERCOM3_USART_WriteFreeBufferCountGet( );
+    if ( *room > sizeof( bttx_buffer ) )
+    {
+        *room = sizeof( bttx_buffer );
+    }
+
+    return bttx_buffer;
+}
+
+bool bttx_commit ( size_t size )
+{
+    // the ring only drains in between, a frame that fitted still fits
+    if ( ( size > sizeof( bttx_buffer ) ) || ( size > SERCOM3_USART_WriteFreeBufferCountGet( ) ) )
+    {
+        return false;
+    }
+
+    return SERCOM3_USART_Write( bttx_buffer, size ) == size;
+}
+
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,74 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the Bluetooth UART transmitter.
+ *
+ * A frame is written into the room bttx_reserve() gives, as it is encoded,
+ * and handed to the SERCOM3 plib transmit ring by bttx_commit() in one
+ * SERCOM3_USART_Write(). The room is never more than the ring has free, so
+ * a committed frame goes out whole; one not committed is not sent at all.
+ *
+ * The plib keeps its ring static and MHC generates it, so the frame is not
+ * written into the ring itself: the plib copies it in once per frame.
+ * There is one producer, the main loop.
+ *
+ * \addtogroup bttx Bluetooth UART Transmitter
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef BTTX_H
+#define BTTX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+/* As the plib transmit ring, which keeps one byte free */
+#define BTTX_BUFFER_SIZE            128
+
+/** \} */ // End group macro
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Reserve function.
+ *
+ * @param room         Set to the bytes that can be written from the
+ *                     returned pointer, 0 if the ring is full.
+ *
+ * @returns Where to write the frame.
+ */
+uint8_t *bttx_reserve ( size_t *room );
+
+/**
+ * @brief Commit function.
+ *
+ * @param size         Bytes written since bttx_reserve().
+ *
+ * @returns true if they were handed to the ring, false if there is no
+ * longer room for them and nothing was sent.
+ */
+bool bttx_commit ( size_t size );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _BTTX_H_
@@ -0,0 +1,59 @@
+/* ************************************************************************** */
+/** PORT group access
+
+  @Summary
+    The output and input registers of one PORT group, with the group a
+    template parameter.
+
+  @Description
+    Every access is a single load or store to a constant address, which the
+    generated per-pin macros of plib_port.h give too but for one pin at a
+    time. OUTSET and OUTCLR change only the pins in the mask, so several pins
+    of a group switch in one atomic store.
+
+    The simulation has its own PortGroup, on the simulated pins, in
+    sim/include/drivers/port_group.h; pin.h includes this header through the
+    include path so that one is found first there.
+ */
+/* ************************************************************************** */
+
+#ifndef _PORT_GROUP_H    /* Guard against multiple inclusion */
+#define _PORT_GROUP_H
+
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <stdint.h>
+#include "peripheral/port/plib_port.h"
+
+/* Group is the index of the group, 0 for PA, 1 for PB */
+template <uint8_t Group>
+struct PortGroup
+{
+    static_assert(Group < PORT_GROUP_NUMBER, "no such PORT group");
+
+    static inline void Set(uint32_t mask)
+    {
+        PORT_REGS->GROUP[Group].PORT_OUTSET = mask;
+    }
+
+    static inline void Clear(uint32_t mask)
+    {
+        PORT_REGS->GROUP[Group].PORT_OUTCLR = mask;
+    }
+
+    static inline void Toggle(uint32_t mask)
+    {
+        PORT_REGS->GROUP[Group].PORT_OUTTGL = mask;
+    }
+
+    static inline uint32_t Read(uint32_t mask)
+    {
+        return PORT_REGS->GROUP[Group].PORT_IN & mask;
+    }
+};
+
+#endif /* _PORT_GROUP_H */
@@ -0,0 +1,171 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include <math.h>
+#include <string.h>
+#include "filter.h"
+
+#define FILTER_ONE                  ( 1L << FILTER_FRAC_BITS )
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static int32_t median_priv ( filter_t *filter, int32_t x );
+static int32_t smooth_priv ( filter_t *filter, int32_t x );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void filter_init ( filter_t *filter, const filter_cfg_t *cfg )
+{
+    filter->cfg = *cfg;
+
+    if ( filter->cfg.decimation == 0 )
+    {
+        filter->cfg.decimation = 1;
+    }
+    if ( ( filter->cfg.median == 0 ) || ( filter->cfg.median > FILTER_MEDIAN_MAX ) )
+    {
+        filter->cfg.median = 1;
+    }
+
+    filter_reset( filter );
+}
+
+void filter_reset ( filter_t *filter )
+{
+    filter->dec_sum = 0;
+    filter->dec_count = 0;
+    filter->window_head = 0;
+    filter->window_count = 0;
+    filter->primed = false;
+}
+
+bool filter_push ( filter_t *filter, int32_t raw, int32_t *out )
+{
+    int32_t x;
+
+    filter->dec_sum += raw;
+    if ( ++filter->dec_count < filter->cfg.decimation )
+    {
+        return false;
+    }
+
+    // rounded average of the readings
+    x = filter->dec_sum;
+    if ( filter->cfg.decimation > 1 )
+    {
+        x = ( x + ( ( x >= 0 ) ? 1 : -1 ) * ( filter->cfg.decimation / 2 ) ) / filter->cfg.decimation;
+    }
+    filter->dec_sum = 0;
+    filter->dec_count = 0;
+
+    x = median_priv( filter, x );
+    x = smooth_priv( filter, x );
+
+    *out = x;
+
+    return true;
+}
+
+void filter_design_lowpass ( filter_cfg_t *cfg, float cutoff_hz, float sample_hz )
+{
+    float k = tanf( ( float )M_PI * cutoff_hz / sample_hz );
+    float q = 0.70710678f;
+    float norm = 1.0f / ( 1.0f + k / q + k * k );
+    float scale = ( float )( 1L << FILTER_BIQUAD_Q );
+
+    cfg->smooth = FILTER_SMOOTH_BIQUAD;
+    cfg->biquad[ 0 ] = ( int32_t )lroundf( k * k * norm * scale );
+    cfg->biquad[ 1 ] = 2 * cfg->biquad[ 0 ];
+    cfg->biquad[ 2 ] = cfg->biquad[ 0 ];
+    cfg->biquad[ 3 ] = ( int32_t )lroundf( 2.0f * ( k * k - 1.0f ) * norm * scale );
+    cfg->biquad[ 4 ] = ( int32_t )lroundf( ( 1.0f - k / q + k * k ) * norm * scale );
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static int32_t median_priv ( filter_t *filter, int32_t x )
+{
+    int32_t sorted[ FILTER_MEDIAN_MAX ];
+    int32_t v;
+    uint8_t n;
+    uint8_t i;
+    uint8_t j;
+
+    if ( filter->cfg.median <= 1 )
+    {
+        return x;
+    }
+
+    filter->window[ filter->window_head ] = x;
+    filter->window_head = ( filter->window_head + 1 ) % filter->cfg.median;
+    if ( filter->window_count < filter->cfg.median )
+    {
+        filter->window_count++;
+    }
+
+    // insertion sort, the window is a handful of samples
+    n = filter->window_count;
+    for ( i = 0; i < n; i++ )
+    {
+        v = filter->window[ i ];
+        for ( j = i; ( j > 0 ) && ( sorted[ j - 1 ] > v ); j-- )
+        {
+            sorted[ j ] = sorted[ j - 1 ];
+        }
+        sorted[ j ] = v;
+    }
+
+    return sorted[ n / 2 ];
+}
+
+static int32_t smooth_priv ( filter_t *filter, int32_t x )
+{
+    const int32_t *c = filter->cfg.biquad;
+    int64_t acc;
+    int32_t y;
+
+    if ( filter->cfg.smooth == FILTER_SMOOTH_NONE )
+    {
+        return x;
+    }
+
+    // start from steady state at the first sample, no ramp from zero
+    if ( !filter->primed )
+    {
+        filter->x[ 0 ] = x;
+        filter->x[ 1 ] = x;
+        filter->y[ 0 ] = x * FILTER_ONE;
+        filter->y[ 1 ] = x * FILTER_ONE;
+        filter->primed = true;
+        return x;
+    }
+
+    if ( filter->cfg.smooth == FILTER_SMOOTH_EMA )
+    {
+        y = filter->y[ 0 ];
+        y += ( x * FILTER_ONE - y ) >> filter->cfg.ema_shift;
+        filter->y[ 0 ] = y;
+    }
+    else
+    {
+        acc = ( ( int64_t )c[ 0 ] * x + ( int64_t )c[ 1 ] * filter->x[ 0 ] +
+                ( int64_t )c[ 2 ] * filter->x[ 1 ] ) * FILTER_ONE;
+        acc -= ( int64_t )c[ 3 ] * filter->y[ 0 ] + ( int64_t )c[ 4 ] * filter->y[ 1 ];
+        y = ( int32_t )( ( acc + ( 1LL << ( FILTER_BIQUAD_Q - 1 ) ) ) >> FILTER_BIQUAD_Q );
+
+        filter->x[ 1 ] = filter->x[ 0 ];
+        filter->x[ 0 ] = x;
+        filter->y[ 1 ] = filter->y[ 0 ];
+        filter->y[ 0 ] = y;
+    }
+
+    // back to the unit of the input, rounded
+    return ( y + FILTER_ONE / 2 ) >> FILTER_FRAC_BITS;
+}
+
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,147 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the sensor filter pipeline.
+ *
+ * Readings go through up to three stages, each one can be disabled:
+ *
+ * - decimation: the average of several raw readings makes one sample;
+ * - median of the last N samples, to reject single spikes;
+ * - smoothing with a first order EMA or a biquad low-pass.
+ *
+ * Samples are integers in the unit chosen by the caller (e.g. 0.01 C). The
+ * pipeline is fixed point and allocation free: the smoothing state keeps
+ * FILTER_FRAC_BITS fractional bits so small steps are not lost, and the
+ * biquad runs in direct form I with Q29 coefficients and a 64-bit
+ * accumulator (a single SMLAL per tap on the Cortex-M4). Floating point is
+ * only used to design the biquad, once.
+ *
+ * \addtogroup filter Filter Pipeline
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+#define FILTER_MEDIAN_MAX           7
+#define FILTER_FRAC_BITS            8
+#define FILTER_BIQUAD_Q             29
+
+/** \} */ // End group macro
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup type Types
+ * \{
+ */
+
+typedef enum
+{
+    FILTER_SMOOTH_NONE = 0,
+    FILTER_SMOOTH_EMA,
+    FILTER_SMOOTH_BIQUAD
+
+} FILTER_SMOOTH;
+
+/**
+ * @brief Pipeline configuration.
+ */
+typedef struct
+{
+    uint8_t decimation;         // raw readings per sample, 1 to disable
+    uint8_t median;             // odd window up to FILTER_MEDIAN_MAX, 1 to disable
+    FILTER_SMOOTH smooth;
+    uint8_t ema_shift;          // alpha = 2^-ema_shift
+    int32_t biquad[ 5 ];        // b0, b1, b2, a1, a2 in Q29, a0 = 1
+
+} filter_cfg_t;
+
+/**
+ * @brief Pipeline state, one per signal.
+ */
+typedef struct
+{
+    filter_cfg_t cfg;
+
+    int32_t dec_sum;
+    uint8_t dec_count;
+
+    int32_t window[ FILTER_MEDIAN_MAX ];
+    uint8_t window_head;
+    uint8_t window_count;
+
+    // inputs and outputs of the smoothing stage, outputs with FILTER_FRAC_BITS
+    int32_t x[ 2 ];
+    int32_t y[ 2 ];
+    bool primed;
+
+} filter_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Initialization function.
+ *
+ * @param filter       Pipeline state.
+ * @param cfg          Configuration, copied.
+ */
+void filter_init ( filter_t *filter, const filter_cfg_t *cfg );
+
+/**
+ * @brief Reset function.
+ *
+ * @param filter       Pipeline state.
+ *
+ * @description This function forgets the history, the next reading primes
+ * every stage.
+ */
+void filter_reset ( filter_t *filter );
+
+/**
+ * @brief Push function.
+ *
+ * @param filter       Pipeline state.
+ * @param raw          Reading.
+ * @param out          Filtered sample, written when one is ready.
+ *
+ * @returns true when the reading completed a sample.
+ */
+bool filter_push ( filter_t *filter, int32_t raw, int32_t *out );
+
+/**
+ * @brief Biquad design function.
+ *
+ * @param cfg          Configuration to fill, smoothing is set to biquad.
+ * @param cutoff_hz    -3 dB frequency.
+ * @param sample_hz    Sample rate after decimation.
+ *
+ * @description Butterworth low-pass (Q = 0.707) from the bilinear transform.
+ */
+void filter_design_lowpass ( filter_cfg_t *cfg, float cutoff_hz, float sample_hz );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _FILTER_H_
@@ -9,15 +9,32 @@
 // *****************************************************************************
 
 #include <stdio.h>
+#include <stdarg.h>
 #include <stddef.h>                     // Defines NULL
 #include <stdbool.h>                    // Defines true
 #include <stdlib.h>                     // Defines EXIT_FAILURE
 #include <string.h>
+#include <math.h>
 #include "definitions.h"                // SYS function prototypes
+#include "board.h"
+#include "celsius.h"
 #include "temphum11.h"
 #include "servo.h"
 #include "rgbled.h"
 #include "bluesmirf.h"
+#include "btrx.h"
+#include "swtimer.h"
+#include "tempcontrol.h"
+#include "stepresponse.h"
+#include "nvstore.h"
+#include "rollup.h"
+#include "anomaly.h"
+#include "sampler.h"
+#include "filter.h"
+#include "currentmon.h"
+#include "servochan.h"
+#include "door.h"
+#include "boot.h"
 
 /* RTC Time period match values for input clock of 1 KHz */
 #define PERIOD_500MS                            512
@@ -25,19 +42,47 @@
 #define PERIOD_2S                               2048
 #define PERIOD_4S                               4096
 
+/* RTC period, the sampler picks the ticks the temperature loop runs on */
+#define CONTROL_PERIOD_MS                       500
+
 #define SERVO_FAN               SERVO_MOTOR_3
 #define SERVO_CELL              SERVO_MOTOR_1
 #define SERVO_DOOR              SERVO_MOTOR_16
 #define SERVO_DOOR_MIN          0
 #define SERVO_DOOR_MAX          125
 
+#define HYSTERESIS_BAND         DeciCelsius::fromDegrees(1)
+
+/* Humidity in 0.01 %RH through its filter, the temperature is in CentiCelsius */
+#define SENSOR_SCALE            100
+#define POWERON_DELAY_MS        2000
+
 
 static volatile bool isRTCExpired = false;
 static volatile bool isUSARTTxComplete = true;
-static uint8_t uartTxBuffer[100] = {0};
+static uint8_t uartTxBuffer[128] = {0};
 
 static BlueSmirf bs;
-static bool doorIsOpen = false;
+static RGBLed rgbLed;
+static TempControl tempCtrl;
+static StepResponse stepResp;
+static AnomalyDetector anomaly;
+static AdaptiveSampler sampler;
+
+/* Median of 3 drops a single spike, the EMA (alpha 1/2) halves the noise left;
+   the lag stays within a couple of samples at the slowest sampling period */
+static const filter_cfg_t sensorFilterCfg = { 1, 3, FILTER_SMOOTH_EMA, 1, { 0 } };
+static filter_t tempFilter;
+static filter_t humFilter;
+static Door door;
+static bool doorMains = false;
+
+static uint8_t alertsSent = Alert_None;
+
+static swtimer_t fanRunOnTimer;
+static swtimer_t powerOnTimer;
+static swtimer_t sensorTimer;
+static bool sensorReady = false;
 
 static void EIC_User_Handler(uintptr_t context)
 {
@@ -49,6 +94,8 @@ static void rtcEventHandler (RTC_TIMER32_INT_MASK intCause, uintptr_t context)
     {            
         isRTCExpired    = true;
     }
+
+    swtimer_rtc_handler(intCause);
 }
 
 static void usartDmaChannelHandler(DMAC_TRANSFER_EVENT event, uintptr_t contextHandle)
@@ -59,64 +106,252 @@ static void usartDmaChannelHandler(DMAC_TRANSFER_EVENT event, uintptr_t contextH
     }
 }
 
+static void loads_commanded()
+{
+    // the loads are on the switched supply
+    currentmon_set_commanded(CURRENTMON_LOAD_CELL, bs.mains() && bs.cell());
+    currentmon_set_commanded(CURRENTMON_LOAD_FAN, bs.mains() && bs.fan());
+}
+
 static void mains_switch(bool on)
 {
-    on? PS_ON_Clear() : PS_ON_Set();
+    bool wasOn = bs.mains();
+
+    // the servo outputs follow the supply in the same store
+    on? PsOnServoOe::on() : PsOnServoOe::off();
     bs.setMains(on);
+
+    // the rockers may have been switched while the servos had no supply
+    if (on && !wasOn)
+    {
+        servochan_refresh(SERVO_FAN);
+        servochan_refresh(SERVO_CELL);
+    }
+    loads_commanded();
     
-    //update status LED
+    rgbLed.setLoads(bs.mains(), bs.fan(), bs.cell());
 }
 
 static void fan_switch(bool on)
 {
-    servo_set_position(SERVO_FAN, on? 90 : 0);
+    servochan_set_position(SERVO_FAN, on? 90 : 0);
     bs.setFan(on);
+    loads_commanded();
     
-    //update status LED
+    rgbLed.setLoads(bs.mains(), bs.fan(), bs.cell());
 }
 
 static void cell_switch(bool on)
 {
-    servo_set_position(SERVO_CELL, on? 0 : 90);
+    servochan_set_position(SERVO_CELL, on? 0 : 90);
     bs.setCell(on);
+    loads_commanded();
 
-    //update status LED
+    rgbLed.setLoads(bs.mains(), bs.fan(), bs.cell());
 }
 
 static void door_init()
 {
-    servo_set_position(SERVO_DOOR, SERVO_DOOR_MAX);
+    door.init(SERVO_DOOR, SERVO_DOOR_MAX, SERVO_DOOR_MIN);
 }
 
 static void door_open(bool open)
 {
-    if (doorIsOpen == open)
-        return;
-    
-    uint8_t start = open? SERVO_DOOR_MAX : SERVO_DOOR_MIN;
-    uint8_t end = open? SERVO_DOOR_MIN : SERVO_DOOR_MAX;
-    uint8_t step = open? -1 : 1;
-    
-    uint8_t curr = start;
-    while (curr != end)
+    // the servos need the supply until the move is over
+    if (!bs.mains())
     {
-        servo_set_position(SERVO_DOOR, curr);
-        SYSTICK_DelayMs(100);
-        curr += step;
+        mains_switch(true);
+        doorMains = true;
     }
-    
-    doorIsOpen = open;
+
+    door.move(open);
+    sampler.kick();
 }
 
-static void print(uint8_t* txBuffer)
+/* Send the line in uartTxBuffer; the DMA reads it as it goes out, so
+   nothing is written to it until isUSARTTxComplete */
+static void printBuffer()
 {
     isUSARTTxComplete = false;
 
-    DMAC_ChannelTransfer(DMAC_CHANNEL_0, txBuffer, \
+    DMAC_ChannelTransfer(DMAC_CHANNEL_0, uartTxBuffer, \
         (const void *)&(SERCOM5_REGS->USART_INT.SERCOM_DATA), \
-        strlen((const char*)txBuffer));
+        strlen((const char*)uartTxBuffer));
+}
+
+/* Format a line into uartTxBuffer and send it, after sleeping until the
+   line before is out */
+static void print(const char* format, ...)
+{
+    va_list args;
+
+    while (!isUSARTTxComplete)
+    {
+        bool irq = NVIC_INT_Disable();
+        if (!isUSARTTxComplete)
+            __WFI();
+        NVIC_INT_Restore(irq);
+    }
+
+    va_start(args, format);
+    vsnprintf((char*)uartTxBuffer, sizeof(uartTxBuffer), format, args);
+    va_end(args);
+
+    printBuffer();
+}
+
+/* 0.01 units as "-1.05": the console is printed without float formatting */
+static char* centi_str(char* buf, int32_t v)
+{
+    uint32_t a = (v < 0)? -(uint32_t)v : (uint32_t)v;
+
+    sprintf(buf, "%s%lu.%02lu", (v < 0)? "-" : "", (unsigned long)(a / 100), (unsigned long)(a % 100));
+    return buf;
+}
+
+static void fan_runon_expired(uintptr_t context)
+{
+    // cell has been off for the whole run-on time
+    fan_switch(false);
+}
+
+static void power_on_expired(uintptr_t context)
+{
+    RGBLed* rgbLed = (RGBLed*)context;
+
+#ifdef TEST_POWERON
+    print(">>>>>> SELF TEST\r\n");
+    SYSTICK_DelayMs(500);
+
+    // self test
+    print(">>>>>> SELF TEST: FAN ON\r\n");
+    rgbLed->update(255,0,0);
+    fan_switch(true);
+    SYSTICK_DelayMs(3000);
+
+    print(">>>>>> SELF TEST: CELL ON\r\n");
+    rgbLed->update(0,255,0);
+    cell_switch(true);
+    SYSTICK_DelayMs(3000);
+
+    print(">>>>>> SELF TEST: CELL OFF\r\n");
+    rgbLed->update(0,0,255);
+    cell_switch(false);
+    SYSTICK_DelayMs(3000);
+
+    print(">>>>>> SELF TEST: FAN OFF\r\n");
+    fan_switch(false);
+    SYSTICK_DelayMs(3000);
+
+    print(">>>>>> SELF TEST: DOOR OPEN\r\n");
+    door_open(true);
+    door.wait();
+    SYSTICK_DelayMs(3000);
+
+    print(">>>>>> SELF TEST: DOOR CLOSE\r\n");
+    door_open(false);
+    door.wait();
+    SYSTICK_DelayMs(3000);
+
+    print(">>>>>> SELF TEST COMPLETED\r\n");
+#endif
+
+    rgbLed->update(0,0,0);
 }
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: Boot Steps
+// *****************************************************************************
+// *****************************************************************************
+enum
+{
+    Boot_Sensor,
+    Boot_Store,
+    Boot_Link,
+    Boot_Servo,
+    Boot_Actuators,
+    Boot_MainsOff,
+    Boot_Steps
+};
+
+static void sensor_powered(uintptr_t context)
+{
+    temphum11_default_cfg();
+    sensorReady = true;
+}
+
+static void boot_sensor()
+{
+    // the HDC1080 powered up with the MCU, it has to finish its own start up
+    swtimer_start(&sensorTimer, TEMPHUM11_STARTUP_MS, sensor_powered, 0);
+}
+
+static bool boot_sensor_ready()
+{
+    return sensorReady;
+}
+
+static void boot_store()
+{
+    nvstore_init();
+    stepResp.init();
+    rollup_init();
+}
+
+static void boot_link()
+{
+    // the module answers into the DMA buffer
+    btrx_init();
+    bs.init();
+}
+
+static bool boot_link_ready()
+{
+    // the main loop is not running yet to read the replies
+    bs.update();
+    return bs.ready();
+}
+
+static void boot_servo()
+{
+    servo_init();
+    servo_soft_reset();
+    servo_default_cfg();
+    servochan_init();
+    currentmon_init();
+}
+
+static void boot_actuators()
+{
+    // drive the rockers and the lid to their rest positions
+    mains_switch(true);
+    cell_switch(false);
+    fan_switch(false);
+    door_init();
+}
+
+static bool boot_actuators_ready()
+{
+    // released once they have had their settle time
+    return !servochan_driven(SERVO_CELL) && !servochan_driven(SERVO_FAN) && !servochan_driven(SERVO_DOOR);
+}
+
+static void boot_mains_off()
+{
+    mains_switch(false);
+}
+
+static const boot_step_t bootSteps[Boot_Steps] =
+{
+    { "sensor",     0,                              boot_sensor,    boot_sensor_ready },
+    { "store",      0,                              boot_store,     NULL },
+    { "link",       0,                              boot_link,      boot_link_ready },
+    { "servo",      0,                              boot_servo,     NULL },
+    { "actuators",  BOOT_STEP(Boot_Servo),          boot_actuators, boot_actuators_ready },
+    { "mains off",  BOOT_STEP(Boot_Actuators),      boot_mains_off, NULL },
+};
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Main Entry Point
@@ -130,41 +365,44 @@ int main ( void )
     EIC_CallbackRegister(EIC_PIN_15,EIC_User_Handler, 0);
     RTC_Timer32CallbackRegister(rtcEventHandler, 0);
 
-    sprintf((char*)uartTxBuffer, "COLD CASE Terminal\r\n");
-    print(uartTxBuffer);
+    print("COLD CASE Terminal\r\n");
     
     SYSTICK_TimerStart();
     
     RTC_Timer32Compare0Set(PERIOD_500MS);
+    swtimer_init(PERIOD_500MS);
     RTC_Timer32Start();
 
-    RGBLed rgbLed;
     rgbLed.init();
 
-    temphum11_default_cfg();
+    sampler.init(CONTROL_PERIOD_MS);
+    filter_init(&tempFilter, &sensorFilterCfg);
+    filter_init(&humFilter, &sensorFilterCfg);
 
-    bs.init();
-
-    servo_init();
-    servo_default_cfg();
-    servo_soft_reset();
-    
-    mains_switch(true);
-    cell_switch(false);
-    fan_switch(false);
-    door_init();
+    // every wait of the boot steps ends with a timer interrupt: sleep until
+    // it, unless it came while a step was starting
+    boot_start(bootSteps, Boot_Steps);
+    while (!boot_task())
+    {
+        bool irq = NVIC_INT_Disable();
+        if (!swtimer_pending())
+            __WFI();
+        NVIC_INT_Restore(irq);
 
-    SYSTICK_DelayMs(1000);
-    mains_switch(false);
+        swtimer_task();
+        currentmon_task();
+    }
 
 //#define TEST_DOOR
 #ifdef TEST_DOOR
-    PS_ON_Clear();
+    PsOn::on();
     while (1)
     {
-        door_open(true);
+        door.move(true);
+        door.wait();
         SYSTICK_DelayMs(3000);
-        door_open(false);
+        door.move(false);
+        door.wait();
         SYSTICK_DelayMs(3000);
     }
 #endif
@@ -182,56 +420,103 @@ int main ( void )
 #endif
         
     unsigned long psTick = 0;
-    unsigned long psOnTick = 0;
-    unsigned long cellOffTick = 0;
-    int psSwitchPrev = 1;
+    bool psPressedPrev = false;
+    uint8_t bootTraceLine = 0;
     
     while ( true )
     {
+        swtimer_task();
+        currentmon_task();
+
+        // one line per free console
+        if (bootTraceLine <= Boot_Steps && isUSARTTxComplete)
+        {
+            boot_trace(bootTraceLine++, (char*)uartTxBuffer, sizeof(uartTxBuffer));
+            printBuffer();
+        }
+
+        if (door.finished())
+        {
+            if (door.stalled())
+            {
+                print(">>>>>> DOOR STALL at %d, %ldmA\r\n", door.position(), (long)door.stallCurrentMa());
+            }
+
+            if (doorMains)
+            {
+                mains_switch(false);
+                doorMains = false;
+            }
+            sampler.kick();
+        }
+
         bs.update();
+
+        LoopbackResult link;
+        if (bs.loopbackDone(link))
+        {
+            print(">>>>>> LINK %lu baud: %u echoed, %u lost, %lu B/s; now at %lu baud\r\n",
+                  (unsigned long)link.baud, link.echoed, link.lost, (unsigned long)link.bytesPerSec,
+                  (unsigned long)bs.baud());
+        }
         
         CommandEnum cmd = bs.command();
         if (cmd == Command_Open)
         {
-            print((uint8_t*)">>>>>> DOOR OPEN \r\n");
-
-            int mainsOn = bs.mains();
-            if (!mainsOn)
-                mains_switch(true);
-
+            print(">>>>>> DOOR OPEN \r\n");
             door_open(true);
-
-            if (!mainsOn)
-                mains_switch(false);
         }
         else if (cmd == Command_Close)
         {
-            print((uint8_t*)">>>>>> DOOR CLOSE \r\n");
-            
-            int mainsOn = bs.mains();
-            if (!mainsOn)
-                mains_switch(true);
-            
+            print(">>>>>> DOOR CLOSE \r\n");
             door_open(false);
+        }
+        else if (cmd >= Command_ControlHysteresis && cmd <= Command_ControlPredictive)
+        {
+            tempCtrl.setMode((ControlModeEnum)(cmd - Command_ControlHysteresis), bs.cell());
 
-            if (!mainsOn)
-                mains_switch(false);
+            print(">>>>>> CONTROL MODE %d\r\n", tempCtrl.mode());
+        }
+        else if (cmd == Command_Characterize)
+        {
+            // needs the supply, and the loop is suspended while it runs
+            if (bs.mains() && stepResp.start())
+                print(">>>>>> CHARACTERIZATION STARTED\r\n");
+            else
+                print(">>>>>> CHARACTERIZATION REFUSED\r\n");
+        }
+        else if (cmd == Command_ReportCharacterization)
+        {
+            bs.sendStepResult(stepResp.result());
+        }
+        else if (cmd >= Command_QueryMinutes && cmd <= Command_QueryDays)
+        {
+            bs.sendRollups((ROLLUP_LEVEL)(cmd - Command_QueryMinutes));
+        }
+        else if (cmd == Command_FastLink)
+        {
+            if (!bs.setBaud(BLUESMIRF_BAUD_FAST))
+                print(">>>>>> LINK BUSY\r\n");
+        }
+        else if (cmd == Command_LinkBenchmark)
+        {
+            if (!bs.startLoopback(BLUESMIRF_BENCH_FRAMES))
+                print(">>>>>> LINK BUSY\r\n");
         }
         
         if (bs.manual())
         {
-            sprintf((char*)uartTxBuffer, ">>>>>> MANUAL MODE Mains %d, Fan %d, Cell %d\r\n", bs.mainsOn(), bs.fanOn(), bs.cellOn());
-            print(uartTxBuffer);
+            print(">>>>>> MANUAL MODE Mains %d, Fan %d, Cell %d\r\n", bs.mainsOn(), bs.fanOn(), bs.cellOn());
 
             fan_switch(bs.fanOn());
             cell_switch(bs.cellOn());
             mains_switch(bs.mainsOn());
         }
         
-        int psSwitch = PS_SW_Get();
-        if (psSwitch != psSwitchPrev)
+        bool psPressed = PsSw::isOn();
+        if (psPressed != psPressedPrev)
         {
-            if (psSwitch == 0)
+            if (psPressed)
             {
                 if (psTick != 0)
                 {
@@ -240,7 +525,7 @@ int main ( void )
                     {
                         if (!bs.mains())
                         {
-                            psOnTick = SYSTICK_GetTickCounter();
+                            swtimer_start(&powerOnTimer, POWERON_DELAY_MS, power_on_expired, (uintptr_t)&rgbLed);
                         }
                         else
                         {
@@ -248,15 +533,17 @@ int main ( void )
                             cell_switch(false);
                             SYSTICK_DelayMs(500);
                             
-                            psOnTick = 0;
+                            swtimer_cancel(&powerOnTimer);
+                            swtimer_cancel(&fanRunOnTimer);
                         }
                         
                         psTick = 0;
-                        psSwitchPrev = psSwitch;
+                        psPressedPrev = psPressed;
 
-                        sprintf((char*)uartTxBuffer, ">>>>>> SWITCHING %s\r\n", PS_ON_Get()? "ON" : "OFF");
-                        print(uartTxBuffer);
+                        print(">>>>>> SWITCHING %s\r\n", PsOn::isOn()? "OFF" : "ON");
 
+                        // the user takes over the supply from a door move
+                        doorMains = false;
                         mains_switch(!bs.mains());
                     }
                 }
@@ -268,109 +555,152 @@ int main ( void )
             else
             {
                 psTick = 0;
-                psSwitchPrev = psSwitch;
+                psPressedPrev = psPressed;
             }
         }
         
-        if (psOnTick != 0)
-        {
-            unsigned long delta = SYSTICK_GetTickCounter() - psOnTick;
-            if (delta > 2000)
-            {
-#ifdef TEST_POWERON                
-                sprintf((char*)uartTxBuffer, ">>>>>> SELF TEST\r\n");
-                print(uartTxBuffer);
-                SYSTICK_DelayMs(500);
-
-                // self test
-                sprintf((char*)uartTxBuffer, ">>>>>> SELF TEST: FAN ON\r\n");
-                print(uartTxBuffer);
-                rgbLed.update(255,0,0);
-                fan_switch(true);
-                SYSTICK_DelayMs(3000);
-
-                sprintf((char*)uartTxBuffer, ">>>>>> SELF TEST: CELL ON\r\n");
-                print(uartTxBuffer);
-                rgbLed.update(0,255,0);
-                cell_switch(true);
-                SYSTICK_DelayMs(3000);
-
-                sprintf((char*)uartTxBuffer, ">>>>>> SELF TEST: CELL OFF\r\n");
-                print(uartTxBuffer);
-                rgbLed.update(0,0,255);
-                cell_switch(false);
-                SYSTICK_DelayMs(3000);
-
-                sprintf((char*)uartTxBuffer, ">>>>>> SELF TEST: FAN OFF\r\n");
-                print(uartTxBuffer);
-                fan_switch(false);
-                SYSTICK_DelayMs(3000);
-
-                sprintf((char*)uartTxBuffer, ">>>>>> SELF TEST: DOOR OPEN\r\n");
-                print(uartTxBuffer);
-                door_open(true);
-                SYSTICK_DelayMs(3000);
-
-                sprintf((char*)uartTxBuffer, ">>>>>> SELF TEST: DOOR CLOSE\r\n");
-                print(uartTxBuffer);
-                door_open(false);
-                SYSTICK_DelayMs(3000);
-
-                sprintf((char*)uartTxBuffer, ">>>>>> SELF TEST COMPLETED\r\n");
-                print(uartTxBuffer);
-#endif
-                
-                rgbLed.update(0,0,0);
-                
-                psOnTick = 0;
-            }
-        }
-
         if (isRTCExpired == true)
         {
             isRTCExpired = false;
-            LED0_Toggle();
+            Led0::toggle();
+            rgbLed.setConnected(bs.connected());
+
+            if (!sampler.due())
+                continue;
+
+            uint32_t dtMs = sampler.elapsedMs();
+
+            temphum11_set_resolution(sampler.resolution());
+
+            // as many readings as the decimation needs for one sample
+            int32_t hRaw;
+            CentiCelsius tRaw;
+            int32_t hOut, tOut;
+            bool ready;
+            do
+            {
+                hRaw = temphum11_get_humidity_centi();
+                tRaw = CentiCelsius::fromRaw(temphum11_get_temperature_centi());
+
+                ready = filter_push(&humFilter, hRaw, &hOut);
+                ready &= filter_push(&tempFilter, tRaw.raw(), &tOut);
+            } while (!ready);
+
+            CentiCelsius tc = CentiCelsius::fromRaw(tOut);
+            DeciCelsius sp = bs.temperatureSetpoint();
 
-            float h = temphum11_get_humidity();
-            float t = temphum11_get_temperature(TEMPHUM11_TEMP_IN_CELSIUS);
+            // the switches as they were over the period just ended
+            rollup_add(swtimer_now() / SWTIMER_TICK_FREQ, (int16_t)tc.raw(),
+                       bs.cell(), bs.fan(), dtMs);
+
+            if (stepResp.active() && !bs.mains())
+                stepResp.abort();
 
             if (bs.mains())
+            {
+                tempCtrl.observe(tc, bs.cell(), dtMs);
+                // the stuck sensor detector needs the readings as they come
+                anomaly.update(tRaw, hRaw, bs.cell(), door.isOpen(), tempCtrl.model(), dtMs);
+            }
+            else
+            {
+                anomaly.reset();
+            }
+
+            uint8_t alerts = anomaly.alerts();
+            if (currentmon_mismatch() != 0)
+                alerts |= Alert_ActuatorMismatch;
+            if (door.stalled())
+                alerts |= Alert_DoorStall;
+
+            // held back while the module is in command mode, tried on the next pass
+            if (alerts != alertsSent && bs.sendAlerts(alerts))
+            {
+                print(">>>>>> ALERTS %02X, Cell %ldmA, Fan %ldmA, Door %ldmA\r\n", alerts,
+                      (long)currentmon_current_ma(CURRENTMON_LOAD_CELL), (long)currentmon_current_ma(CURRENTMON_LOAD_FAN),
+                      (long)currentmon_current_ma(CURRENTMON_LOAD_DOOR));
+                alertsSent = alerts;
+            }
+
+            if (stepResp.active())
+            {
+                bool done = stepResp.update(tc, dtMs);
+
+                if (stepResp.cellOn() != bs.cell())
+                    cell_switch(stepResp.cellOn());
+                if (stepResp.fanOn() != bs.fan())
+                    fan_switch(stepResp.fanOn());
+
+                if (done)
+                {
+                    const StepResult& r = stepResp.result();
+
+                    print(">>>>>> CHARACTERIZATION %d: K=%.2f tau=%.0fs L=%.0fs rate=%.2fC/min\r\n",
+                          (int)r.status, r.gainC, r.tauS, r.deadTimeS, r.maxRateCPerMin);
+                    bs.sendStepResult(r);
+
+                    // the loop starts over from the state left by the test
+                    tempCtrl.reset(bs.cell());
+                }
+            }
+            else if (bs.mains() && tempCtrl.mode() == Control_Hysteresis)
             {
                 // misuro T frigo
-                if (t < bs.temperatureSetpoint())
+                if (tc < sp)
                 {
-                    // cell off, keep the fan running for another 30 seconds
+                    // cell off, keep the fan running while the cold side still pumps heat
                     cell_switch(false);
-                    cellOffTick = SYSTICK_GetTickCounter();
+                    swtimer_start(&fanRunOnTimer, tempCtrl.fanRunOnMs(), fan_runon_expired, 0);
                 }
-                else if (t > bs.temperatureSetpoint()+1.0)
+                else if (tc > sp + HYSTERESIS_BAND)
                 {
                     cell_switch(true);
-                    cellOffTick = 0;
+                    swtimer_cancel(&fanRunOnTimer);
 
                     fan_switch(true);
                 }
+            }
+            else if (bs.mains())
+            {
+                // PI/PID/predictive: only the transitions move the switches
+                bool on = tempCtrl.update(tc, sp, dtMs);
+                if (on && !bs.cell())
+                {
+                    cell_switch(true);
+                    swtimer_cancel(&fanRunOnTimer);
 
-                if (cellOffTick != 0)
+                    fan_switch(true);
+                }
+                else if (!on && bs.cell())
                 {
-                    unsigned long delta = SYSTICK_GetTickCounter() - cellOffTick;
-                    if (delta > 30000)
-                    {
-                       fan_switch(false); 
-                       cellOffTick = 0;
-                    }
+                    cell_switch(false);
+                    swtimer_start(&fanRunOnTimer, tempCtrl.fanRunOnMs(), fan_runon_expired, 0);
                 }
             }
+            else
+            {
+                // the case warms up unobserved, the model starts over
+                tempCtrl.reset(bs.cell());
+                tempCtrl.model().reset();
+            }
             
-            // update RGB LED
-            rgbLed.updateFromTemp(t, bs.temperatureSetpoint());
-
-            bs.setTemperature(t);
-            bs.setHumidity((int)h);
+            // update RGB LED, an alert takes over the temperature color
+            rgbLed.updateFromTemp(tc, sp);
+            rgbLed.updateFromAlerts(alerts);
+
+            // rounded to the 0.1 C of the status frame, the float loop truncated
+            // it and showed up to 0.09 C low
+            bs.setTemperature(tc.to<10>());
+            bs.setHumidity((int)(hOut / SENSOR_SCALE));
+            bs.setAppStatus(stepResp.phase());
+
+            // a characterization and alerts need every tick
+            sampler.update(tc, bs.cell(), bs.fan(), stepResp.active() || (alerts != Alert_None));
             
-            sprintf((char*)uartTxBuffer, "Temp=%f, Hum=%f, SW=%d, Conn=%d, Mains=%d, Fan=%d, Cell=%d, SP: %f\r\n", t, h, psSwitch, 
-                    bs.connected(), bs.mains(), bs.fan(), bs.cell(), bs.temperatureSetpoint());
-            print(uartTxBuffer);
+            char tStr[16], hStr[16], spStr[16];
+            print("Temp=%s, Hum=%s, SW=%d, Conn=%d, Mains=%d, Fan=%d, Cell=%d, SP: %s\r\n",
+                  centi_str(tStr, tc.raw()), centi_str(hStr, hOut), !psPressed, bs.connected(), bs.mains(),
+                  bs.fan(), bs.cell(), centi_str(spStr, sp.to<100>().raw()));
         }
     }
 
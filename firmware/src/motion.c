@@ -0,0 +1,203 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include <stddef.h>
+#include <math.h>
+#include "servo.h"
+#include "swtimer.h"
+#include "servochan.h"
+#include "motion.h"
+
+/**
+ * @brief Planner ctx object definition.
+ */
+typedef struct
+{
+    // the axes with a move under way
+    motion_axis_t *moving;
+    uint32_t frame_us;
+    swtimer_t timer;
+
+} motion_t;
+
+static motion_t motion_ctx;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static void frame_priv ( uintptr_t context );
+static bool step_priv ( motion_axis_t *axis, float dt );
+static void write_priv ( motion_axis_t *axis, bool always );
+static void unlink_priv ( motion_axis_t *axis );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void motion_axis_init ( motion_axis_t *axis, uint8_t motor, float position, float max_speed, float accel )
+{
+    axis->next = NULL;
+    axis->motor = motor;
+    axis->max_speed = max_speed;
+    axis->accel = accel;
+    axis->busy = false;
+
+    motion_set( axis, position );
+}
+
+void motion_set_limits ( motion_axis_t *axis, float max_speed, float accel )
+{
+    axis->max_speed = max_speed;
+    axis->accel = accel;
+}
+
+void motion_move ( motion_axis_t *axis, float target )
+{
+    axis->target = target;
+    if ( axis->busy || ( target == axis->position ) )
+    {
+        return;
+    }
+
+    axis->busy = true;
+    axis->velocity = 0;
+    axis->next = motion_ctx.moving;
+    motion_ctx.moving = axis;
+
+    if ( !swtimer_is_active( &motion_ctx.timer ) )
+    {
+        // one step per PWM frame, the servos would not see more
+        motion_ctx.frame_us = servo_frame_us( );
+        if ( motion_ctx.frame_us == 0 )
+        {
+            motion_ctx.frame_us = MOTION_DEFAULT_FRAME_US;
+        }
+        swtimer_start_periodic( &motion_ctx.timer, ( motion_ctx.frame_us + 500 ) / 1000, frame_priv, 0 );
+    }
+}
+
+void motion_set ( motion_axis_t *axis, float position )
+{
+    if ( axis->busy )
+    {
+        unlink_priv( axis );
+    }
+
+    axis->position = position;
+    axis->target = position;
+    axis->velocity = 0;
+    write_priv( axis, true );
+}
+
+float motion_position ( motion_axis_t *axis )
+{
+    return axis->position;
+}
+
+bool motion_busy ( motion_axis_t *axis )
+{
+    return axis->busy;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void frame_priv ( uintptr_t context )
+{
+    float dt = motion_ctx.frame_us / 1000000.0f;
+    motion_axis_t *axis = motion_ctx.moving;
+    motion_axis_t *next;
+
+    while ( axis != NULL )
+    {
+        next = axis->next;
+        if ( step_priv( axis, dt ) )
+        {
+            unlink_priv( axis );
+        }
+        write_priv( axis, false );
+        axis = next;
+    }
+}
+
+static bool step_priv ( motion_axis_t *axis, float dt )
+{
+    float dist = axis->target - axis->position;
+    float dir = ( dist < 0 )? -1.0f : 1.0f;
+    float along = axis->velocity * dir;
+    float dv = axis->accel * dt;
+    float brake;
+
+    if ( along < 0 )
+    {
+        // the target was moved behind the axis, stop before turning around
+        along += dv;
+        if ( along > 0 )
+        {
+            along = 0;
+        }
+    }
+    else
+    {
+        // no faster than it can still stop from on the target
+        brake = sqrtf( 2.0f * axis->accel * dist * dir );
+        along += dv;
+        if ( along > axis->max_speed )
+        {
+            along = axis->max_speed;
+        }
+        if ( along > brake )
+        {
+            along = brake;
+        }
+
+        if ( along * dt >= dist * dir )
+        {
+            axis->position = axis->target;
+            axis->velocity = 0;
+            return true;
+        }
+    }
+
+    axis->velocity = along * dir;
+    axis->position += axis->velocity * dt;
+
+    return false;
+}
+
+static void write_priv ( motion_axis_t *axis, bool always )
+{
+    uint16_t pulse = servo_pulse_of( axis->position );
+
+    if ( always || ( pulse != axis->pulse ) )
+    {
+        axis->pulse = pulse;
+        servochan_set_pulse( axis->motor, pulse );
+    }
+}
+
+static void unlink_priv ( motion_axis_t *axis )
+{
+    motion_axis_t **link = &motion_ctx.moving;
+
+    while ( *link != NULL )
+    {
+        if ( *link == axis )
+        {
+            *link = axis->next;
+            break;
+        }
+        link = &( *link )->next;
+    }
+
+    axis->next = NULL;
+    axis->busy = false;
+
+    if ( motion_ctx.moving == NULL )
+    {
+        swtimer_cancel( &motion_ctx.timer );
+    }
+}
+
+// ------------------------------------------------------------------------- END
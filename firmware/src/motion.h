@@ -0,0 +1,136 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the servo motion planner.
+ *
+ * An axis is a servo output of the PCA9685 moved along a trapezoidal
+ * profile: it accelerates at a constant rate up to its top speed and
+ * brakes so that it stops on the target. The position is advanced once per
+ * PWM frame, the rate the servos take a new pulse at, and written only when
+ * the pulse changes, so no update lands mid-frame or repeats the previous
+ * one. Positions are kept with a fraction of a degree, which the 12-bit
+ * pulse resolves to about half a degree.
+ *
+ * The axes are owned by the caller, as the software timers; a single timer
+ * steps all the moving ones and stops when none is left.
+ *
+ * \addtogroup motion Servo Motion
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef MOTION_H
+#define MOTION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+/* Until servo_set_freq() has been called */
+#define MOTION_DEFAULT_FRAME_US     33333UL
+
+/** \} */ // End group macro
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup type Types
+ * \{
+ */
+
+typedef struct motion_axis_s
+{
+    struct motion_axis_s *next;
+
+    uint8_t motor;
+    float max_speed;            // deg/s
+    float accel;                // deg/s^2
+
+    float position;
+    float velocity;
+    float target;
+    uint16_t pulse;             // last written
+    bool busy;
+
+} motion_axis_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Axis initialization function.
+ *
+ * @param axis         Axis, owned by the caller.
+ * @param motor        SERVO_MOTOR_x of the output.
+ * @param position     Position the servo is driven to at once.
+ * @param max_speed    Top speed in deg/s.
+ * @param accel        Acceleration and braking in deg/s^2.
+ */
+void motion_axis_init ( motion_axis_t *axis, uint8_t motor, float position, float max_speed, float accel );
+
+/**
+ * @brief Limits function.
+ *
+ * @param axis         Axis.
+ * @param max_speed    Top speed in deg/s.
+ * @param accel        Acceleration and braking in deg/s^2.
+ *
+ * @description A move under way follows the new limits from the next frame.
+ */
+void motion_set_limits ( motion_axis_t *axis, float max_speed, float accel );
+
+/**
+ * @brief Move function.
+ *
+ * @param axis         Axis.
+ * @param target       Position to go to; a move under way brakes first if
+ *                     the target is behind it.
+ */
+void motion_move ( motion_axis_t *axis, float target );
+
+/**
+ * @brief Set function.
+ *
+ * @param axis         Axis.
+ * @param position     Position the servo is driven to at once, the move
+ *                     under way is dropped.
+ */
+void motion_set ( motion_axis_t *axis, float position );
+
+/**
+ * @brief Position function.
+ *
+ * @param axis         Axis.
+ *
+ * @returns Position last sent to the servo.
+ */
+float motion_position ( motion_axis_t *axis );
+
+/**
+ * @brief Busy function.
+ *
+ * @param axis         Axis.
+ *
+ * @returns true until the axis has reached its target.
+ */
+bool motion_busy ( motion_axis_t *axis );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _MOTION_H_
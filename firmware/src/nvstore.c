@@ -0,0 +1,264 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include <string.h>
+#include "nvstore.h"
+#include "definitions.h"
+
+#define NVSTORE_MAGIC               0x5643434EUL    // "NCCV"
+#define NVSTORE_NONE                0xFFFF
+
+/**
+ * @brief Page header, followed by the record.
+ */
+typedef struct
+{
+    uint32_t magic;
+    uint32_t sequence;
+    uint16_t id;
+    uint16_t length;
+    uint16_t crc;
+    uint16_t reserved;
+
+} nvstore_header_t;
+
+/**
+ * @brief Store ctx object definition.
+ */
+typedef struct
+{
+    // page index of the latest copy of every record, over both blocks
+    uint16_t latest[ NVSTORE_MAX_RECORDS ];
+
+    uint8_t block;
+    uint16_t next_page;
+    uint32_t sequence;
+
+    uint32_t page[ NVSTORE_PAGE_SIZE / 4 ];
+
+} nvstore_ctx_t;
+
+static nvstore_ctx_t nvstore_ctx;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static uint32_t address_priv ( uint16_t page );
+static bool load_priv ( uint16_t page );
+static bool program_priv ( uint16_t page );
+static bool move_priv ( );
+static void wait_priv ( );
+static uint16_t crc_priv ( const uint8_t *data, uint16_t length );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void nvstore_init ( )
+{
+    nvstore_header_t *hdr = ( nvstore_header_t * )nvstore_ctx.page;
+    uint32_t latest_seq[ NVSTORE_MAX_RECORDS ];
+    uint32_t newest = 0;
+    uint16_t page;
+    uint8_t i;
+
+    for ( i = 0; i < NVSTORE_MAX_RECORDS; i++ )
+    {
+        nvstore_ctx.latest[ i ] = NVSTORE_NONE;
+        latest_seq[ i ] = 0;
+    }
+
+    nvstore_ctx.block = 0;
+    nvstore_ctx.next_page = 0;
+    nvstore_ctx.sequence = 0;
+
+    for ( page = 0; page < 2 * NVSTORE_PAGES_PER_BLOCK; page++ )
+    {
+        if ( !load_priv( page ) )
+        {
+            continue;
+        }
+
+        if ( hdr->sequence >= latest_seq[ hdr->id ] )
+        {
+            latest_seq[ hdr->id ] = hdr->sequence;
+            nvstore_ctx.latest[ hdr->id ] = page;
+        }
+
+        // the newest page tells which block is active
+        if ( hdr->sequence >= newest )
+        {
+            newest = hdr->sequence;
+            nvstore_ctx.sequence = hdr->sequence;
+            nvstore_ctx.block = page / NVSTORE_PAGES_PER_BLOCK;
+            nvstore_ctx.next_page = page + 1;
+        }
+    }
+
+    // pages are written in order, the first blank one follows the newest
+    if ( nvstore_ctx.sequence == 0 )
+    {
+        nvstore_ctx.next_page = 0;
+    }
+}
+
+bool nvstore_read ( NVSTORE_ID id, void *data, uint16_t length )
+{
+    nvstore_header_t *hdr = ( nvstore_header_t * )nvstore_ctx.page;
+
+    if ( ( id >= NVSTORE_MAX_RECORDS ) || ( nvstore_ctx.latest[ id ] == NVSTORE_NONE ) )
+    {
+        return false;
+    }
+
+    if ( !load_priv( nvstore_ctx.latest[ id ] ) || ( hdr->length != length ) )
+    {
+        return false;
+    }
+
+    memcpy( data, hdr + 1, length );
+
+    return true;
+}
+
+bool nvstore_write ( NVSTORE_ID id, const void *data, uint16_t length )
+{
+    nvstore_header_t *hdr = ( nvstore_header_t * )nvstore_ctx.page;
+
+    if ( ( id >= NVSTORE_MAX_RECORDS ) || ( length > NVSTORE_MAX_LENGTH ) )
+    {
+        return false;
+    }
+
+    // end of the active block: carry the other records over first
+    if ( nvstore_ctx.next_page == ( nvstore_ctx.block + 1 ) * NVSTORE_PAGES_PER_BLOCK )
+    {
+        nvstore_ctx.latest[ id ] = NVSTORE_NONE;
+        if ( !move_priv( ) )
+        {
+            return false;
+        }
+    }
+
+    memset( nvstore_ctx.page, 0xFF, sizeof( nvstore_ctx.page ) );
+    hdr->magic = NVSTORE_MAGIC;
+    hdr->sequence = nvstore_ctx.sequence + 1;
+    hdr->id = id;
+    hdr->length = length;
+    hdr->reserved = 0xFFFF;
+    memcpy( hdr + 1, data, length );
+    hdr->crc = crc_priv( ( const uint8_t * )( hdr + 1 ), length );
+
+    if ( !program_priv( nvstore_ctx.next_page ) )
+    {
+        // a damaged page is skipped, the previous copy is still valid
+        nvstore_ctx.next_page++;
+        return false;
+    }
+
+    nvstore_ctx.sequence++;
+    nvstore_ctx.latest[ id ] = nvstore_ctx.next_page;
+    nvstore_ctx.next_page++;
+
+    return true;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static uint32_t address_priv ( uint16_t page )
+{
+    return NVSTORE_BASE_ADDRESS + ( uint32_t )page * NVSTORE_PAGE_SIZE;
+}
+
+static bool load_priv ( uint16_t page )
+{
+    nvstore_header_t *hdr = ( nvstore_header_t * )nvstore_ctx.page;
+
+    NVMCTRL_Read( nvstore_ctx.page, NVSTORE_PAGE_SIZE, address_priv( page ) );
+
+    return ( hdr->magic == NVSTORE_MAGIC ) && ( hdr->id < NVSTORE_MAX_RECORDS ) &&
+           ( hdr->length <= NVSTORE_MAX_LENGTH ) &&
+           ( hdr->crc == crc_priv( ( const uint8_t * )( hdr + 1 ), hdr->length ) );
+}
+
+static bool program_priv ( uint16_t page )
+{
+    uint32_t verify[ 4 ];
+
+    wait_priv( );
+    NVMCTRL_PageWrite( nvstore_ctx.page, address_priv( page ) );
+    wait_priv( );
+
+    if ( NVMCTRL_ErrorGet( ) != 0 )
+    {
+        return false;
+    }
+
+    // the header is enough to catch a page that was not blank
+    NVMCTRL_Read( verify, sizeof( verify ), address_priv( page ) );
+
+    return memcmp( verify, nvstore_ctx.page, sizeof( verify ) ) == 0;
+}
+
+static bool move_priv ( )
+{
+    uint8_t dest = nvstore_ctx.block ^ 1;
+    uint16_t next = dest * NVSTORE_PAGES_PER_BLOCK;
+    uint8_t i;
+
+    wait_priv( );
+    NVMCTRL_BlockErase( address_priv( next ) );
+    wait_priv( );
+
+    for ( i = 0; i < NVSTORE_MAX_RECORDS; i++ )
+    {
+        if ( ( nvstore_ctx.latest[ i ] == NVSTORE_NONE ) || !load_priv( nvstore_ctx.latest[ i ] ) )
+        {
+            continue;
+        }
+
+        // copies keep their order but get new sequence numbers
+        ( ( nvstore_header_t * )nvstore_ctx.page )->sequence = ++nvstore_ctx.sequence;
+        if ( !program_priv( next ) )
+        {
+            return false;
+        }
+        nvstore_ctx.latest[ i ] = next;
+        next++;
+    }
+
+    nvstore_ctx.block = dest;
+    nvstore_ctx.next_page = next;
+
+    return true;
+}
+
+static void wait_priv ( )
+{
+    while ( NVMCTRL_IsBusy( ) )
+    {
+    }
+}
+
+static uint16_t crc_priv ( const uint8_t *data, uint16_t length )
+{
+    uint16_t crc = 0xFFFF;
+    uint16_t i;
+    uint8_t bit;
+
+    // CRC-16/CCITT
+    for ( i = 0; i < length; i++ )
+    {
+        crc ^= ( uint16_t )data[ i ] << 8;
+        for ( bit = 0; bit < 8; bit++ )
+        {
+            crc = ( crc & 0x8000 ) ? ( crc << 1 ) ^ 0x1021 : ( crc << 1 );
+        }
+    }
+
+    return crc;
+}
+
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,107 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the persistent record store.
+ *
+ * Small records (calibration, characterization results) are kept in the
+ * last two 8 KB blocks of the main flash. Every write appends a whole page
+ * holding one record, tagged with a sequence number and a CRC, so the
+ * previous copy stays valid until the new one is complete. When the active
+ * block is full, the latest copy of every record is moved to the other
+ * block before it is written; a block is only erased when it becomes the
+ * destination of such a move.
+ *
+ * \addtogroup nvstore Persistent Record Store
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef NVSTORE_H
+#define NVSTORE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+/* Last two blocks of the 1 MB flash, kept out of the application image */
+#define NVSTORE_BLOCK_SIZE          8192UL
+#define NVSTORE_PAGE_SIZE           512UL
+#define NVSTORE_BASE_ADDRESS        ( 0x00100000UL - 2 * NVSTORE_BLOCK_SIZE )
+
+#define NVSTORE_PAGES_PER_BLOCK     ( NVSTORE_BLOCK_SIZE / NVSTORE_PAGE_SIZE )
+#define NVSTORE_MAX_RECORDS         8
+#define NVSTORE_MAX_LENGTH          ( NVSTORE_PAGE_SIZE - 16 )
+
+/** \} */ // End group macro
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup type Types
+ * \{
+ */
+
+/**
+ * @brief Record identifiers, below NVSTORE_MAX_RECORDS.
+ */
+typedef enum
+{
+    NVSTORE_ID_STEP_RESPONSE = 1,
+
+} NVSTORE_ID;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Initialization function.
+ *
+ * @description This function scans both blocks for the latest copy of every
+ * record and the first free page.
+ */
+void nvstore_init ( );
+
+/**
+ * @brief Read function.
+ *
+ * @param id           Record identifier.
+ * @param data         Buffer the record is copied to.
+ * @param length       Expected record length.
+ *
+ * @returns true if a valid copy with the expected length was found.
+ */
+bool nvstore_read ( NVSTORE_ID id, void *data, uint16_t length );
+
+/**
+ * @brief Write function.
+ *
+ * @param id           Record identifier.
+ * @param data         Record contents.
+ * @param length       Record length, up to NVSTORE_MAX_LENGTH.
+ *
+ * @returns true if the record was written and verified.
+ *
+ * @description This function blocks while the page is programmed, and while
+ * the other block is erased when the active one is full.
+ */
+bool nvstore_write ( NVSTORE_ID id, const void *data, uint16_t length );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _NVSTORE_H_
@@ -0,0 +1,124 @@
+/* ************************************************************************** */
+/** Compile-time pin access
+
+  @Summary
+    A pin as a type: its PORT group, its index in the group and whether it
+    is active high or low.
+
+  @Description
+    Every function of Pin is an inline single load or store to a constant
+    address, as the generated PS_ON_Set() and alike macros, but the port,
+    the bit and the polarity are checked by the compiler and written in one
+    place (board.h) instead of at every use.
+
+    on() and off() are the function of the pin, set() and clear() its
+    level: PS_ON is active low, PsOn::on() clears it.
+
+    PinSet switches pins of one group together, each direction in a single
+    OUTSET or OUTCLR store, so no other pin of the group is touched and
+    an interrupt cannot see half of the set switched. A set with pins of
+    both polarities takes two stores for on() and off().
+ */
+/* ************************************************************************** */
+
+#ifndef _PIN_H    /* Guard against multiple inclusion */
+#define _PIN_H
+
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <stdint.h>
+#include <stdbool.h>
+/* Through the include path, the simulation supplies its own */
+#include <drivers/port_group.h>
+
+enum class PinPolarity
+{
+    ActiveHigh,
+    ActiveLow
+};
+
+template <uint8_t Port, uint8_t Index, PinPolarity Polarity = PinPolarity::ActiveHigh>
+struct Pin
+{
+    static_assert(Index < 32, "a PORT group has 32 pins");
+
+    static constexpr uint8_t port = Port;
+    static constexpr uint8_t index = Index;
+    static constexpr uint32_t mask = 1UL << Index;
+    static constexpr uint32_t activeHigh = (Polarity == PinPolarity::ActiveHigh) ? mask : 0;
+
+    static void set() { PortGroup<Port>::Set(mask); }
+    static void clear() { PortGroup<Port>::Clear(mask); }
+    static void toggle() { PortGroup<Port>::Toggle(mask); }
+    static bool get() { return PortGroup<Port>::Read(mask) != 0; }
+
+    static void on() { activeHigh ? set() : clear(); }
+    static void off() { activeHigh ? clear() : set(); }
+    static void write(bool active) { active ? on() : off(); }
+    static bool isOn() { return get() == (activeHigh != 0); }
+};
+
+template <typename... Pins>
+struct PinMasks;
+
+template <>
+struct PinMasks<>
+{
+    static constexpr uint32_t mask = 0;
+    static constexpr uint32_t activeHigh = 0;
+    static constexpr bool distinct = true;
+    static constexpr bool inPort(uint8_t) { return true; }
+};
+
+template <typename P, typename... Rest>
+struct PinMasks<P, Rest...>
+{
+    static constexpr uint32_t mask = P::mask | PinMasks<Rest...>::mask;
+    static constexpr uint32_t activeHigh = P::activeHigh | PinMasks<Rest...>::activeHigh;
+    static constexpr bool distinct = ((P::mask & PinMasks<Rest...>::mask) == 0) && PinMasks<Rest...>::distinct;
+    static constexpr bool inPort(uint8_t port) { return (P::port == port) && PinMasks<Rest...>::inPort(port); }
+};
+
+template <typename First, typename... Rest>
+struct PinSet
+{
+    static_assert(PinMasks<First, Rest...>::inPort(First::port), "the pins of a set have to be in one PORT group");
+    static_assert(PinMasks<First, Rest...>::distinct, "a pin is in the set twice");
+
+    static constexpr uint8_t port = First::port;
+    static constexpr uint32_t mask = PinMasks<First, Rest...>::mask;
+    static constexpr uint32_t activeHigh = PinMasks<First, Rest...>::activeHigh;
+    static constexpr uint32_t activeLow = mask & ~activeHigh;
+
+    static void set() { PortGroup<port>::Set(mask); }
+    static void clear() { PortGroup<port>::Clear(mask); }
+
+    static void on()
+    {
+        if (activeHigh != 0)
+            PortGroup<port>::Set(activeHigh);
+        if (activeLow != 0)
+            PortGroup<port>::Clear(activeLow);
+    }
+
+    static void off()
+    {
+        if (activeHigh != 0)
+            PortGroup<port>::Clear(activeHigh);
+        if (activeLow != 0)
+            PortGroup<port>::Set(activeLow);
+    }
+
+    // levels has a bit set for every pin of the set to be driven high
+    static void write(uint32_t levels)
+    {
+        PortGroup<port>::Set(levels & mask);
+        PortGroup<port>::Clear(~levels & mask);
+    }
+};
+
+#endif /* _PIN_H */
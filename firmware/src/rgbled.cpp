@@ -8,72 +8,409 @@
 /* Section: Included Files                                                    */
 /* ************************************************************************** */
 /* ************************************************************************** */
+#include <string.h>
 #include "rgbled.h"
 #include "definitions.h"
+#include "anomaly.h"
 
 #define RGBLED_MIN      0
 #define RGBLED_MAX      30000
 
+/* The temperature color runs from this far below the setpoint to this far above */
+#define RGBLED_COLD_C   2
+#define RGBLED_HOT_C    10
+/* in 0.05 C steps, about one level of red and blue each */
+#define RGBLED_TEMP_STEP        5
+#define RGBLED_TEMP_COLORS      ((RGBLED_COLD_C + RGBLED_HOT_C) * 100 / RGBLED_TEMP_STEP + 1)
+
+#define RGBLED_FADE_FRAMES      (RGBLED_FADE_MS * RGBLED_PATTERN_HZ / 1000)
+
+#define RGBLED_ALERT_CODES      5
+
 /* ************************************************************************** */
 /* ************************************************************************** */
 /* Section: File Scope or Global Data                                         */
 /* ************************************************************************** */
 /* ************************************************************************** */
 
+/* One level (0..255) per pattern frame */
+struct RGBWave
+{
+    const uint8_t* level;
+    uint16_t frames;
+};
+
+/* MakeTable<Curve, N>::Type is Table<Curve, 0, 1, ... N - 1>, whose value[i]
+   is Curve::at(i) */
+template <typename Curve, uint16_t... Index>
+struct Table
+{
+    static constexpr decltype(Curve::at(0)) value[sizeof...(Index)] = { Curve::at(Index)... };
+};
+
+template <typename Curve, uint16_t... Index>
+constexpr decltype(Curve::at(0)) Table<Curve, Index...>::value[sizeof...(Index)];
+
+template <typename Curve, uint16_t N, uint16_t... Index>
+struct MakeTable : MakeTable<Curve, N - 1, N - 1, Index...> {};
+
+template <typename Curve, uint16_t... Index>
+struct MakeTable<Curve, 0, Index...>
+{
+    typedef Table<Curve, Index...> Type;
+};
+
+/* x^2.2 is x^2 times the fifth root of x, found by Newton from 1: from
+   above it converges in a handful of steps for x >= 1/255 */
+constexpr double fifthRoot(double x, double g, int steps)
+{
+    return (steps == 0)? g : fifthRoot(x, g - (g * g * g * g * g - x) / (5.0 * g * g * g * g), steps - 1);
+}
+
+struct GammaCurve
+{
+    static constexpr uint16_t at(uint16_t level)
+    {
+        // the LED is active low: the full period is off
+        return (uint16_t)(RGBLED_MAX - (uint32_t)((double)RGBLED_MAX * (level / 255.0) * (level / 255.0) *
+                                                  fifthRoot(level / 255.0, 1.0, 16) + 0.5));
+    }
+};
+
+typedef MakeTable<GammaCurve, 256>::Type Gamma;
+
+static_assert(Gamma::value[0] == RGBLED_MAX && Gamma::value[255] == RGBLED_MIN, "the gamma table has to span the PWM period");
+static_assert(Gamma::value[128] > RGBLED_MAX * 3 / 4, "half level is about a fifth of the light");
+
+/* From blue, cold, to red, hot, one entry per RGBLED_TEMP_STEP above the
+   cold end */
+struct TempColor
+{
+    uint8_t red;
+    uint8_t green;
+    uint8_t blue;
+};
+
+struct TempCurve
+{
+    static constexpr TempColor at(uint16_t i)
+    {
+        return TempColor{ (uint8_t)(i * 255 / (RGBLED_TEMP_COLORS - 1)), 0,
+                          (uint8_t)((RGBLED_TEMP_COLORS - 1 - i) * 255 / (RGBLED_TEMP_COLORS - 1)) };
+    }
+};
+
+typedef MakeTable<TempCurve, RGBLED_TEMP_COLORS>::Type TempColors;
+
+static_assert(TempColors::value[0].blue == 255 && TempColors::value[0].red == 0 &&
+              TempColors::value[RGBLED_TEMP_COLORS - 1].red == 255 && TempColors::value[RGBLED_TEMP_COLORS - 1].blue == 0,
+              "the temperature colors have to run from blue to red");
+
+/* cos(x) for 0 <= x <= 2 pi, by the series around pi: 12 terms are far
+   below a level step */
+constexpr double cosNext(double x2, int k, double term)
+{
+    return -term * x2 / ((2 * k + 1) * (2 * k + 2));
+}
+
+constexpr double cosSeries(double x2, int k, double term, double sum)
+{
+    return (k == 12)? sum : cosSeries(x2, k + 1, cosNext(x2, k, term), sum + cosNext(x2, k, term));
+}
+
+constexpr double cosine(double x)
+{
+    return -cosSeries((x - 3.14159265358979) * (x - 3.14159265358979), 0, 1.0, 1.0);
+}
+
+/* From full down to Floor and back in Frames */
+template <uint16_t Frames, uint8_t Floor>
+struct BreatheCurve
+{
+    static constexpr uint16_t frames = Frames;
+    static constexpr uint8_t at(uint16_t i)
+    {
+        return (uint8_t)(Floor + (255 - Floor) * (1.0 + cosine(2.0 * 3.14159265358979 * i / Frames)) / 2.0 + 0.5);
+    }
+};
+
+/* Two dips of 90 ms to a quarter, full for the rest of the 3 s */
+struct DipCurve
+{
+    static constexpr uint16_t frames = 3 * RGBLED_PATTERN_HZ;
+    static constexpr uint8_t at(uint16_t i)
+    {
+        return (i < 3 || (i >= 6 && i < 9))? 64 : 255;
+    }
+};
+
+/* Blinks of 190 ms every 375 ms, then dark to the end of the 4 s */
+template <uint8_t Blinks>
+struct CodeCurve
+{
+    static constexpr uint16_t frames = RGBLED_PATTERN_FRAMES;
+    static constexpr uint8_t at(uint16_t i)
+    {
+        return (i < 12 * Blinks && (i % 12) < 6)? 255 : 0;
+    }
+};
+
+template <typename Curve>
+constexpr RGBWave wave()
+{
+    static_assert(Curve::frames <= RGBLED_PATTERN_FRAMES, "the pattern has to fit the DMA tables");
+    return { MakeTable<Curve, Curve::frames>::Type::value, Curve::frames };
+}
+
+static const RGBWave runningWave = wave<BreatheCurve<3 * RGBLED_PATTERN_HZ, 96>>();
+static const RGBWave standbyWave = wave<BreatheCurve<4 * RGBLED_PATTERN_HZ, 0>>();
+static const RGBWave connectedWave = wave<DipCurve>();
+
+/* Most severe first, any other alert takes the last code */
+static const uint8_t alertOrder[RGBLED_ALERT_CODES] =
+{
+    Alert_CoolingFailure, Alert_ActuatorMismatch, Alert_DoorStall, Alert_SensorStuck, Alert_DoorOpen
+};
+
+static const RGBWave alertWaves[RGBLED_ALERT_CODES] =
+{
+    wave<CodeCurve<1>>(), wave<CodeCurve<2>>(), wave<CodeCurve<3>>(), wave<CodeCurve<4>>(), wave<CodeCurve<5>>()
+};
+
+static const uint8_t alertColors[RGBLED_ALERT_CODES][3] =
+{
+    { 255, 0, 0 }, { 255, 0, 255 }, { 255, 255, 255 }, { 255, 160, 0 }, { 0, 200, 255 }
+};
+
+/* The LED has DMAC channels 2 to 4 to itself, for red, green and blue, each
+   with a descriptor linked to itself over the table of its color */
+static const DMAC_CHANNEL rgbledDmac[3] = { DMAC_CHANNEL_2, DMAC_CHANNEL_3, DMAC_CHANNEL_4 };
+static dmac_descriptor_registers_t rgbledDesc[3] __ALIGNED(16);
+static uint32_t rgbledDuty[3][RGBLED_PATTERN_FRAMES];
+
+static_assert(RGBLED_FADE_FRAMES > 0 && RGBLED_FADE_FRAMES <= RGBLED_PATTERN_FRAMES, "the fade has to fit the DMA tables");
+
+/* Start the channels over the first frames of the tables, looping or once */
+static void rgbledStart(uint16_t frames, bool loop)
+{
+    rgbledDesc[0].DMAC_DSTADDR = (uintptr_t)&TCC1_REGS->TCC_CCBUF[TCC1_CHANNEL0];
+    rgbledDesc[1].DMAC_DSTADDR = (uintptr_t)&TCC0_REGS->TCC_CCBUF[TCC0_CHANNEL3];
+    rgbledDesc[2].DMAC_DSTADDR = (uintptr_t)&TCC0_REGS->TCC_CCBUF[TCC0_CHANNEL2];
+    for (uint8_t c = 0; c < 3; c++)
+    {
+        rgbledDesc[c].DMAC_BTCTRL = (uint16_t)DMAC_ChannelSettingsGet(rgbledDmac[c]);
+        rgbledDesc[c].DMAC_BTCNT = frames;
+        // with SRCINC the source is given by its end
+        rgbledDesc[c].DMAC_SRCADDR = (uintptr_t)&rgbledDuty[c][frames];
+        // with no next descriptor the channel stops, the TCC keeps the last duty
+        rgbledDesc[c].DMAC_DESCADDR = loop? (uintptr_t)&rgbledDesc[c] : 0;
+        DMAC_LinkedListTransfer(rgbledDmac[c], &rgbledDesc[c]);
+    }
+}
+
 uint32_t RGBLed::map(uint8_t v)
 {
-    return RGBLED_MAX - (((uint32_t)v * RGBLED_MAX) / 255);
+    return Gamma::value[v];
 }
 
-RGBLed::RGBColor RGBLed::temperatureToRGB(float temperature, float setpoint) {
-    // Define the temperature range (adjust as needed)
-    float min_temp = setpoint - 2.0;
-    float max_temp = setpoint + 10.0;
+RGBLed::RGBColor RGBLed::temperatureToRGB(CentiCelsius temperature, DeciCelsius setpoint) {
+    CentiCelsius min_temp = setpoint.to<100>() - CentiCelsius::fromDegrees(RGBLED_COLD_C);
+    CentiCelsius max_temp = setpoint.to<100>() + CentiCelsius::fromDegrees(RGBLED_HOT_C);
 
     if (temperature < min_temp)
         temperature = min_temp;
     if (temperature > max_temp)
         temperature = max_temp;
-    
-    // Map temperature to a value between 0 and 1
-    float normalized_temp = (float)(temperature - min_temp) / (max_temp - min_temp);
-    
-    // Interpolate between blue (cold) and red (hot) using the normalized temperature
-    int blue = (int)((1.0 - normalized_temp) * 255.0);
-    int red = (int)(normalized_temp * 255.0);
-    int green = 0;  // You can modify this based on your preference
-    
-    // Ensure values are within the valid RGB range (0 to 255)
-    red = (red < 0) ? 0 : ((red > 255) ? 255 : red);
-    blue = (blue < 0) ? 0 : ((blue > 255) ? 255 : blue);
-    green = (green < 0) ? 0 : ((green > 255) ? 255 : green);
-    
-    RGBColor rgb_color = {red, green, blue};
+
+    // the nearest entry of the table
+    const TempColor& c = TempColors::value[((temperature - min_temp).raw() + RGBLED_TEMP_STEP / 2) / RGBLED_TEMP_STEP];
+
+    RGBColor rgb_color = {c.red, c.green, c.blue};
     return rgb_color;
 }
 
 void RGBLed::init()
-{    
+{
+    memset(_tempColor, 0, sizeof(_tempColor));
+    _alerts = Alert_None;
+    _standby = false;
+    _running = false;
+    _connected = false;
+    _wave = NULL;
+    _fade = false;
+
     TCC0_PWMStart();
     TCC1_PWMStart();
-    TCC1_PWM24bitDutySet(TCC1_CHANNEL0, RGBLED_MAX); 
-    TCC0_PWM24bitDutySet(TCC0_CHANNEL3, RGBLED_MAX); 
-    TCC0_PWM24bitDutySet(TCC0_CHANNEL2, RGBLED_MAX); 
+    update(0, 0, 0);
 }
 
 void RGBLed::update(uint8_t r, uint8_t g, uint8_t b)
 {
-    int rd = map(r);
-    int gd = map(g);
-    int bd = map(b);
+    stopWave();
+    _pattern = RGBPattern_Manual;
+
+    _level[0] = r;
+    _level[1] = g;
+    _level[2] = b;
+    show(_level);
+}
+
+void RGBLed::fadeTo(uint8_t r, uint8_t g, uint8_t b)
+{
+    _pattern = RGBPattern_Manual;
+
+    // already there or on the way
+    if (_fade && _to[0] == r && _to[1] == g && _to[2] == b)
+        return;
+
+    stopWave();
+    if (_level[0] == r && _level[1] == g && _level[2] == b)
+        return;
+
+    for (uint8_t c = 0; c < 3; c++)
+        _from[c] = _level[c];
+    _to[0] = r;
+    _to[1] = g;
+    _to[2] = b;
+
+    for (uint8_t c = 0; c < 3; c++)
+    {
+        for (uint16_t i = 0; i < RGBLED_FADE_FRAMES; i++)
+            rgbledDuty[c][i] = map(fadeLevel(c, i + 1));
+    }
+    rgbledStart(RGBLED_FADE_FRAMES, false);
+    _fade = true;
+}
+
+void RGBLed::color(uint8_t& r, uint8_t& g, uint8_t& b)
+{
+    const uint8_t* level = _fade? _to : _level;
 
-    TCC1_PWM24bitDutySet(TCC1_CHANNEL0, rd); 
-    TCC0_PWM24bitDutySet(TCC0_CHANNEL3, gd); 
-    TCC0_PWM24bitDutySet(TCC0_CHANNEL2, bd); 
+    r = level[0];
+    g = level[1];
+    b = level[2];
 }
 
-void RGBLed::updateFromTemp(float t, float sp)
+void RGBLed::updateFromTemp(CentiCelsius t, DeciCelsius sp)
 {
     RGBColor c = temperatureToRGB(t, sp);
-    update(c.red, c.green, c.blue);
+
+    _tempColor[0] = c.red;
+    _tempColor[1] = c.green;
+    _tempColor[2] = c.blue;
+    refresh();
+}
+
+void RGBLed::updateFromAlerts(uint8_t alerts)
+{
+    _alerts = alerts;
+    refresh();
+}
+
+void RGBLed::setLoads(bool mains, bool fan, bool cell)
+{
+    _standby = !mains;
+    _running = mains && (fan || cell);
+    refresh();
+}
+
+void RGBLed::setConnected(bool connected)
+{
+    _connected = connected;
+    refresh();
+}
+
+void RGBLed::show(const uint8_t level[3])
+{
+    // into CCBUF, the TCC takes it at the end of the period
+    TCC1_PWM24bitDutySet(TCC1_CHANNEL0, map(level[0]));
+    TCC0_PWM24bitDutySet(TCC0_CHANNEL3, map(level[1]));
+    TCC0_PWM24bitDutySet(TCC0_CHANNEL2, map(level[2]));
+}
+
+uint8_t RGBLed::fadeLevel(uint8_t c, uint16_t frame)
+{
+    int32_t span = (int32_t)_to[c] - _from[c];
+    return (uint8_t)(_from[c] + span * frame / RGBLED_FADE_FRAMES);
+}
+
+void RGBLed::refresh()
+{
+    if (_alerts != Alert_None)
+    {
+        uint8_t code = 0;
+        while (code < RGBLED_ALERT_CODES - 1 && (_alerts & alertOrder[code]) == 0)
+            code++;
+        play(RGBPattern_Alert, &alertWaves[code], alertColors[code]);
+    }
+    else if (_standby)
+        play(RGBPattern_Standby, &standbyWave, _tempColor);
+    else if (_connected)
+        play(RGBPattern_Connected, &connectedWave, _tempColor);
+    else if (_running)
+        play(RGBPattern_Running, &runningWave, _tempColor);
+    else
+    {
+        fadeTo(_tempColor[0], _tempColor[1], _tempColor[2]);
+        _pattern = RGBPattern_Steady;
+    }
+}
+
+void RGBLed::play(RGBPattern pattern, const RGBWave* wave, const uint8_t color[3])
+{
+    bool restart = (wave != _wave);
+
+    _pattern = pattern;
+    if (!restart && memcmp(color, _waveColor, sizeof(_waveColor)) == 0)
+        return;
+
+    if (restart)
+        stopWave();
+
+    // a new color goes in under the running DMA, one frame may mix the two
+    memcpy(_waveColor, color, sizeof(_waveColor));
+    for (uint8_t c = 0; c < 3; c++)
+    {
+        for (uint16_t i = 0; i < wave->frames; i++)
+            rgbledDuty[c][i] = map((uint8_t)(((uint32_t)color[c] * wave->level[i] + 127) / 255));
+    }
+
+    if (!restart)
+        return;
+
+    rgbledStart(wave->frames, true);
+    _wave = wave;
+}
+
+void RGBLed::stopWave()
+{
+    if (_wave == NULL && !_fade)
+        return;
+
+    for (uint8_t c = 0; c < 3; c++)
+        DMAC_ChannelDisable(rgbledDmac[c]);
+
+    // the last frame may still wait in the buffers for the end of the
+    // period, and a duty set before that is refused
+    while ((TCC1_REGS->TCC_STATUS & TCC_STATUS_CCBUFV0_Msk) != 0U ||
+           (TCC0_REGS->TCC_STATUS & (TCC_STATUS_CCBUFV2_Msk | TCC_STATUS_CCBUFV3_Msk)) != 0U)
+    {
+    }
+
+    uint16_t count = DMAC_ChannelGetTransferredCount(rgbledDmac[0]);
+    if (_fade)
+    {
+        // the fade stopped at the frame it got to, all of them once ended
+        for (uint8_t c = 0; c < 3; c++)
+            _level[c] = fadeLevel(c, count);
+    }
+    else
+    {
+        // a fade goes on from the frame written last
+        uint16_t frame = (count + _wave->frames - 1) % _wave->frames;
+        for (uint8_t c = 0; c < 3; c++)
+            _level[c] = (uint8_t)(((uint32_t)_waveColor[c] * _wave->level[frame] + 127) / 255);
+    }
+    _wave = NULL;
+    _fade = false;
 }
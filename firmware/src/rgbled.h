@@ -1,5 +1,25 @@
 /* ************************************************************************** */
 /** RGB LED handling functions
+
+  @Description
+    The levels given in 0..255 are gamma corrected (2.2) through a table
+    of TCC duty values built by the compiler, so equal steps of level look
+    like equal steps of brightness.
+
+    update() shows a color at once, fadeTo() moves to it in
+    RGBLED_FADE_MS. The TCC takes a duty written to its buffered compare
+    register at the end of the PWM period, so no period is cut short.
+
+    The status of the case is shown as a pattern, the first that applies of
+    an alert blink code, the supply off, the app connected and the loads
+    running; with none the temperature color stays steady. Patterns are
+    tables of one duty value per frame and color, written once when the
+    pattern or its color changes. DMAC channels 2 to 4 move them to the
+    buffered compare registers, one frame on every RTC periodic event 2
+    routed by EVSYS channel 0, so a pattern goes on without the CPU, also
+    while it sleeps. A fade is played the same way, once: its ramp from the
+    level shown to the new one is written to the tables and the channels
+    stop at the last frame, which the TCC then keeps.
  */
 /* ************************************************************************** */
 
@@ -13,6 +33,26 @@
 /* ************************************************************************** */
 /* ************************************************************************** */
 #include <stdint.h>
+#include "celsius.h"
+
+#define RGBLED_FADE_MS          500
+
+/* RTC periodic event 2: the 1024 Hz RTC clock divided by 2^5 */
+#define RGBLED_PATTERN_HZ       32
+#define RGBLED_PATTERN_FRAMES   128
+
+typedef enum
+{
+    RGBPattern_Steady,          // the temperature color, faded from reading to reading
+    RGBPattern_Running,         // the temperature color breathing, a load is on
+    RGBPattern_Connected,       // the temperature color dipping twice every 3 s
+    RGBPattern_Standby,         // the temperature color breathing deep and slow, the supply is off
+    RGBPattern_Alert,           // the color of the alert, blinking its code every 4 s
+    RGBPattern_Manual,          // a color given to update() or fadeTo()
+
+} RGBPattern;
+
+struct RGBWave;
 
 class RGBLed
 {
@@ -32,10 +72,72 @@ public:
         void update(uint8_t r, uint8_t g, uint8_t b) 
 
       @Summary
-        Update the RGB LED with the given color
+        Update the RGB LED with the given color, in place of the pattern
+        until the next status given
      */
     void update(uint8_t r, uint8_t g, uint8_t b);
-    void updateFromTemp(float t, float sp);
+
+    /**
+      @Function
+        void fadeTo(uint8_t r, uint8_t g, uint8_t b)
+
+      @Summary
+        Fade from the color shown to the given one; a fade going on starts
+        over from where it got to
+     */
+    void fadeTo(uint8_t r, uint8_t g, uint8_t b);
+
+    /**
+      @Function
+        void color(uint8_t& r, uint8_t& g, uint8_t& b)
+
+      @Summary
+        The color shown, or the one a fade is going to
+     */
+    void color(uint8_t& r, uint8_t& g, uint8_t& b);
+
+    /**
+      @Function
+        void updateFromTemp(CentiCelsius t, DeciCelsius sp)
+
+      @Summary
+        Fade to the color of the temperature, from blue at 2 C below the
+        setpoint to red at 10 C above it
+     */
+    void updateFromTemp(CentiCelsius t, DeciCelsius sp);
+
+    /**
+      @Function
+        void updateFromAlerts(uint8_t alerts)
+
+      @Summary
+        Blink the color and the code of the most severe alert: one red
+        blink for a cooling failure, two magenta for an actuator mismatch,
+        three white for a door stall, four yellow for a stuck sensor, five
+        cyan for the door left open. Alert_None goes back to the status
+     */
+    void updateFromAlerts(uint8_t alerts);
+
+    /**
+      @Function
+        void setLoads(bool mains, bool fan, bool cell)
+
+      @Summary
+        Breathe while the fan or the cell is on, slower and deeper while the
+        supply is off
+     */
+    void setLoads(bool mains, bool fan, bool cell);
+
+    /**
+      @Function
+        void setConnected(bool connected)
+
+      @Summary
+        Dip the temperature color twice every 3 s while the app is connected
+     */
+    void setConnected(bool connected);
+
+    RGBPattern pattern() { return _pattern; }
 
 private:
     typedef struct {
@@ -45,7 +147,31 @@ private:
     } RGBColor;
 
     uint32_t map(uint8_t v);
-    RGBColor temperatureToRGB(float temperature, float setpoint);
+    void show(const uint8_t level[3]);
+    uint8_t fadeLevel(uint8_t c, uint16_t frame);
+    RGBColor temperatureToRGB(CentiCelsius temperature, DeciCelsius setpoint);
+    void refresh();
+    void play(RGBPattern pattern, const RGBWave* wave, const uint8_t color[3]);
+    void stopWave();
+
+    // red, green, blue
+    uint8_t _level[3];
+    uint8_t _from[3];
+    uint8_t _to[3];
+    // the DMA plays a fade from _from to _to, or has played it to the end
+    bool _fade;
+
+    // what decides the pattern
+    uint8_t _tempColor[3];
+    uint8_t _alerts;
+    bool _standby;
+    bool _running;
+    bool _connected;
+
+    // the pattern shown and, while the DMA plays it, its wave and color
+    RGBPattern _pattern;
+    const RGBWave* _wave;
+    uint8_t _waveColor[3];
 };
 
 #endif /* _EXAMPLE_FILE_NAME_H */
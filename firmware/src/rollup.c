@@ -0,0 +1,192 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include <stddef.h>
+#include "rollup.h"
+
+/**
+ * @brief Open bucket, time weighted.
+ */
+typedef struct
+{
+    uint32_t start_s;
+    bool open;
+
+    int64_t sum;
+    uint32_t total_ms;
+    uint32_t cell_ms;
+    uint32_t fan_ms;
+    int16_t min;
+    int16_t max;
+
+} rollup_acc_t;
+
+/**
+ * @brief Rollup ctx object definition.
+ */
+typedef struct
+{
+    rollup_acc_t acc[ ROLLUP_LEVELS ];
+
+    rollup_bucket_t minutes[ ROLLUP_MINUTES ];
+    rollup_bucket_t hours[ ROLLUP_HOURS ];
+    rollup_bucket_t days[ ROLLUP_DAYS ];
+
+    // next slot and number of valid buckets of every ring
+    uint16_t head[ ROLLUP_LEVELS ];
+    uint16_t count[ ROLLUP_LEVELS ];
+
+} rollup_ctx_t;
+
+static rollup_ctx_t rollup_ctx;
+
+static const uint32_t rollup_period_s[ ROLLUP_LEVELS ] = { 60UL, 3600UL, 86400UL };
+static const uint16_t rollup_size[ ROLLUP_LEVELS ] = { ROLLUP_MINUTES, ROLLUP_HOURS, ROLLUP_DAYS };
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static rollup_bucket_t *ring_priv ( ROLLUP_LEVEL level );
+static void merge_priv ( rollup_acc_t *acc, const rollup_acc_t *from );
+static void close_priv ( ROLLUP_LEVEL level );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void rollup_init ( )
+{
+    uint8_t level;
+
+    for ( level = 0; level < ROLLUP_LEVELS; level++ )
+    {
+        rollup_ctx.acc[ level ].open = false;
+        rollup_ctx.head[ level ] = 0;
+        rollup_ctx.count[ level ] = 0;
+    }
+}
+
+void rollup_add ( uint32_t now_s, int16_t t, bool cell, bool fan, uint32_t weight_ms )
+{
+    rollup_acc_t *acc = &rollup_ctx.acc[ ROLLUP_MINUTE ];
+    rollup_acc_t sample;
+
+    // the minute closes first and cascades into the coarser levels
+    if ( acc->open && ( now_s - acc->start_s >= rollup_period_s[ ROLLUP_MINUTE ] ) )
+    {
+        close_priv( ROLLUP_MINUTE );
+    }
+
+    sample.open = true;
+    sample.start_s = now_s - now_s % rollup_period_s[ ROLLUP_MINUTE ];
+    sample.sum = ( int64_t )t * weight_ms;
+    sample.total_ms = weight_ms;
+    sample.cell_ms = cell ? weight_ms : 0;
+    sample.fan_ms = fan ? weight_ms : 0;
+    sample.min = t;
+    sample.max = t;
+
+    merge_priv( acc, &sample );
+}
+
+uint16_t rollup_count ( ROLLUP_LEVEL level )
+{
+    return ( level < ROLLUP_LEVELS ) ? rollup_ctx.count[ level ] : 0;
+}
+
+bool rollup_get ( ROLLUP_LEVEL level, uint16_t age, rollup_bucket_t *bucket )
+{
+    uint16_t size;
+    uint16_t slot;
+
+    if ( ( level >= ROLLUP_LEVELS ) || ( age >= rollup_ctx.count[ level ] ) )
+    {
+        return false;
+    }
+
+    size = rollup_size[ level ];
+    slot = ( rollup_ctx.head[ level ] + size - 1 - age ) % size;
+    *bucket = ring_priv( level )[ slot ];
+
+    return true;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static rollup_bucket_t *ring_priv ( ROLLUP_LEVEL level )
+{
+    switch ( level )
+    {
+        case ROLLUP_MINUTE:
+            return rollup_ctx.minutes;
+        case ROLLUP_HOUR:
+            return rollup_ctx.hours;
+        default:
+            return rollup_ctx.days;
+    }
+}
+
+static void merge_priv ( rollup_acc_t *acc, const rollup_acc_t *from )
+{
+    if ( !acc->open )
+    {
+        *acc = *from;
+        return;
+    }
+
+    acc->sum += from->sum;
+    acc->total_ms += from->total_ms;
+    acc->cell_ms += from->cell_ms;
+    acc->fan_ms += from->fan_ms;
+    if ( from->min < acc->min )
+    {
+        acc->min = from->min;
+    }
+    if ( from->max > acc->max )
+    {
+        acc->max = from->max;
+    }
+}
+
+static void close_priv ( ROLLUP_LEVEL level )
+{
+    rollup_acc_t *acc = &rollup_ctx.acc[ level ];
+    rollup_bucket_t *bucket = &ring_priv( level )[ rollup_ctx.head[ level ] ];
+    rollup_acc_t *up;
+
+    if ( acc->total_ms > 0 )
+    {
+        bucket->min = acc->min;
+        bucket->max = acc->max;
+        bucket->mean = ( int16_t )( acc->sum / ( int64_t )acc->total_ms );
+        bucket->cell_duty = ( uint8_t )( ( uint64_t )acc->cell_ms * ROLLUP_DUTY_FULL / acc->total_ms );
+        bucket->fan_duty = ( uint8_t )( ( uint64_t )acc->fan_ms * ROLLUP_DUTY_FULL / acc->total_ms );
+
+        rollup_ctx.head[ level ] = ( rollup_ctx.head[ level ] + 1 ) % rollup_size[ level ];
+        if ( rollup_ctx.count[ level ] < rollup_size[ level ] )
+        {
+            rollup_ctx.count[ level ]++;
+        }
+    }
+
+    if ( level + 1 < ROLLUP_LEVELS )
+    {
+        up = &rollup_ctx.acc[ level + 1 ];
+
+        // the coarser bucket closes when the first bucket past its end is
+        // folded, so it is complete and lags by one finer period
+        if ( up->open && ( acc->start_s - up->start_s >= rollup_period_s[ level + 1 ] ) )
+        {
+            close_priv( level + 1 );
+        }
+
+        acc->start_s -= acc->start_s % rollup_period_s[ level + 1 ];
+        merge_priv( up, acc );
+    }
+
+    acc->open = false;
+}
+
+// ------------------------------------------------------------------------- END
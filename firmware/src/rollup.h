@@ -0,0 +1,123 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the multi-resolution sample rollups.
+ *
+ * Every temperature sample is folded into the accumulator of the current
+ * minute; a closed minute is stored in the minute ring and folded into the
+ * hour, and so on up to the day. Each update is O(1) and the rings have a
+ * fixed size, so the history of the last hour, two days and month is
+ * available in about 1 KB and can be sent to the app as is.
+ *
+ * Samples are weighted by the time they stand for, so means and duty cycles
+ * stay right when the sampling period changes.
+ *
+ * \addtogroup rollup Sample Rollups
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef ROLLUP_H
+#define ROLLUP_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+#define ROLLUP_MINUTES              60
+#define ROLLUP_HOURS                48
+#define ROLLUP_DAYS                 31
+
+#define ROLLUP_DUTY_FULL            100
+
+/** \} */ // End group macro
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup type Types
+ * \{
+ */
+
+typedef enum
+{
+    ROLLUP_MINUTE = 0,
+    ROLLUP_HOUR,
+    ROLLUP_DAY,
+    ROLLUP_LEVELS
+
+} ROLLUP_LEVEL;
+
+/**
+ * @brief Closed bucket, temperatures in 0.01 C and duty cycles in percent.
+ */
+typedef struct
+{
+    int16_t min;
+    int16_t max;
+    int16_t mean;
+    uint8_t cell_duty;
+    uint8_t fan_duty;
+
+} rollup_bucket_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Initialization function.
+ *
+ * @description This function empties the rings and the accumulators.
+ */
+void rollup_init ( );
+
+/**
+ * @brief Add function.
+ *
+ * @param now_s        Uptime in seconds, sets the bucket boundaries.
+ * @param t            Temperature in 0.01 C.
+ * @param cell         Cell state over the sample.
+ * @param fan          Fan state over the sample.
+ * @param weight_ms    Time the sample stands for.
+ */
+void rollup_add ( uint32_t now_s, int16_t t, bool cell, bool fan, uint32_t weight_ms );
+
+/**
+ * @brief Count function.
+ *
+ * @param level        Resolution.
+ *
+ * @returns Number of closed buckets held in the ring.
+ */
+uint16_t rollup_count ( ROLLUP_LEVEL level );
+
+/**
+ * @brief Read function.
+ *
+ * @param level        Resolution.
+ * @param age          0 for the latest closed bucket, 1 for the one before...
+ * @param bucket       Filled with the bucket.
+ *
+ * @returns false if the ring does not hold that many buckets.
+ */
+bool rollup_get ( ROLLUP_LEVEL level, uint16_t age, rollup_bucket_t *bucket );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _ROLLUP_H_
@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/** Adaptive sensor sampling
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <stdlib.h>
+#include "sampler.h"
+#include "temphum11.h"
+
+AdaptiveSampler::AdaptiveSampler()
+{
+    init(SAMPLER_MAX_PERIOD_MS);
+}
+
+void AdaptiveSampler::init(uint32_t tickMs)
+{
+    _tickMs = tickMs;
+    _periodMs = tickMs;
+    _elapsedMs = tickMs;
+    _sinceMs = 0;
+    _settleMs = SAMPLER_SETTLE_MS;
+    _primed = false;
+    _ts = FilterCelsius();
+    _rate = FilterCelsius();
+    _cell = false;
+    _fan = false;
+}
+
+bool AdaptiveSampler::due()
+{
+    _sinceMs += _tickMs;
+    if (_sinceMs < _periodMs)
+        return false;
+
+    _elapsedMs = _sinceMs;
+    _sinceMs = 0;
+
+    return true;
+}
+
+void AdaptiveSampler::update(CentiCelsius t, bool cell, bool fan, bool fast)
+{
+    uint32_t tauMs = SAMPLER_SMOOTH_TAU_S * 1000UL;
+
+    if (!_primed)
+    {
+        _ts = t.to<FilterCelsius::perDegree>();
+        _cell = cell;
+        _fan = fan;
+        _primed = true;
+    }
+
+    // first order filter twice: the noise of a 14 bit reading is several
+    // C/min when differentiated over one tick
+    FilterCelsius prev = _ts;
+    _ts.follow(t, _elapsedMs, tauMs);
+    _rate.follow((_ts - prev).scaled(60000, (int32_t)_elapsedMs), _elapsedMs, tauMs);
+
+    if ((cell != _cell) || (fan != _fan))
+        kick();
+    _cell = cell;
+    _fan = fan;
+
+    if (_settleMs < SAMPLER_SETTLE_MS)
+        _settleMs += _elapsedMs;
+
+    // the air may move by SAMPLER_STEP between samples
+    int64_t rate = llabs(_rate.raw());
+    int64_t step = (int64_t)SAMPLER_STEP.to<FilterCelsius::perDegree>().raw() * 60000;
+    uint32_t target = SAMPLER_MAX_PERIOD_MS;
+    if (rate * SAMPLER_MAX_PERIOD_MS > step)
+        target = (uint32_t)(step / rate);
+    if (fast || (_settleMs < SAMPLER_SETTLE_MS))
+        target = _tickMs;
+
+    // whole doublings of the tick: faster at once, slower one step a sample
+    uint32_t period = _tickMs;
+    while ((period * 2 <= target) && (period < 2 * _periodMs))
+        period *= 2;
+
+    _periodMs = period;
+}
+
+void AdaptiveSampler::kick()
+{
+    _settleMs = 0;
+    _periodMs = _tickMs;
+}
+
+uint16_t AdaptiveSampler::resolution()
+{
+    if (_periodMs >= SAMPLER_SLOW_PERIOD_MS)
+        return TEMPHUM11_TEMP_RESOLUTION_14bit | TEMPHUM11_HUM_RESOLUTION_8bit;
+
+    return TEMPHUM11_TEMP_RESOLUTION_14bit | TEMPHUM11_HUM_RESOLUTION_11bit;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/** Adaptive sensor sampling
+
+  @Summary
+    Picks the RTC ticks on which the HDC1080 is read and its resolution.
+
+  @Description
+    The sensor is read each time the air may have moved by SAMPLER_STEP,
+    from every RTC tick up to SAMPLER_MAX_PERIOD_MS: the period is a power
+    of two of the tick, doubles at most once per sample and drops at once.
+    Every tick is sampled for SAMPLER_SETTLE_MS after the cell or fan
+    switch or the door moves, and while the caller needs fast samples (a
+    characterization running, an alert raised).
+
+    The rate of change is taken from a smoothed temperature, so the sensor
+    noise does not keep the sampler fast. Humidity only feeds the display
+    and the door detector, so it drops to 8 bits once the period is long;
+    the temperature stays at 14 bits, the loop and the stuck sensor
+    detector need its last bits.
+ */
+/* ************************************************************************** */
+
+#ifndef _SAMPLER_H    /* Guard against multiple inclusion */
+#define _SAMPLER_H
+
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <stdint.h>
+#include <stdbool.h>
+#include "celsius.h"
+
+#define SAMPLER_MAX_PERIOD_MS       4000
+#define SAMPLER_SLOW_PERIOD_MS      2000    // humidity at 8 bits from here
+#define SAMPLER_STEP                CentiCelsius::fromRaw(2)
+#define SAMPLER_SMOOTH_TAU_S        30
+#define SAMPLER_SETTLE_MS           60000   // fast sampling after a switch or the door
+
+class AdaptiveSampler
+{
+public:
+    AdaptiveSampler();
+
+    // *****************************************************************************
+    /**
+      @Function
+        void init(uint32_t tickMs)
+
+      @Summary
+        Start sampling on every RTC tick of tickMs
+     */
+    void init(uint32_t tickMs);
+
+    /**
+      @Function
+        bool due()
+
+      @Summary
+        Call on every RTC tick
+
+      @Returns
+        true when the sensor has to be read on this tick
+     */
+    bool due();
+
+    /**
+      @Function
+        uint32_t elapsedMs()
+
+      @Summary
+        Time since the previous sample, to be used as the step of everything
+        fed with the new one
+     */
+    uint32_t elapsedMs() { return _elapsedMs; }
+
+    /**
+      @Function
+        void update(CentiCelsius t, bool cell, bool fan, bool fast)
+
+      @Summary
+        Feed the sample just taken and the state of the outputs; fast keeps
+        the shortest period whatever the signal does
+     */
+    void update(CentiCelsius t, bool cell, bool fan, bool fast);
+
+    /**
+      @Function
+        void kick()
+
+      @Summary
+        Something is about to move the air, e.g. the door: sample fast for
+        SAMPLER_SETTLE_MS
+     */
+    void kick();
+
+    uint32_t periodMs() { return _periodMs; }
+
+    /**
+      @Function
+        uint16_t resolution()
+
+      @Summary
+        TEMPHUM11 resolution bits for the current period
+     */
+    uint16_t resolution();
+
+private:
+    uint32_t _tickMs;
+    uint32_t _periodMs;
+    uint32_t _elapsedMs;
+    uint32_t _sinceMs;
+    uint32_t _settleMs;
+
+    bool _primed;
+    FilterCelsius _ts;
+    FilterCelsius _rate;    // per minute, smoothed
+    bool _cell;
+    bool _fan;
+};
+
+#endif /* _SAMPLER_H */
+
+/* *****************************************************************************
+ End of File
+ */
@@ -25,6 +25,8 @@ typedef struct
     uint16_t vref;
     uint16_t low_res;
     uint16_t high_res;
+    uint32_t frame_us;
+    uint8_t mode1;
 
     servo_pos_and_res_t pos_and_res;
 
@@ -43,6 +45,9 @@ SERVO_RETVAL servo_init ( )
     servo_ctx.slave_address_of_pca9685 = 0x40;
     servo_ctx.slave_address_of_ltc2497 = 0x14;
 
+    // power-on state, the oscillator is off
+    servo_ctx.mode1 = SERVO_MODE1_LOW_POWER_MODE | SERVO_MODE1_USE_ALL_CALL_ADR;
+
     return SERVO_OK;
 }
 
@@ -75,6 +80,9 @@ void servo_generic_write_of_pca9685 ( uint8_t reg, uint8_t *data_buf, uint8_t le
         tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
     }
     
+    // the current monitor may have a conversion read in flight
+    while (SERCOM2_I2C_IsBusy())
+        ;
     SERCOM2_I2C_Write(servo_ctx.slave_address_of_pca9685, tx_buf, len + 1);
     while (SERCOM2_I2C_IsBusy())    
         ;
@@ -92,6 +100,9 @@ void servo_generic_write_of_ltc2497 ( uint8_t reg, uint8_t *data_buf, uint8_t le
         tx_buf[ cnt ] = data_buf[ cnt - 1 ]; 
     }
     
+    // the current monitor may have a conversion read in flight
+    while (SERCOM2_I2C_IsBusy())
+        ;
     SERCOM2_I2C_Write(servo_ctx.slave_address_of_ltc2497, tx_buf, len + 1);
     while (SERCOM2_I2C_IsBusy())    
         ;
@@ -99,6 +110,8 @@ void servo_generic_write_of_ltc2497 ( uint8_t reg, uint8_t *data_buf, uint8_t le
 
 void servo_generic_read_of_pca9685 ( uint8_t reg, uint8_t *data_buf, uint8_t len )
 {  
+    while (SERCOM2_I2C_IsBusy())
+        ;
     SERCOM2_I2C_WriteRead(servo_ctx.slave_address_of_pca9685, &reg, 1, data_buf, len);
     while (SERCOM2_I2C_IsBusy())    
         ;
@@ -106,6 +119,8 @@ void servo_generic_read_of_pca9685 ( uint8_t reg, uint8_t *data_buf, uint8_t len
 
 void servo_generic_read_of_ltc2497 ( uint8_t reg, uint8_t *data_buf, uint8_t len )
 {  
+    while (SERCOM2_I2C_IsBusy())
+        ;
     SERCOM2_I2C_WriteRead(servo_ctx.slave_address_of_ltc2497, &reg, 1, data_buf, len);
     while (SERCOM2_I2C_IsBusy())    
         ;
@@ -136,35 +151,62 @@ void servo_start ( )
 
 void servo_soft_reset ( )
 {
-    uint8_t write_reg[ 1 ];
+    uint8_t swrst = SERVO_SOFT_RESET;
 
-    servo_generic_write_of_pca9685( SERVO_SOFT_RESET, write_reg, 0 );
-    
-    SYSTICK_DelayMs(100);
+    // SWRST is a general call, the chip is back to its power-up state when
+    // the transfer ends
+    while (SERCOM2_I2C_IsBusy())
+        ;
+    SERCOM2_I2C_Write(SERVO_GENERAL_CALL_ADR, &swrst, 1);
+    while (SERCOM2_I2C_IsBusy())
+        ;
+
+    servo_ctx.mode1 = SERVO_MODE1_LOW_POWER_MODE | SERVO_MODE1_USE_ALL_CALL_ADR;
 }
 
 void servo_sleep (  )
 {
+    // EXTCLK is sticky once written in sleep, the board has no clock on it
     servo_set_mode( SERVO_REG_MODE_1,
-                   SERVO_MODE1_RESTART_ENABLE |
-                   SERVO_MODE1_EXTCLK_PIN_CLOCK |
                    SERVO_MODE1_LOW_POWER_MODE |
                    SERVO_MODE1_AUTO_INCREMENT_ENABLE |
                    SERVO_MODE1_USE_ALL_CALL_ADR );
 }
 
+void servo_wake ( )
+{
+    servo_set_mode( SERVO_REG_MODE_1, SERVO_MODE1_RESTART_ENABLE | SERVO_MODE1_AUTO_INCREMENT_ENABLE | SERVO_MODE1_USE_ALL_CALL_ADR );
+}
+
+bool servo_is_sleeping ( )
+{
+    return ( servo_ctx.mode1 & SERVO_MODE1_LOW_POWER_MODE ) != 0;
+}
+
 void servo_set_mode ( uint8_t mode, uint8_t w_data )
 {    
+    uint8_t wake;
+
     servo_start( );
+
+    // leaving sleep: the oscillator has to run before RESTART is written
+    if ( ( mode == SERVO_REG_MODE_1 ) && servo_is_sleeping( ) && !( w_data & SERVO_MODE1_LOW_POWER_MODE ) )
+    {
+        wake = w_data & ~( SERVO_MODE1_RESTART_ENABLE );
+        servo_generic_write_of_pca9685( mode, &wake, 1 );
+        SYSTICK_DelayUs( SERVO_OSC_STARTUP_US );
+    }
+
     servo_generic_write_of_pca9685( mode, &w_data, 1 );
-    SYSTICK_DelayMs(100);
+    if ( mode == SERVO_REG_MODE_1 )
+    {
+        servo_ctx.mode1 = w_data;
+    }
 }
 
 void servo_set_position ( uint8_t motor, uint8_t position )
 {
-    uint8_t write_reg[ 4 ];
     uint16_t set_map;
-    uint16_t on = 0x0000;
     servo_map_t map; 
     
     map.x = position;
@@ -174,36 +216,75 @@ void servo_set_position ( uint8_t motor, uint8_t position )
     map.out_max = servo_ctx.high_res;
 
     set_map = map_priv( map ) ;
-    if ( set_map < 70 )
+    if ( set_map < SERVO_MIN_PULSE )
     {
-        set_map = 70;
+        set_map = SERVO_MIN_PULSE;
     }
-        
+
+    servo_set_pulse( motor, set_map );
+}
+
+void servo_set_pulse ( uint8_t motor, uint16_t pulse )
+{
+    uint8_t write_reg[ 4 ];
+    uint16_t on = 0x0000;
+
     write_reg[ 0 ] = on;
     write_reg[ 1 ] = on >> 8;
-    write_reg[ 2 ] = set_map;
-    write_reg[ 3 ] = set_map >> 8;
+    write_reg[ 2 ] = pulse;
+    write_reg[ 3 ] = pulse >> 8;
 
     servo_start( );
     servo_generic_write_of_pca9685( motor, write_reg, 4 );
 }
 
+void servo_set_full_off ( uint8_t motor )
+{
+    uint8_t off_h = SERVO_LED_FULL;
+
+    // OFF_H alone, the pulse is restored by the next position
+    servo_start( );
+    servo_generic_write_of_pca9685( motor + 3, &off_h, 1 );
+}
+
+uint16_t servo_pulse_of ( float position )
+{
+    float span = ( float )( servo_ctx.max_pos - servo_ctx.min_pos );
+    float pulse;
+
+    // as map_priv(), without dropping the fraction of a degree
+    pulse = ( position - servo_ctx.min_pos ) * ( servo_ctx.high_res - servo_ctx.low_res ) / span;
+    pulse += servo_ctx.low_res + 10;
+    if ( pulse < SERVO_MIN_PULSE )
+    {
+        pulse = SERVO_MIN_PULSE;
+    }
+
+    return ( uint16_t )( pulse + 0.5f );
+}
+
+uint32_t servo_frame_us ( )
+{
+    return servo_ctx.frame_us;
+}
+
 void servo_set_freq ( uint16_t freq )
 {
     uint32_t prescale_val;
     uint8_t write_buf[ 1 ];
     
-    prescale_val = 25000000;
+    prescale_val = SERVO_OSC_HZ;
     prescale_val /= 4096;
     prescale_val /= freq;
     prescale_val -= 1;
     
     write_buf[ 0 ] = prescale_val;
+
+    // 4096 oscillator periods per prescaler count
+    servo_ctx.frame_us = ( ( prescale_val + 1 ) * 4096UL * 1000UL ) / ( SERVO_OSC_HZ / 1000UL );
     
     servo_start( );
     servo_generic_write_of_pca9685( SERVO_REG_PRE_SCALE, write_buf, 1 );
-
-    SYSTICK_DelayMs(100);
 }
 
 uint32_t servo_get_channel ( uint8_t channel )
@@ -238,6 +319,40 @@ uint16_t setvo_get_current ( uint8_t channel )
     return  current;
 }
 
+bool servo_start_read_of_ltc2497 ( uint8_t reg, uint8_t *data_buf, uint8_t len )
+{
+    static uint8_t cmd;
+
+    // the command has to outlive the call, the transfer runs from the ISR
+    cmd = reg;
+    return SERCOM2_I2C_WriteRead(servo_ctx.slave_address_of_ltc2497, &cmd, 1, data_buf, len);
+}
+
+int32_t servo_ltc2497_to_uv ( uint8_t *data_buf )
+{
+    int32_t code;
+
+    // SIG, MSB and 16 bits, offset binary, then 6 sub-LSBs
+    code = data_buf[ 0 ];
+    code = code << 8;
+    code = code | data_buf[ 1 ];
+    code = code << 8;
+    code = code | data_buf[ 2 ];
+    code = ( code >> 6 ) - SERVO_LTC2497_CODE_OFFSET;
+
+    // over and under range read as the full scale, Vref / 2
+    if ( code > SERVO_LTC2497_CODE_FS )
+    {
+        code = SERVO_LTC2497_CODE_FS;
+    }
+    else if ( code < -SERVO_LTC2497_CODE_FS )
+    {
+        code = -SERVO_LTC2497_CODE_FS;
+    }
+
+    return ( int32_t )( ( ( int64_t )code * servo_ctx.vref * 500 ) / SERVO_LTC2497_CODE_FS );
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
 static uint16_t map_priv ( servo_map_t map )
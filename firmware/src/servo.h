@@ -15,6 +15,7 @@
 #define SERVO_H
 
 #include <stdint.h>
+#include <stdbool.h>
 
 // -------------------------------------------------------------- PUBLIC MACROS 
 /**
@@ -160,6 +161,15 @@
 #define SERVO_GENERAL_CALL_ADR                0x00
 #define SERVO_SOFT_RESET                      0x06
 
+#define SERVO_OSC_HZ                          25000000UL
+#define SERVO_MIN_PULSE                       70
+
+/* Bit 4 of ON_H and OFF_H, full off wins over full on */
+#define SERVO_LED_FULL                        0x10
+
+/* From clearing SLEEP to a stable oscillator, datasheet maximum */
+#define SERVO_OSC_STARTUP_US                  500
+
 #define SERVO_VREF_3300                       3300
 #define SERVO_VREF_5000                       5000
 /** \} */
@@ -218,6 +228,11 @@
 #define SERVO_POSITIVE_CH11                   0xBD
 #define SERVO_POSITIVE_CH13                   0xBE
 #define SERVO_POSITIVE_CH15                   0xBF
+
+#define SERVO_LTC2497_CONVERSION_MS           150
+#define SERVO_LTC2497_READ_LEN                3
+#define SERVO_LTC2497_CODE_OFFSET             0x20000
+#define SERVO_LTC2497_CODE_FS                 0x10000
 /** \} */
 
 /** \} */ // End group macro 
@@ -371,7 +386,8 @@ void servo_start ( );
  *
  * @param ctx    Click object.
  *
- * @description Functions for soft reset chip.
+ * @description Functions for soft reset chip, with the SWRST general call.
+ * The configuration is lost, servo_default_cfg() comes after it.
  */
 void servo_soft_reset ( );
 
@@ -384,6 +400,21 @@ void servo_soft_reset ( );
  */
 void servo_sleep ( );
 
+/**
+ * @brief Wake function.
+ *
+ * @description This function starts the oscillator and, once it has run for
+ * SERVO_OSC_STARTUP_US, restarts the outputs stopped by servo_sleep().
+ */
+void servo_wake ( );
+
+/**
+ * @brief Sleeping function.
+ *
+ * @returns true while the oscillator is stopped.
+ */
+bool servo_is_sleeping ( );
+
 /**
  * @brief Set mode function.
  *
@@ -408,6 +439,9 @@ void servo_sleep ( );
  *      Output logic state ( not inverted or inverted )
  *      Outputs change ( Outputs change on STOP or ACK command )
  *      Outputs configured ( open-drain structure or totem pole structure)
+ *
+ * A mode 1 write that clears the sleep bit waits SERVO_OSC_STARTUP_US before
+ * writing the restart bit, the other writes do not wait.
  */
 void servo_set_mode ( uint8_t mode, uint8_t w_data );
 
@@ -422,6 +456,41 @@ void servo_set_mode ( uint8_t mode, uint8_t w_data );
  */
 void servo_set_position ( uint8_t motor, uint8_t position );
 
+/**
+ * @brief Set pulse function.
+ *
+ * @param motor     Motor to be set.
+ * @param pulse     End of the pulse in 1/4096 of the PWM period.
+ */
+void servo_set_pulse ( uint8_t motor, uint16_t pulse );
+
+/**
+ * @brief Full off function.
+ *
+ * @param motor     Motor to be released, SERVO_REG_ALL_MOTOR_ON_L for all.
+ *
+ * @description The output stays low, the servo is no longer driven, until
+ * the next position or pulse is set.
+ */
+void servo_set_full_off ( uint8_t motor );
+
+/**
+ * @brief Pulse function.
+ *
+ * @param position  Position, with a fraction of the unit.
+ *
+ * @returns The pulse servo_set_position() would write for it, rounded to
+ * the nearest count instead of down.
+ */
+uint16_t servo_pulse_of ( float position );
+
+/**
+ * @brief PWM period function.
+ *
+ * @returns Period of the outputs set by servo_set_freq(), in us.
+ */
+uint32_t servo_frame_us ( );
+
 /**
  * @brief Set frequency function.
  *
@@ -452,6 +521,31 @@ uint32_t servo_get_channel ( uint8_t channel );
  */
 uint16_t setvo_get_current ( uint8_t channel );
 
+/**
+ * @brief Start read function of ltc2497.
+ *
+ * @param reg       Channel of the next conversion.
+ * @param data_buf  Receives the result of the conversion just completed.
+ * @param len       Number of bytes to read.
+ *
+ * @returns false if the bus is busy.
+ *
+ * @description This function starts the transfer and returns, the SERCOM2
+ * callback signals its end. The LTC2497 does not acknowledge until the
+ * conversion started at the previous STOP is done, SERCOM2_I2C_ErrorGet()
+ * returns SERCOM_I2C_ERROR_NAK in that case.
+ */
+bool servo_start_read_of_ltc2497 ( uint8_t reg, uint8_t *data_buf, uint8_t len );
+
+/**
+ * @brief Conversion result function.
+ *
+ * @param data_buf  The 3 bytes read from ltc2497.
+ *
+ * @returns Input voltage in uV, clamped to the full scale of Vref / 2.
+ */
+int32_t servo_ltc2497_to_uv ( uint8_t *data_buf );
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,134 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include "servo.h"
+#include "swtimer.h"
+#include "servochan.h"
+
+/* Every output has its four LED registers from SERVO_MOTOR_1 on */
+#define SERVOCHAN_OF(motor)         ( ( ( motor ) - SERVO_MOTOR_1 ) / 4 )
+#define SERVOCHAN_MOTOR(ch)         ( SERVO_MOTOR_1 + 4 * ( ch ) )
+
+/**
+ * @brief Manager ctx object definition.
+ */
+typedef struct
+{
+    uint32_t settle_ms[ SERVOCHAN_CHANNELS ];
+    swtimer_t timer[ SERVOCHAN_CHANNELS ];
+
+    // outputs being driven, pulse each was last given
+    uint16_t driven;
+    uint16_t pulse[ SERVOCHAN_CHANNELS ];
+
+} servochan_t;
+
+static servochan_t servochan_ctx;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static void drive_priv ( uint8_t ch );
+static void settle_priv ( uintptr_t context );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void servochan_init ( )
+{
+    uint8_t ch;
+
+    for ( ch = 0; ch < SERVOCHAN_CHANNELS; ch++ )
+    {
+        servochan_ctx.settle_ms[ ch ] = SERVOCHAN_SETTLE_MS;
+        servochan_ctx.pulse[ ch ] = 0;
+        swtimer_cancel( &servochan_ctx.timer[ ch ] );
+    }
+    servochan_ctx.driven = 0;
+
+    // ALL_LED_OFF_H, one write for every output
+    servo_set_full_off( SERVO_REG_ALL_MOTOR_ON_L );
+
+    servo_sleep( );
+}
+
+void servochan_set_settle ( uint8_t motor, uint32_t settle_ms )
+{
+    servochan_ctx.settle_ms[ SERVOCHAN_OF( motor ) ] = settle_ms;
+}
+
+void servochan_set_position ( uint8_t motor, uint8_t position )
+{
+    servochan_set_pulse( motor, servo_pulse_of( position ) );
+}
+
+void servochan_set_pulse ( uint8_t motor, uint16_t pulse )
+{
+    uint8_t ch = SERVOCHAN_OF( motor );
+
+    // sent again: the output still has it, or was released there and the
+    // servo has not moved since; the settle time runs from the change
+    if ( pulse == servochan_ctx.pulse[ ch ] )
+    {
+        return;
+    }
+
+    drive_priv( ch );
+    servochan_ctx.pulse[ ch ] = pulse;
+    servo_set_pulse( motor, pulse );
+}
+
+void servochan_refresh ( uint8_t motor )
+{
+    uint8_t ch = SERVOCHAN_OF( motor );
+
+    if ( servochan_ctx.pulse[ ch ] != 0 )
+    {
+        drive_priv( ch );
+        servo_set_pulse( motor, servochan_ctx.pulse[ ch ] );
+    }
+}
+
+bool servochan_driven ( uint8_t motor )
+{
+    return ( servochan_ctx.driven & ( 1 << SERVOCHAN_OF( motor ) ) ) != 0;
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void drive_priv ( uint8_t ch )
+{
+    if ( servo_is_sleeping( ) )
+    {
+        servo_wake( );
+    }
+
+    // writing the pulse clears full off
+    servochan_ctx.driven |= ( 1 << ch );
+    if ( servochan_ctx.settle_ms[ ch ] != 0 )
+    {
+        swtimer_start( &servochan_ctx.timer[ ch ], servochan_ctx.settle_ms[ ch ], settle_priv, ch );
+    }
+    else
+    {
+        swtimer_cancel( &servochan_ctx.timer[ ch ] );
+    }
+}
+
+static void settle_priv ( uintptr_t context )
+{
+    uint8_t ch = ( uint8_t )context;
+
+    servo_set_full_off( SERVOCHAN_MOTOR( ch ) );
+    servochan_ctx.driven &= ~( 1 << ch );
+
+    if ( servochan_ctx.driven == 0 )
+    {
+        servo_sleep( );
+    }
+}
+
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,111 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the servo channel manager.
+ *
+ * A servo that has reached its position keeps being driven as long as it
+ * gets pulses: it draws its holding current and jitters around the
+ * position. The manager sets an output full off once it has not been
+ * commanded for its settle time, and drives it again on the next command.
+ * When every output is off the PCA9685 is put to sleep; the next command
+ * wakes it, which costs the oscillator start up, SERVO_OSC_STARTUP_US.
+ *
+ * The rocker switches and the lid stay where the servo left them, so
+ * releasing the servo does not change what it controls. A command for the
+ * position an output already has is ignored, driven or released.
+ *
+ * \addtogroup servochan Servo Channel Manager
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef SERVOCHAN_H
+#define SERVOCHAN_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+#define SERVOCHAN_CHANNELS          16
+
+/* Covers a full move of the small servos at 300 deg/s */
+#define SERVOCHAN_SETTLE_MS         500
+
+/** \} */ // End group macro
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Initialization function.
+ *
+ * @description This function sets every output off and the controller to
+ * sleep, servo_default_cfg() has to be called first.
+ */
+void servochan_init ( );
+
+/**
+ * @brief Settle time function.
+ *
+ * @param motor        SERVO_MOTOR_x of the output.
+ * @param settle_ms    Time from the last change to the output going off,
+ *                     0 to keep it driven.
+ */
+void servochan_set_settle ( uint8_t motor, uint32_t settle_ms );
+
+/**
+ * @brief Position function.
+ *
+ * @param motor        SERVO_MOTOR_x of the output.
+ * @param position     As servo_set_position(), the pulse is rounded to
+ *                     the nearest count.
+ */
+void servochan_set_position ( uint8_t motor, uint8_t position );
+
+/**
+ * @brief Pulse function.
+ *
+ * @param motor        SERVO_MOTOR_x of the output.
+ * @param pulse        As servo_set_pulse().
+ */
+void servochan_set_pulse ( uint8_t motor, uint16_t pulse );
+
+/**
+ * @brief Refresh function.
+ *
+ * @param motor        SERVO_MOTOR_x of the output.
+ *
+ * @description This function drives the output again at the last pulse it
+ * was given, for a servo that could not follow it: the commands sent while
+ * the servo supply was off.
+ */
+void servochan_refresh ( uint8_t motor );
+
+/**
+ * @brief Driven function.
+ *
+ * @param motor        SERVO_MOTOR_x of the output.
+ *
+ * @returns true while the output gets pulses.
+ */
+bool servochan_driven ( uint8_t motor );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _SERVOCHAN_H_
@@ -0,0 +1,156 @@
+/* ************************************************************************** */
+/** Step-response characterization
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <string.h>
+#include "stepresponse.h"
+#include "nvstore.h"
+
+StepResponse::StepResponse()
+{
+    _phase = Step_Idle;
+    memset(&_result, 0, sizeof(_result));
+    memset(&_run, 0, sizeof(_run));
+}
+
+void StepResponse::init()
+{
+    if (!nvstore_read(NVSTORE_ID_STEP_RESPONSE, &_result, sizeof(_result)))
+        memset(&_result, 0, sizeof(_result));
+}
+
+bool StepResponse::start()
+{
+    if (_phase != Step_Idle)
+        return false;
+
+    memset(&_run, 0, sizeof(_run));
+    _maxRate = MilliCelsius();
+    _model.reset();
+    _ratePrimed = false;
+    _rateSum = 0;
+    _rateCount = 0;
+    _rateElapsedMs = 0;
+
+    enter(Step_Baseline);
+
+    return true;
+}
+
+void StepResponse::abort()
+{
+    if (_phase == Step_Idle)
+        return;
+
+    // the last good result stays in flash, only the status is reported
+    _phase = Step_Idle;
+    _result.status = StepStatus_Aborted;
+}
+
+bool StepResponse::update(CentiCelsius t, uint32_t dtMs)
+{
+    if (_phase == Step_Idle)
+        return false;
+
+    _model.observe(t, cellOn(), dtMs);
+    _elapsedMs += dtMs;
+    _sum += t.raw();
+    _count++;
+
+    // cooling rate over windows long enough to average the sensor noise
+    _rateSum += t.raw();
+    _rateCount++;
+    _rateElapsedMs += dtMs;
+    if (_rateElapsedMs >= STEP_RATE_WINDOW_MS)
+    {
+        MilliCelsius avg = CentiCelsius::fromRaw(_rateSum).to<1000>().scaled(1, (int32_t)_rateCount);
+
+        if (_ratePrimed && _phase == Step_Cooling)
+        {
+            MilliCelsius rate = (avg - _ratePrev).scaled(60000, (int32_t)_rateElapsedMs);
+            if (rate < _maxRate)
+                _maxRate = rate;
+        }
+        _ratePrev = avg;
+        _ratePrimed = true;
+        _rateSum = 0;
+        _rateCount = 0;
+        _rateElapsedMs = 0;
+    }
+
+    switch (_phase)
+    {
+        case Step_Baseline:
+            if (_elapsedMs >= STEP_BASELINE_MS)
+            {
+                _baseline = CentiCelsius::fromRaw(_sum).scaled(1, (int32_t)_count);
+                _run.baselineC = _baseline.toFloat();
+                enter(Step_Cooling);
+            }
+            break;
+
+        case Step_Cooling:
+            if (_elapsedMs >= STEP_COOLING_MAX_MS || t <= _baseline - STEP_MAX_DROP ||
+                t <= STEP_MIN_TEMP)
+            {
+                _run.finalC = t.toFloat();
+                _run.coolingS = _elapsedMs / 1000;
+                enter(Step_Recovery);
+            }
+            break;
+
+        case Step_Recovery:
+            if (_elapsedMs >= STEP_RECOVERY_MS)
+            {
+                finish();
+                return true;
+            }
+            break;
+
+        default:
+            break;
+    }
+
+    return false;
+}
+
+void StepResponse::enter(StepPhaseEnum phase)
+{
+    _phase = phase;
+    _elapsedMs = 0;
+    _sum = 0;
+    _count = 0;
+}
+
+void StepResponse::finish()
+{
+    _phase = Step_Idle;
+    _run.maxRateCPerMin = _maxRate.toFloat();
+
+    if (_model.ready())
+    {
+        _run.status = StepStatus_Ok;
+        _run.gainC = _model.gain();
+        _run.tauS = _model.timeConstantS();
+        _run.deadTimeS = (float)_model.deadTimeS();
+    }
+    else
+    {
+        _run.status = StepStatus_NoFit;
+    }
+
+    _run.runs = _result.runs + 1;
+    _result = _run;
+
+    nvstore_write(NVSTORE_ID_STEP_RESPONSE, &_result, sizeof(_result));
+}
+
+/* *****************************************************************************
+ End of File
+ */
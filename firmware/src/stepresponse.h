@@ -0,0 +1,151 @@
+/* ************************************************************************** */
+/** Step-response characterization
+
+  @Summary
+    Measures the cooling performance of the unit with a cell-on step.
+
+  @Description
+    With the mains on, the case is left alone to take a baseline, then the
+    cell and the fan are switched on for a cooling step and the cell is
+    switched off again for a recovery period. The temperature, read on every
+    RTC period, is fitted with a first order plus dead time model and the
+    steepest cooling rate is recorded. The result is kept in flash, so a
+    degraded heat sink or fan shows up as a drift from the bench baseline.
+
+    The routine does not block: update() is called from the main loop and
+    tells which outputs it wants.
+ */
+/* ************************************************************************** */
+
+#ifndef _STEPRESPONSE_H    /* Guard against multiple inclusion */
+#define _STEPRESPONSE_H
+
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <stdint.h>
+#include <stdbool.h>
+#include "tempmodel.h"
+
+#define STEP_BASELINE_MS            120000
+#define STEP_COOLING_MAX_MS         1800000
+#define STEP_RECOVERY_MS            600000
+#define STEP_RATE_WINDOW_MS         10000
+
+/* The cooling step ends early on either limit */
+#define STEP_MAX_DROP               CentiCelsius::fromDegrees(8)
+#define STEP_MIN_TEMP               CentiCelsius::fromDegrees(2)
+
+typedef enum
+{
+  Step_Idle = 0,
+  Step_Baseline = 1,
+  Step_Cooling = 2,
+  Step_Recovery = 3,
+} StepPhaseEnum;
+
+typedef enum
+{
+  StepStatus_None = 0,
+  StepStatus_Ok = 1,
+  StepStatus_Aborted = 2,
+  StepStatus_NoFit = 3,
+} StepStatusEnum;
+
+/* Stored as is in flash, only append fields; the run is measured in fixed
+   point, the floats are only the stored and reported result */
+typedef struct
+{
+    uint32_t status;
+    uint32_t runs;
+    float baselineC;
+    float finalC;
+    float gainC;            // steady state change with the cell on
+    float tauS;
+    float deadTimeS;
+    float maxRateCPerMin;   // steepest cooling, negative
+    uint32_t coolingS;
+} StepResult;
+
+class StepResponse
+{
+public:
+    StepResponse();
+
+    // *****************************************************************************
+    /**
+      @Function
+        void init()
+
+      @Summary
+        Load the last stored result
+     */
+    void init();
+
+    /**
+      @Function
+        bool start()
+
+      @Summary
+        Start a characterization, false if one is already running
+     */
+    bool start();
+
+    /**
+      @Function
+        void abort()
+
+      @Summary
+        Stop the running characterization, the stored result is kept
+     */
+    void abort();
+
+    /**
+      @Function
+        bool update(CentiCelsius t, uint32_t dtMs)
+
+      @Summary
+        Run one step with the temperature read in this period
+
+      @Returns
+        true when the characterization has just completed
+     */
+    bool update(CentiCelsius t, uint32_t dtMs);
+
+    bool active() { return _phase != Step_Idle; }
+    StepPhaseEnum phase() { return _phase; }
+    bool cellOn() { return _phase == Step_Cooling; }
+    bool fanOn() { return _phase == Step_Cooling || _phase == Step_Recovery; }
+    const StepResult& result() { return _result; }
+
+private:
+    void enter(StepPhaseEnum phase);
+    void finish();
+
+    StepPhaseEnum _phase;
+    uint32_t _elapsedMs;
+
+    int32_t _sum;           // 0.01 C
+    uint32_t _count;
+    CentiCelsius _baseline;
+
+    int32_t _rateSum;       // 0.01 C
+    uint32_t _rateCount;
+    uint32_t _rateElapsedMs;
+    MilliCelsius _ratePrev;
+    bool _ratePrimed;
+    MilliCelsius _maxRate;  // per minute
+
+    StepResult _run;
+    StepResult _result;
+    ThermalModel _model;
+};
+
+#endif /* _STEPRESPONSE_H */
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,490 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ */
+
+#include "swtimer.h"
+#include "definitions.h"
+
+/**
+ * @brief Timer wheel object definition.
+ */
+typedef struct
+{
+    swtimer_t *slots[ SWTIMER_WHEEL_LEVELS ][ SWTIMER_WHEEL_SLOTS ];
+    uint64_t occupied[ SWTIMER_WHEEL_LEVELS ];
+
+    // next tick to be processed
+    uint32_t wheel_time;
+    uint32_t last_now;
+
+    // RTC period in ticks and time at the start of the current period
+    uint32_t rtc_period;
+    volatile uint32_t base;
+
+    volatile uint32_t next_wake;
+    volatile bool armed;
+    volatile bool expired;
+
+} swtimer_ctx_t;
+
+static swtimer_ctx_t swtimer_ctx;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static void start_priv ( swtimer_t *timer, uint32_t ticks, uint32_t period, SWTIMER_CALLBACK callback, uintptr_t context );
+static void link_priv ( swtimer_t *timer );
+static void unlink_priv ( swtimer_t *timer );
+static void cascade_priv ( uint8_t level );
+static bool next_wake_priv ( uint32_t *wake );
+static void program_priv ( );
+static int first_slot_priv ( uint64_t occupied, uint32_t from );
+
+// ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
+
+void swtimer_init ( uint32_t rtc_period )
+{
+    uint8_t level;
+    uint32_t slot;
+
+    for ( level = 0; level < SWTIMER_WHEEL_LEVELS; level++ )
+    {
+        for ( slot = 0; slot < SWTIMER_WHEEL_SLOTS; slot++ )
+        {
+            swtimer_ctx.slots[ level ][ slot ] = NULL;
+        }
+        swtimer_ctx.occupied[ level ] = 0;
+    }
+
+    // the counter is cleared on the cycle after the COMP0 match
+    swtimer_ctx.rtc_period = rtc_period + 1;
+    swtimer_ctx.base = 0;
+    swtimer_ctx.last_now = 0;
+    swtimer_ctx.wheel_time = 0;
+    swtimer_ctx.armed = false;
+    swtimer_ctx.expired = false;
+
+    RTC_Timer32InterruptDisable( RTC_TIMER32_INT_MASK_CMP1 );
+}
+
+void swtimer_rtc_handler ( uint32_t int_cause )
+{
+    uint32_t offset;
+
+    if ( int_cause & RTC_TIMER32_INT_MASK_CMP0 )
+    {
+        swtimer_ctx.base += swtimer_ctx.rtc_period;
+
+        if ( swtimer_ctx.armed )
+        {
+            offset = swtimer_ctx.next_wake - swtimer_ctx.base;
+            if ( ( int32_t )offset <= 0 )
+            {
+                swtimer_ctx.expired = true;
+            }
+            else if ( offset < swtimer_ctx.rtc_period )
+            {
+                RTC_Timer32Compare1Set( offset );
+                RTC_Timer32InterruptEnable( RTC_TIMER32_INT_MASK_CMP1 );
+            }
+        }
+    }
+
+    // CMP1 flag is set on every match, also when the interrupt is disabled
+    if ( ( int_cause & RTC_TIMER32_INT_MASK_CMP1 ) && swtimer_ctx.armed )
+    {
+        if ( ( int32_t )( swtimer_now( ) - swtimer_ctx.next_wake ) >= 0 )
+        {
+            RTC_Timer32InterruptDisable( RTC_TIMER32_INT_MASK_CMP1 );
+            swtimer_ctx.expired = true;
+        }
+    }
+}
+
+uint32_t swtimer_now ( )
+{
+    uint32_t now;
+    bool irq;
+
+    irq = NVIC_INT_Disable( );
+
+    now = swtimer_ctx.base + RTC_Timer32CounterGet( );
+    if ( ( int32_t )( now - swtimer_ctx.last_now ) < 0 )
+    {
+        // counter already cleared, COMP0 interrupt still pending
+        now += swtimer_ctx.rtc_period;
+    }
+    swtimer_ctx.last_now = now;
+
+    NVIC_INT_Restore( irq );
+
+    return now;
+}
+
+uint32_t swtimer_ms_to_ticks ( uint32_t ms )
+{
+    uint64_t ticks;
+
+    ticks = ( uint64_t )ms * SWTIMER_TICK_FREQ + 999;
+    ticks /= 1000;
+
+    return ( uint32_t )ticks;
+}
+
+void swtimer_start ( swtimer_t *timer, uint32_t delay_ms, SWTIMER_CALLBACK callback, uintptr_t context )
+{
+    start_priv( timer, swtimer_ms_to_ticks( delay_ms ), 0, callback, context );
+}
+
+void swtimer_start_periodic ( swtimer_t *timer, uint32_t period_ms, SWTIMER_CALLBACK callback, uintptr_t context )
+{
+    uint32_t ticks;
+
+    ticks = swtimer_ms_to_ticks( period_ms );
+    start_priv( timer, ticks, ticks, callback, context );
+}
+
+void swtimer_cancel ( swtimer_t *timer )
+{
+    if ( timer->pprev == NULL )
+    {
+        return;
+    }
+
+    unlink_priv( timer );
+    program_priv( );
+}
+
+bool swtimer_is_active ( swtimer_t *timer )
+{
+    return timer->pprev != NULL;
+}
+
+bool swtimer_pending ( )
+{
+    return swtimer_ctx.expired;
+}
+
+void swtimer_task ( )
+{
+    swtimer_t *timer;
+    uint32_t now;
+    uint32_t wake;
+    uint32_t slot;
+    uint8_t level;
+
+    if ( !swtimer_ctx.expired )
+    {
+        return;
+    }
+
+    swtimer_ctx.expired = false;
+    now = swtimer_now( );
+
+    while ( ( int32_t )( now - swtimer_ctx.wheel_time ) >= 0 )
+    {
+        slot = swtimer_ctx.wheel_time & SWTIMER_WHEEL_MASK;
+
+        if ( slot == 0 )
+        {
+            for ( level = 1; level < SWTIMER_WHEEL_LEVELS; level++ )
+            {
+                cascade_priv( level );
+                if ( ( ( swtimer_ctx.wheel_time >> ( level * SWTIMER_WHEEL_BITS ) ) & SWTIMER_WHEEL_MASK ) != 0 )
+                {
+                    break;
+                }
+            }
+        }
+
+        while ( swtimer_ctx.slots[ 0 ][ slot ] != NULL )
+        {
+            timer = swtimer_ctx.slots[ 0 ][ slot ];
+            unlink_priv( timer );
+
+            if ( timer->period != 0 )
+            {
+                timer->expiry += timer->period;
+                link_priv( timer );
+            }
+
+            timer->callback( timer->context );
+        }
+
+        // jump over the empty slots, straight to the next expiry or cascade
+        if ( next_wake_priv( &wake ) && ( ( int32_t )( now - wake ) >= 0 ) )
+        {
+            if ( wake == swtimer_ctx.wheel_time )
+            {
+                continue;
+            }
+            swtimer_ctx.wheel_time = wake;
+        }
+        else
+        {
+            swtimer_ctx.wheel_time = now + 1;
+        }
+    }
+
+    swtimer_ctx.armed = false;
+    program_priv( );
+}
+
+// ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
+
+static void start_priv ( swtimer_t *timer, uint32_t ticks, uint32_t period, SWTIMER_CALLBACK callback, uintptr_t context )
+{
+    uint32_t now;
+    uint8_t level;
+    bool empty = true;
+
+    if ( timer->pprev != NULL )
+    {
+        unlink_priv( timer );
+    }
+
+    now = swtimer_now( );
+
+    for ( level = 0; level < SWTIMER_WHEEL_LEVELS; level++ )
+    {
+        empty &= ( swtimer_ctx.occupied[ level ] == 0 );
+    }
+    if ( empty )
+    {
+        // nothing to catch up with, restart the wheel from the current time
+        swtimer_ctx.wheel_time = now;
+    }
+
+    if ( ticks == 0 )
+    {
+        ticks = 1;
+    }
+
+    timer->expiry = now + ticks;
+    timer->period = period;
+    timer->callback = callback;
+    timer->context = context;
+
+    link_priv( timer );
+    program_priv( );
+}
+
+static void link_priv ( swtimer_t *timer )
+{
+    uint32_t delta;
+    uint32_t expiry;
+    uint32_t slot;
+    uint8_t level;
+    swtimer_t **head;
+
+    expiry = timer->expiry;
+    delta = expiry - swtimer_ctx.wheel_time;
+
+    if ( ( int32_t )delta < 0 )
+    {
+        // already due, run on the next processed tick
+        expiry = swtimer_ctx.wheel_time;
+        delta = 0;
+    }
+    else if ( delta > SWTIMER_MAX_TICKS )
+    {
+        // parked on the last level and re-linked when cascaded
+        expiry = swtimer_ctx.wheel_time + SWTIMER_MAX_TICKS;
+        delta = SWTIMER_MAX_TICKS;
+    }
+
+    level = 0;
+    while ( ( level < SWTIMER_WHEEL_LEVELS - 1 ) &&
+            ( delta >= ( 1UL << ( ( level + 1 ) * SWTIMER_WHEEL_BITS ) ) ) )
+    {
+        level++;
+    }
+
+    slot = ( expiry >> ( level * SWTIMER_WHEEL_BITS ) ) & SWTIMER_WHEEL_MASK;
+    head = &swtimer_ctx.slots[ level ][ slot ];
+
+    timer->next = *head;
+    if ( timer->next != NULL )
+    {
+        timer->next->pprev = &timer->next;
+    }
+    *head = timer;
+    timer->pprev = head;
+
+    swtimer_ctx.occupied[ level ] |= ( uint64_t )1 << slot;
+}
+
+static void unlink_priv ( swtimer_t *timer )
+{
+    swtimer_t **first = &swtimer_ctx.slots[ 0 ][ 0 ];
+    uint32_t index;
+
+    *timer->pprev = timer->next;
+    if ( timer->next != NULL )
+    {
+        timer->next->pprev = timer->pprev;
+    }
+
+    // timer was the last one of its slot: clear the occupancy bit
+    if ( ( timer->next == NULL ) &&
+         ( timer->pprev >= first ) &&
+         ( timer->pprev < first + SWTIMER_WHEEL_LEVELS * SWTIMER_WHEEL_SLOTS ) )
+    {
+        index = timer->pprev - first;
+        swtimer_ctx.occupied[ index / SWTIMER_WHEEL_SLOTS ] &= ~( ( uint64_t )1 << ( index % SWTIMER_WHEEL_SLOTS ) );
+    }
+
+    timer->next = NULL;
+    timer->pprev = NULL;
+}
+
+static void cascade_priv ( uint8_t level )
+{
+    swtimer_t *timer;
+    swtimer_t *next;
+    uint32_t slot;
+
+    slot = ( swtimer_ctx.wheel_time >> ( level * SWTIMER_WHEEL_BITS ) ) & SWTIMER_WHEEL_MASK;
+
+    timer = swtimer_ctx.slots[ level ][ slot ];
+    swtimer_ctx.slots[ level ][ slot ] = NULL;
+    swtimer_ctx.occupied[ level ] &= ~( ( uint64_t )1 << slot );
+
+    while ( timer != NULL )
+    {
+        next = timer->next;
+        timer->next = NULL;
+        timer->pprev = NULL;
+        link_priv( timer );
+        timer = next;
+    }
+}
+
+static bool next_wake_priv ( uint32_t *wake )
+{
+    uint32_t current;
+    uint32_t dist;
+    uint32_t candidate;
+    uint8_t level;
+    bool found = false;
+    int slot;
+
+    for ( level = 0; level < SWTIMER_WHEEL_LEVELS; level++ )
+    {
+        if ( swtimer_ctx.occupied[ level ] == 0 )
+        {
+            continue;
+        }
+
+        current = ( swtimer_ctx.wheel_time >> ( level * SWTIMER_WHEEL_BITS ) ) & SWTIMER_WHEEL_MASK;
+
+        if ( level == 0 )
+        {
+            // level 0 slots expire on their own tick
+            slot = first_slot_priv( swtimer_ctx.occupied[ 0 ], current );
+            dist = ( slot - current ) & SWTIMER_WHEEL_MASK;
+            candidate = swtimer_ctx.wheel_time + dist;
+        }
+        else
+        {
+            // upper level slots are due when they get cascaded; the current
+            // slot is still pending if the wheel stopped right on its boundary
+            if ( ( ( swtimer_ctx.wheel_time & ( ( 1UL << ( level * SWTIMER_WHEEL_BITS ) ) - 1 ) ) == 0 ) &&
+                 ( swtimer_ctx.occupied[ level ] & ( ( uint64_t )1 << current ) ) )
+            {
+                dist = 0;
+            }
+            else
+            {
+                slot = first_slot_priv( swtimer_ctx.occupied[ level ], current + 1 );
+                dist = ( slot - current ) & SWTIMER_WHEEL_MASK;
+                if ( dist == 0 )
+                {
+                    dist = SWTIMER_WHEEL_SLOTS;
+                }
+            }
+            candidate = ( ( swtimer_ctx.wheel_time >> ( level * SWTIMER_WHEEL_BITS ) ) + dist ) << ( level * SWTIMER_WHEEL_BITS );
+        }
+
+        if ( !found || ( ( int32_t )( candidate - *wake ) < 0 ) )
+        {
+            *wake = candidate;
+            found = true;
+        }
+    }
+
+    return found;
+}
+
+static void program_priv ( )
+{
+    uint32_t wake;
+    uint32_t offset;
+    bool irq;
+
+    if ( !next_wake_priv( &wake ) )
+    {
+        swtimer_ctx.armed = false;
+        RTC_Timer32InterruptDisable( RTC_TIMER32_INT_MASK_CMP1 );
+        return;
+    }
+
+    if ( swtimer_ctx.armed && ( wake == swtimer_ctx.next_wake ) )
+    {
+        return;
+    }
+
+    irq = NVIC_INT_Disable( );
+
+    swtimer_ctx.next_wake = wake;
+    swtimer_ctx.armed = true;
+
+    offset = wake - swtimer_ctx.base;
+    if ( ( int32_t )( wake - swtimer_now( ) ) <= 0 )
+    {
+        RTC_Timer32InterruptDisable( RTC_TIMER32_INT_MASK_CMP1 );
+        swtimer_ctx.expired = true;
+    }
+    else if ( offset < swtimer_ctx.rtc_period )
+    {
+        RTC_Timer32Compare1Set( offset );
+        RTC_Timer32InterruptEnable( RTC_TIMER32_INT_MASK_CMP1 );
+
+        // the counter may have passed the compare value while it was written
+        if ( ( int32_t )( wake - swtimer_now( ) ) <= 0 )
+        {
+            swtimer_ctx.expired = true;
+        }
+    }
+    else
+    {
+        // re-armed by the COMP0 interrupt of the period it falls in
+        RTC_Timer32InterruptDisable( RTC_TIMER32_INT_MASK_CMP1 );
+    }
+
+    NVIC_INT_Restore( irq );
+}
+
+static int first_slot_priv ( uint64_t occupied, uint32_t from )
+{
+    uint64_t upper;
+
+    if ( occupied == 0 )
+    {
+        return -1;
+    }
+
+    from &= SWTIMER_WHEEL_MASK;
+    upper = occupied & ( ~( uint64_t )0 << from );
+    if ( upper != 0 )
+    {
+        return __builtin_ctzll( upper );
+    }
+
+    return __builtin_ctzll( occupied );
+}
+
+// ------------------------------------------------------------------------- END
@@ -0,0 +1,190 @@
+/*
+ */
+
+/*!
+ * \file
+ *
+ * \brief This file contains API for the software timer service.
+ *
+ * Software timers are kept in a hierarchical timer wheel (4 levels of 64
+ * slots) clocked by the RTC counter, so starting and cancelling a timer is
+ * O(1) whatever the number of active timers. The RTC COMP1 match is
+ * programmed to the next expiry, so pending timeouts do not need to be polled
+ * and can wake the core from sleep.
+ *
+ * Timer callbacks are executed by swtimer_task() from the main loop, never
+ * from interrupt context, so they are free to use the blocking drivers.
+ *
+ * \addtogroup swtimer Software Timer Service
+ * @{
+ */
+// ----------------------------------------------------------------------------
+
+#ifndef SWTIMER_H
+#define SWTIMER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// -------------------------------------------------------------- PUBLIC MACROS
+/**
+ * \defgroup macros Macros
+ * \{
+ */
+
+/**
+ * \defgroup wheel_geometry Wheel Geometry
+ * \{
+ */
+#define SWTIMER_WHEEL_BITS          6
+#define SWTIMER_WHEEL_SLOTS         ( 1UL << SWTIMER_WHEEL_BITS )
+#define SWTIMER_WHEEL_MASK          ( SWTIMER_WHEEL_SLOTS - 1 )
+#define SWTIMER_WHEEL_LEVELS        4
+
+/* Longest delay the wheel can hold without re-cascading (about 4.5 hours) */
+#define SWTIMER_MAX_TICKS           ( ( 1UL << ( SWTIMER_WHEEL_BITS * SWTIMER_WHEEL_LEVELS ) ) - 1 )
+/** \} */
+
+/**
+ * \defgroup time_base Time Base
+ * \{
+ */
+#define SWTIMER_TICK_FREQ           1024
+/** \} */
+
+/** \} */ // End group macro
+// --------------------------------------------------------------- PUBLIC TYPES
+/**
+ * \defgroup type Types
+ * \{
+ */
+
+typedef void ( *SWTIMER_CALLBACK )( uintptr_t context );
+
+typedef struct swtimer_s
+{
+    struct swtimer_s *next;
+    struct swtimer_s **pprev;
+
+    uint32_t expiry;
+    uint32_t period;
+
+    SWTIMER_CALLBACK callback;
+    uintptr_t context;
+
+} swtimer_t;
+
+/** \} */ // End types group
+// ----------------------------------------------- PUBLIC FUNCTION DECLARATIONS
+
+/**
+ * \defgroup public_function Public function
+ * \{
+ */
+
+#ifdef __cplusplus
+extern "C"{
+#endif
+
+/**
+ * @brief Initialization function.
+ *
+ * @param rtc_period   Value programmed in RTC COMP0.
+ *
+ * @description This function initializes the timer wheel. The RTC is expected
+ * to run in MODE0 with clear on COMP0 match, so the counter restarts every
+ * rtc_period + 1 ticks; the service extends it to a 32-bit time base.
+ */
+void swtimer_init ( uint32_t rtc_period );
+
+/**
+ * @brief RTC interrupt hook.
+ *
+ * @param int_cause    Interrupt cause as passed to the RTC callback.
+ *
+ * @description This function must be called from the RTC callback. It keeps
+ * the time base and re-arms COMP1 when the next expiry falls in the new period.
+ */
+void swtimer_rtc_handler ( uint32_t int_cause );
+
+/**
+ * @brief Current time function.
+ *
+ * @returns Time in RTC ticks (1/1024 s) since swtimer_init().
+ */
+uint32_t swtimer_now ( );
+
+/**
+ * @brief Milliseconds to ticks conversion.
+ *
+ * @param ms           Time in milliseconds.
+ *
+ * @returns Time in RTC ticks, rounded up.
+ */
+uint32_t swtimer_ms_to_ticks ( uint32_t ms );
+
+/**
+ * @brief Start function.
+ *
+ * @param timer        Timer object, owned by the caller.
+ * @param delay_ms     Delay before the callback is executed.
+ * @param callback     Function executed when the timer expires.
+ * @param context      Value passed to the callback.
+ *
+ * @description This function starts a one-shot timer. If the timer is already
+ * running it is re-armed with the new delay.
+ */
+void swtimer_start ( swtimer_t *timer, uint32_t delay_ms, SWTIMER_CALLBACK callback, uintptr_t context );
+
+/**
+ * @brief Periodic start function.
+ *
+ * @param timer        Timer object, owned by the caller.
+ * @param period_ms    Period of the timer.
+ * @param callback     Function executed when the timer expires.
+ * @param context      Value passed to the callback.
+ *
+ * @description This function starts a timer that is re-armed every period_ms
+ * until it is cancelled.
+ */
+void swtimer_start_periodic ( swtimer_t *timer, uint32_t period_ms, SWTIMER_CALLBACK callback, uintptr_t context );
+
+/**
+ * @brief Cancel function.
+ *
+ * @param timer        Timer object.
+ *
+ * @description This function stops the timer. Cancelling an idle timer is allowed.
+ */
+void swtimer_cancel ( swtimer_t *timer );
+
+/**
+ * @brief Active function.
+ *
+ * @param timer        Timer object.
+ *
+ * @returns true if the timer is waiting to expire.
+ */
+bool swtimer_is_active ( swtimer_t *timer );
+
+/**
+ * @brief Pending function.
+ *
+ * @returns true if a timer has expired and swtimer_task() has callbacks to
+ * run; checked with the interrupts disabled before sleeping.
+ */
+bool swtimer_pending ( );
+
+/**
+ * @brief Task function.
+ *
+ * @description This function executes the callbacks of the expired timers.
+ * It must be called from the main loop and returns immediately when no timer
+ * has expired since the previous call.
+ */
+void swtimer_task ( );
+
+#ifdef __cplusplus
+}
+#endif
+#endif  // _SWTIMER_H_
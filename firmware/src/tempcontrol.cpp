@@ -0,0 +1,209 @@
+/* ************************************************************************** */
+/** Cell temperature controller
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include "tempcontrol.h"
+
+/* First order filter on the derivative, as a fraction of Td */
+#define TEMPCONTROL_DERIVATIVE_N    8
+
+TempControl::TempControl()
+{
+    _mode = Control_Hysteresis;
+    setGains(TEMPCONTROL_KP, TEMPCONTROL_TI_S, TEMPCONTROL_TD_S);
+    setWindow(TEMPCONTROL_WINDOW_S, TEMPCONTROL_MIN_ON_S, TEMPCONTROL_MIN_OFF_S);
+    reset(false);
+}
+
+void TempControl::setMode(ControlModeEnum mode, bool cellOn)
+{
+#ifndef TEMPCONTROL_PREDICTIVE
+    if (mode == Control_Predictive)
+        return;
+#endif
+
+    if (_mode == mode)
+        return;
+
+    _mode = mode;
+    reset(cellOn);
+}
+
+void TempControl::setGains(int32_t kp, uint32_t tiS, uint32_t tdS)
+{
+    _kp = kp;
+    _tiS = tiS;
+    _tdS = tdS;
+}
+
+void TempControl::setWindow(uint32_t windowS, uint32_t minOnS, uint32_t minOffS)
+{
+    _windowMs = windowS * 1000;
+    _minOnMs = minOnS * 1000;
+    _minOffMs = minOffS * 1000;
+}
+
+void TempControl::reset(bool cellOn)
+{
+    _integral = 0;
+    _derivative = 0;
+    _prevTemp = CentiCelsius();
+    _primed = false;
+    _output = 0;
+
+    _windowElapsedMs = _windowMs;
+    _windowOnMs = 0;
+    _sinceSwitchMs = 0;
+    _cell = cellOn;
+}
+
+bool TempControl::update(CentiCelsius t, DeciCelsius sp, uint32_t dtMs)
+{
+    if (_mode == Control_Predictive)
+    {
+        bool on = predictive(t, sp);
+
+        if (on != _cell && _sinceSwitchMs >= (_cell? _minOnMs : _minOffMs))
+        {
+            _cell = on;
+            _sinceSwitchMs = 0;
+        }
+        _sinceSwitchMs += dtMs;
+
+        return _cell;
+    }
+
+    _output = pid(t, sp, dtMs);
+
+    // a new window starts with the latest output
+    if (_windowElapsedMs >= _windowMs)
+    {
+        _windowElapsedMs = 0;
+        _windowOnMs = onTime(_output);
+    }
+
+    bool on = _windowElapsedMs < _windowOnMs;
+
+    // the switch is not moved again before its minimum dwell
+    if (on != _cell)
+    {
+        if (_sinceSwitchMs >= (_cell? _minOnMs : _minOffMs))
+        {
+            _cell = on;
+            _sinceSwitchMs = 0;
+        }
+    }
+
+    _windowElapsedMs += dtMs;
+    _sinceSwitchMs += dtMs;
+
+    return _cell;
+}
+
+uint32_t TempControl::fanRunOnMs()
+{
+    if (!_model.ready())
+        return TEMPCONTROL_FAN_RUNON_MS;
+
+    uint32_t ms = _model.deadTimeS() * 1000 + TEMPMODEL_SAMPLE_MS;
+    if (ms < TEMPCONTROL_FAN_RUNON_MIN_MS)
+        ms = TEMPCONTROL_FAN_RUNON_MIN_MS;
+    if (ms > TEMPCONTROL_FAN_RUNON_MAX_MS)
+        ms = TEMPCONTROL_FAN_RUNON_MAX_MS;
+
+    return ms;
+}
+
+bool TempControl::predictive(CentiCelsius t, DeciCelsius sp)
+{
+    DeciCelsius low = sp + TEMPCONTROL_BAND_LOW;
+    DeciCelsius high = sp + TEMPCONTROL_BAND_HIGH;
+    DeciCelsius edge = sp + DeciCelsius::fromDegrees(1);
+
+    // same thresholds as the hysteresis until the model can be trusted,
+    // and whenever the temperature is already out of the band
+    if (!_model.ready() || t < sp || t > edge)
+    {
+        if (t < sp)
+            return false;
+        if (t > edge)
+            return true;
+        return _cell;
+    }
+
+    if (_cell && _model.predictExtreme(true) <= low)
+        return false;
+    if (!_cell && _model.predictExtreme(false) >= high)
+        return true;
+
+    return _cell;
+}
+
+int32_t TempControl::pid(CentiCelsius t, DeciCelsius sp, uint32_t dtMs)
+{
+    // cooling: a positive error asks for more cell
+    int32_t e = (t - sp.to<100>()).raw();
+    int64_t p = (int64_t)_kp * e / 100;
+    int64_t d = 0;
+    int64_t u;
+
+    if (_mode == Control_PID && _tdS > 0 && _primed && dtMs > 0)
+    {
+        // derivative on the measurement, low pass filtered: a step of
+        // N dt / (Td + N dt) towards the rate over this period
+        int64_t rate = (int64_t)(t - _prevTemp).raw() * 1000 * 256 / dtMs;
+        int64_t n = (int64_t)TEMPCONTROL_DERIVATIVE_N * dtMs;
+        _derivative += (rate - _derivative) * n / ((int64_t)_tdS * 1000 + n);
+        d = (int64_t)_kp * _tdS * _derivative / (100 * 256);
+    }
+    _prevTemp = t;
+    _primed = true;
+
+    u = p + (_integral >> 16) + d;
+
+    // anti-windup: integrate only while the output is not pushed further
+    // into saturation, and keep the integral term within the output range
+    if (_tiS > 0)
+    {
+        if ((u < TEMPCONTROL_DUTY_ONE || e < 0) && (u > 0 || e > 0))
+        {
+            // kp e dt / Ti: Q16 per C times 0.01 C times ms, to Q32
+            _integral += (int64_t)_kp * e * dtMs * 65536 / (100000LL * _tiS);
+            if (_integral > ((int64_t)TEMPCONTROL_DUTY_ONE << 16))
+                _integral = (int64_t)TEMPCONTROL_DUTY_ONE << 16;
+            if (_integral < 0)
+                _integral = 0;
+        }
+        u = p + (_integral >> 16) + d;
+    }
+
+    if (u > TEMPCONTROL_DUTY_ONE)
+        u = TEMPCONTROL_DUTY_ONE;
+    if (u < 0)
+        u = 0;
+
+    return (int32_t)u;
+}
+
+uint32_t TempControl::onTime(int32_t u)
+{
+    uint32_t on = (uint32_t)(((uint64_t)u * _windowMs) >> 16);
+
+    // pulses shorter than the switch allows are dropped, gaps are filled
+    if (on < _minOnMs)
+        return (on < _minOnMs / 2)? 0 : _minOnMs;
+    if (_windowMs - on < _minOffMs)
+        return (_windowMs - on < _minOffMs / 2)? _windowMs : _windowMs - _minOffMs;
+
+    return on;
+}
+
+/* *****************************************************************************
+ End of File
+ */
@@ -0,0 +1,190 @@
+/* ************************************************************************** */
+/** Cell temperature controller
+
+  @Summary
+    PI/PID controller driving the Peltier cell by time-proportioned switching.
+
+  @Description
+    The cell is switched by a servo pushing a rocker switch, so it can only
+    be on or off and every transition wears the switch. The controller output
+    (0..TEMPCONTROL_DUTY_ONE) is turned into an on time within a fixed
+    window, with minimum on and off times so short pulses are dropped or
+    stretched instead of toggling the switch.
+
+    The loop is in integers: the temperatures in 0.01 C, the output and the
+    gain in Q16 duty, the integral in Q32 so that the step of one reading
+    is not rounded away.
+
+    The predictive mode switches the cell when the online model says the
+    temperature will reach the edge of the band once the dead time has
+    elapsed, instead of when it is already there. It is experimental and
+    only built with TEMPCONTROL_PREDICTIVE defined: on the simulated plant
+    it cuts the ripple but switches the cell more often than hysteresis
+    and uses more energy, whatever the band it aims for.
+
+    Whatever the mode, the fan keeps running after the cell is switched off
+    for the dead time of the online model, the cold side keeps pumping heat
+    for that long. On the simulated plant that is 100 to 120 s, and against
+    a fixed 30 s it saves 0.1 to 0.2 % of the energy in hysteresis and about
+    1.5 % in PI/PID over the daily ambient swing: the fan runs longer but
+    the cell is on for less.
+
+    The hysteresis mode is kept in the main loop, TempControl only tracks
+    which mode is selected.
+ */
+/* ************************************************************************** */
+
+#ifndef _TEMPCONTROL_H    /* Guard against multiple inclusion */
+#define _TEMPCONTROL_H
+
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <stdint.h>
+#include <stdbool.h>
+#include "tempmodel.h"
+
+#define TEMPCONTROL_DUTY_ONE        65536   // the whole window, Q16
+
+/* Default tuning, from the step response of the case at 25 C ambient */
+#define TEMPCONTROL_KP              22938   // duty per C, Q16: 0.35
+#define TEMPCONTROL_TI_S            900
+#define TEMPCONTROL_TD_S            60
+#define TEMPCONTROL_WINDOW_S        600
+#define TEMPCONTROL_MIN_ON_S        60
+#define TEMPCONTROL_MIN_OFF_S       60
+
+/* Predictive mode: the hysteresis band, without the overshoot past its edges */
+#define TEMPCONTROL_BAND_LOW        DeciCelsius::fromDegrees(0)
+#define TEMPCONTROL_BAND_HIGH       DeciCelsius::fromDegrees(1)
+
+/* Fan run-on, fixed until the model is ready, then its dead time */
+#define TEMPCONTROL_FAN_RUNON_MS    30000
+#define TEMPCONTROL_FAN_RUNON_MIN_MS 10000
+#define TEMPCONTROL_FAN_RUNON_MAX_MS 120000
+
+typedef enum
+{
+  Control_Hysteresis = 0,
+  Control_PI = 1,
+  Control_PID = 2,
+  Control_Predictive = 3,
+} ControlModeEnum;
+
+class TempControl
+{
+public:
+    TempControl();
+
+    // *****************************************************************************
+    /**
+      @Function
+        void setMode(ControlModeEnum mode, bool cellOn)
+
+      @Summary
+        Select the control law, the loop restarts from a clean state with
+        the cell as it is. The predictive mode is refused unless
+        TEMPCONTROL_PREDICTIVE is defined
+     */
+    void setMode(ControlModeEnum mode, bool cellOn);
+    ControlModeEnum mode() { return _mode; }
+
+    /**
+      @Function
+        void setGains(int32_t kp, uint32_t tiS, uint32_t tdS)
+
+      @Summary
+        Proportional gain in Q16 duty per C, integral and derivative times
+        in seconds. tiS = 0 disables the integral action
+     */
+    void setGains(int32_t kp, uint32_t tiS, uint32_t tdS);
+
+    /**
+      @Function
+        void setWindow(uint32_t windowS, uint32_t minOnS, uint32_t minOffS)
+
+      @Summary
+        Time-proportioning window and the shortest on and off times of the
+        cell switch
+     */
+    void setWindow(uint32_t windowS, uint32_t minOnS, uint32_t minOffS);
+
+    /**
+      @Function
+        void reset(bool cellOn)
+
+      @Summary
+        Clear the integrator and start a new window from the cell as it is,
+        which is not moved again before its minimum dwell
+     */
+    void reset(bool cellOn);
+
+    /**
+      @Function
+        bool update(CentiCelsius t, DeciCelsius sp, uint32_t dtMs)
+
+      @Summary
+        Run one step of the loop, dtMs after the previous one
+
+      @Returns
+        true if the cell has to be on
+     */
+    bool update(CentiCelsius t, DeciCelsius sp, uint32_t dtMs);
+
+    /**
+      @Function
+        void observe(CentiCelsius t, bool cell, uint32_t dtMs)
+
+      @Summary
+        Feed the online model, whatever the mode, while the mains is on
+     */
+    void observe(CentiCelsius t, bool cell, uint32_t dtMs) { _model.observe(t, cell, dtMs); }
+
+    /**
+      @Function
+        uint32_t fanRunOnMs()
+
+      @Summary
+        How long the fan keeps running after the cell is switched off, in
+        every mode: the dead time of the model once it is ready
+     */
+    uint32_t fanRunOnMs();
+
+    int32_t output() { return _output; }
+    ThermalModel& model() { return _model; }
+
+private:
+    int32_t pid(CentiCelsius t, DeciCelsius sp, uint32_t dtMs);
+    bool predictive(CentiCelsius t, DeciCelsius sp);
+    uint32_t onTime(int32_t u);
+
+    ControlModeEnum _mode;
+    int32_t _kp;
+    uint32_t _tiS;
+    uint32_t _tdS;
+    uint32_t _windowMs;
+    uint32_t _minOnMs;
+    uint32_t _minOffMs;
+
+    int64_t _integral;      // duty, Q32
+    int64_t _derivative;    // 0.01 C/s, Q8
+    CentiCelsius _prevTemp;
+    bool _primed;
+    int32_t _output;        // duty, Q16
+
+    uint32_t _windowElapsedMs;
+    uint32_t _windowOnMs;
+    uint32_t _sinceSwitchMs;
+    bool _cell;
+
+    ThermalModel _model;
+};
+
+#endif /* _TEMPCONTROL_H */
+
+/* *****************************************************************************
+ End of File
+ */
@@ -7,6 +7,19 @@
 #include "definitions.h"
 #include "temphum11.h"
 
+/* Conversion times from the datasheet, rounded up to whole ms */
+#define TEMPHUM11_TCONV_T14_MS      7
+#define TEMPHUM11_TCONV_T11_MS      4
+#define TEMPHUM11_TCONV_H14_MS      7
+#define TEMPHUM11_TCONV_H11_MS      4
+#define TEMPHUM11_TCONV_H8_MS       3
+
+static uint16_t temphum11_config;
+
+// ---------------------------------------------- PRIVATE FUNCTION DECLARATIONS
+
+static uint32_t conversion_ms_priv ( uint8_t reg );
+
 // ------------------------------------------------ PUBLIC FUNCTION DEFINITIONS
 
 void temphum11_default_cfg ( )
@@ -24,6 +37,8 @@ void temphum11_write_config ( uint16_t config )
     write_reg[ 1 ] = ( uint8_t )( config >> 8 );
     write_reg[ 2 ] = ( uint8_t )( config );  
 
+    temphum11_config = config;
+
     SERCOM0_I2C_Write(TEMPHUM11_DEVICE_SLAVE_ADDR, write_reg, 3);
     while (SERCOM0_I2C_IsBusy()) 
         ;
@@ -41,7 +56,7 @@ uint16_t temphum11_read_data ( uint8_t reg )
     while (SERCOM0_I2C_IsBusy()) 
         ;
     
-    SYSTICK_DelayMs(10);
+    SYSTICK_DelayMs(conversion_ms_priv( reg ));
     
     SERCOM0_I2C_Read(TEMPHUM11_DEVICE_SLAVE_ADDR, read_reg, 2);
     while (SERCOM0_I2C_IsBusy()) 
@@ -74,6 +89,17 @@ float temphum11_get_temperature ( uint8_t temp_in )
     return temperature;
 }
 
+int32_t temphum11_temperature_centi ( uint16_t raw )
+{
+    // 165 C over the 16-bit code from -40 C, rounded: raw * 16500 fits 31 bits
+    return ( int32_t )( ( ( uint32_t )raw * 16500UL + 32768UL ) >> 16 ) - 4000;
+}
+
+int32_t temphum11_get_temperature_centi ( )
+{
+    return temphum11_temperature_centi( temphum11_read_data( TEMPHUM11_REG_TEMPERATURE ) );
+}
+
 float temphum11_get_humidity ( )
 {
     uint16_t hum_out = 0;
@@ -85,8 +111,49 @@ float temphum11_get_humidity ( )
     return humidity;
 }
 
+int32_t temphum11_humidity_centi ( uint16_t raw )
+{
+    // 100 %RH over the 16-bit code, rounded: raw * 10000 fits 30 bits
+    return ( int32_t )( ( ( uint32_t )raw * 10000UL + 32768UL ) >> 16 );
+}
+
+int32_t temphum11_get_humidity_centi ( )
+{
+    return temphum11_humidity_centi( temphum11_read_data( TEMPHUM11_REG_HUMIDITY ) );
+}
+
+void temphum11_set_resolution ( uint16_t resolution )
+{
+    uint16_t config = ( temphum11_config & ~TEMPHUM11_RESOLUTION_MASK ) |
+                      ( resolution & TEMPHUM11_RESOLUTION_MASK );
+
+    if ( config != temphum11_config )
+    {
+        temphum11_write_config( config );
+    }
+}
+
 // ----------------------------------------------- PRIVATE FUNCTION DEFINITIONS
 
+static uint32_t conversion_ms_priv ( uint8_t reg )
+{
+    if ( reg == TEMPHUM11_REG_TEMPERATURE )
+    {
+        return ( temphum11_config & TEMPHUM11_TEMP_RESOLUTION_11bit ) ?
+               TEMPHUM11_TCONV_T11_MS : TEMPHUM11_TCONV_T14_MS;
+    }
+
+    switch ( temphum11_config & ( TEMPHUM11_HUM_RESOLUTION_11bit | TEMPHUM11_HUM_RESOLUTION_8bit ) )
+    {
+        case TEMPHUM11_HUM_RESOLUTION_14bit:
+            return TEMPHUM11_TCONV_H14_MS;
+        case TEMPHUM11_HUM_RESOLUTION_11bit:
+            return TEMPHUM11_TCONV_H11_MS;
+        default:
+            return TEMPHUM11_TCONV_H8_MS;
+    }
+}
+
 
 
 // ------------------------------------------------------------------------- END
@@ -32,6 +32,9 @@
 #define TEMPHUM11_INIT_ERROR   0xFF
 /** \} */
 
+/* From power up to the first transfer, datasheet maximum */
+#define TEMPHUM11_STARTUP_MS   15
+
 /**
  * \defgroup registers Registers
  * \{
@@ -63,6 +66,7 @@
 #define TEMPHUM11_HUM_RESOLUTION_14bit          0x0000
 #define TEMPHUM11_HUM_RESOLUTION_11bit          0x0100
 #define TEMPHUM11_HUM_RESOLUTION_8bit           0x0200
+#define TEMPHUM11_RESOLUTION_MASK               0x0700
 /** \} */
 
 /**
@@ -150,6 +154,27 @@ uint16_t temphum11_read_data ( uint8_t reg );
  */
 float temphum11_get_temperature ( uint8_t temp_in );
 
+/**
+ * @brief Function for converting a temperature reading
+ *
+ * @param raw          Content of the temperature register.
+ *
+ * @returns Temperature in 0.01 Celsius, rounded.
+ *
+ * @description This function converts in integer arithmetic only.
+ */
+int32_t temphum11_temperature_centi ( uint16_t raw );
+
+/**
+ * @brief Function for reading Temperature data in 0.01 Celsius
+ *
+ * @returns Temperature in 0.01 Celsius, rounded.
+ *
+ * @description This function reads temperature data without any floating
+ * point conversion.
+ */
+int32_t temphum11_get_temperature_centi ( );
+
 /**
  * @brief Functions for reading Relative Huminidy data
  *
@@ -161,6 +186,38 @@ float temphum11_get_temperature ( uint8_t temp_in );
  */
 float temphum11_get_humidity ( );
 
+/**
+ * @brief Function for converting a relative humidity reading
+ *
+ * @param raw          Content of the humidity register.
+ *
+ * @returns Relative humidity in 0.01 %RH, rounded.
+ *
+ * @description This function converts in integer arithmetic only.
+ */
+int32_t temphum11_humidity_centi ( uint16_t raw );
+
+/**
+ * @brief Function for reading Relative Humidity data in 0.01 %RH
+ *
+ * @returns Relative humidity in 0.01 %RH, rounded.
+ *
+ * @description This function reads relative humidity data without any
+ * floating point conversion.
+ */
+int32_t temphum11_get_humidity_centi ( );
+
+/**
+ * @brief Function for setting the resolution of the measurements
+ *
+ * @param resolution   TEMPHUM11_TEMP_RESOLUTION_xxx | TEMPHUM11_HUM_RESOLUTION_xxx.
+ *
+ * @description This function rewrites the configuration with the new
+ * resolution, the rest of it is kept. Nothing is written if the resolution
+ * does not change. The wait for a conversion follows the resolution.
+ */
+void temphum11_set_resolution ( uint16_t resolution );
+
 #ifdef __cplusplus
 }
 #endif
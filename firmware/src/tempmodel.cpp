@@ -0,0 +1,192 @@
+/* ************************************************************************** */
+/** Online thermal model of the case
+ */
+/* ************************************************************************** */
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <math.h>
+#include <string.h>
+#include "tempmodel.h"
+
+/* Initial covariance and the bound that stops it growing without excitation */
+#define TEMPMODEL_P0                100.0f
+#define TEMPMODEL_P_MAX             10000.0f
+
+/* Smoothing of the squared prediction error used to pick the dead time */
+#define TEMPMODEL_ERR_ALPHA         0.02f
+
+ThermalModel::ThermalModel()
+{
+    reset();
+}
+
+void ThermalModel::reset()
+{
+    memset(_est, 0, sizeof(_est));
+
+    for (uint8_t d = 0; d <= TEMPMODEL_MAX_DEADTIME; d++)
+    {
+        _est[d].theta[0] = 1.0f;
+        for (uint8_t i = 0; i < 3; i++)
+            _est[d].P[i][i] = TEMPMODEL_P0;
+    }
+
+    _best = 0;
+    _valid = false;
+    _sum = 0;
+    _count = 0;
+    _onCount = 0;
+    _elapsedMs = 0;
+    _y = 0.0f;
+    _primed = false;
+    _history = 0;
+    _samples = 0;
+    _switches = 0;
+}
+
+bool ThermalModel::observe(CentiCelsius t, bool cell, uint32_t dtMs)
+{
+    // readings are weighted by the time they stand for, the sampler spaces
+    // them as the signal allows
+    _sum += (int64_t)t.raw() * dtMs;
+    _count += dtMs;
+    _onCount += cell? dtMs : 0;
+    _elapsedMs += dtMs;
+
+    if (_elapsedMs < TEMPMODEL_SAMPLE_MS)
+        return false;
+
+    // the input of a sample is the state for most of its period
+    float y = (float)_sum / (float)_count / CentiCelsius::perDegree;
+    bool u = (2 * _onCount >= _count);
+
+    _sum = 0;
+    _count = 0;
+    _onCount = 0;
+    _elapsedMs -= TEMPMODEL_SAMPLE_MS;
+
+    if (_primed)
+        fit(y);
+
+    if (((_history & 1) != 0) != u)
+        _switches++;
+
+    _history = (_history << 1) | (u? 1 : 0);
+    _y = y;
+    _primed = true;
+
+    return true;
+}
+
+bool ThermalModel::ready()
+{
+    return _valid && (_samples >= TEMPMODEL_MIN_SAMPLES) && (_switches >= TEMPMODEL_MIN_SWITCHES);
+}
+
+bool ThermalModel::valid(const Estimator& e)
+{
+    // a cooling cell and a stable, not integrating, case
+    return (e.theta[0] > 0.0f) && (e.theta[0] < 1.0f) && (e.theta[1] < 0.0f);
+}
+
+CentiCelsius ThermalModel::predictExtreme(bool lowest)
+{
+    const Estimator& e = best();
+    float y = _y;
+    float extreme = y;
+
+    for (int8_t i = _best; i >= 0; i--)
+    {
+        float u = (_history & (1UL << i))? 1.0f : 0.0f;
+
+        y = e.theta[0] * y + e.theta[1] * u + e.theta[2];
+        if (lowest? (y < extreme) : (y > extreme))
+            extreme = y;
+    }
+
+    return CentiCelsius::fromFloat(extreme);
+}
+
+float ThermalModel::gain()
+{
+    const Estimator& e = best();
+
+    return e.theta[1] / (1.0f - e.theta[0]);
+}
+
+float ThermalModel::timeConstantS()
+{
+    const Estimator& e = best();
+
+    if (e.theta[0] <= 0.0f || e.theta[0] >= 1.0f)
+        return 0.0f;
+
+    return -(TEMPMODEL_SAMPLE_MS / 1000.0f) / logf(e.theta[0]);
+}
+
+MilliCelsius ThermalModel::residual()
+{
+    return MilliCelsius::fromFloat(best().last);
+}
+
+uint32_t ThermalModel::deadTimeS()
+{
+    return _best * TEMPMODEL_SAMPLE_MS / 1000;
+}
+
+void ThermalModel::fit(float y)
+{
+    float minErr = 0.0f;
+    bool found = false;
+
+    for (uint8_t d = 0; d <= TEMPMODEL_MAX_DEADTIME; d++)
+    {
+        Estimator& e = _est[d];
+        float phi[3] = { _y, (_history & (1UL << d))? 1.0f : 0.0f, 1.0f };
+        float Pphi[3];
+        float denom = TEMPMODEL_FORGETTING;
+        float trace = 0.0f;
+
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            Pphi[i] = e.P[i][0] * phi[0] + e.P[i][1] * phi[1] + e.P[i][2] * phi[2];
+            denom += phi[i] * Pphi[i];
+        }
+
+        // a priori error, before this sample is learnt
+        float err = y - (e.theta[0] * phi[0] + e.theta[1] * phi[1] + e.theta[2] * phi[2]);
+        e.err += TEMPMODEL_ERR_ALPHA * (err * err - e.err);
+        e.last = err;
+
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            e.theta[i] += Pphi[i] / denom * err;
+            trace += e.P[i][i];
+        }
+
+        // P is symmetric, so phi' P = (P phi)'
+        float scale = (trace < TEMPMODEL_P_MAX)? 1.0f / TEMPMODEL_FORGETTING : 1.0f;
+        for (uint8_t i = 0; i < 3; i++)
+            for (uint8_t j = 0; j < 3; j++)
+                e.P[i][j] = (e.P[i][j] - Pphi[i] * Pphi[j] / denom) * scale;
+
+        // an integrating or heating fit cannot be the case, whatever its error
+        if (valid(e) && (!found || e.err < minErr))
+        {
+            minErr = e.err;
+            _best = d;
+            found = true;
+        }
+    }
+
+    _valid = found;
+    _samples++;
+}
+
+/* *****************************************************************************
+ End of File
+ */
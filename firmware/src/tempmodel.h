@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/** Online thermal model of the case
+
+  @Summary
+    First order plus dead time model fitted from the temperature history.
+
+  @Description
+    The air temperature, averaged over TEMPMODEL_SAMPLE_MS, is described by
+
+        y[k+1] = a * y[k] + b * u[k-d] + c
+
+    where u is the cell state, a = exp(-Ts/tau), b = K * (1 - a) and c holds
+    the heat leaking in from outside. One recursive least squares estimator
+    with forgetting runs for every candidate dead time d; the one with the
+    smallest prediction error gives the model. Forgetting lets the model
+    follow the ambient temperature and the load in the case.
+
+    The fit is in float, the recursion over P does not keep its precision
+    in any fixed-point format that fits 32 bits. It runs once a model
+    sample and feeds the control loop only in the experimental predictive
+    mode; the temperatures go in and come out as fixed-point values, so
+    the rest of the loop stays in integers.
+ */
+/* ************************************************************************** */
+
+#ifndef _TEMPMODEL_H    /* Guard against multiple inclusion */
+#define _TEMPMODEL_H
+
+
+/* ************************************************************************** */
+/* ************************************************************************** */
+/* Section: Included Files                                                    */
+/* ************************************************************************** */
+/* ************************************************************************** */
+#include <stdint.h>
+#include <stdbool.h>
+#include "celsius.h"
+
+#define TEMPMODEL_SAMPLE_MS         5000
+#define TEMPMODEL_MAX_DEADTIME      24      // samples, 2 minutes
+#define TEMPMODEL_FORGETTING        0.998f  // about 40 minutes of memory
+#define TEMPMODEL_MIN_SAMPLES       120     // 10 minutes
+#define TEMPMODEL_MIN_SWITCHES      2
+
+class ThermalModel
+{
+public:
+    ThermalModel();
+
+    // *****************************************************************************
+    /**
+      @Function
+        void reset()
+
+      @Summary
+        Forget the fitted model, e.g. after the mains has been switched off
+     */
+    void reset();
+
+    /**
+      @Function
+        bool observe(CentiCelsius t, bool cell, uint32_t dtMs)
+
+      @Summary
+        Feed the temperature measured with the cell in the given state for
+        the last dtMs
+
+      @Returns
+        true when a model sample has been completed and the model updated
+     */
+    bool observe(CentiCelsius t, bool cell, uint32_t dtMs);
+
+    /**
+      @Function
+        bool ready()
+
+      @Summary
+        The model has seen enough samples and switching to be trusted
+     */
+    bool ready();
+
+    /**
+      @Function
+        CentiCelsius predictExtreme(bool lowest)
+
+      @Summary
+        Lowest or highest temperature over the dead time, with the cell
+        states already applied; a switch decided now cannot act earlier
+     */
+    CentiCelsius predictExtreme(bool lowest);
+
+    float gain();
+    float timeConstantS();
+    uint32_t deadTimeS();
+
+    /**
+      @Function
+        MilliCelsius residual()
+
+      @Summary
+        Last model sample minus what the model predicted for it, before
+        learning from it; positive when the case is warmer than expected
+     */
+    MilliCelsius residual();
+    uint32_t samples() { return _samples; }
+
+private:
+    typedef struct {
+        float theta[3];
+        float P[3][3];
+        float err;
+        float last;
+    } Estimator;
+
+    void fit(float y);
+    static bool valid(const Estimator& e);
+    const Estimator& best() { return _est[_best]; }
+
+    Estimator _est[TEMPMODEL_MAX_DEADTIME + 1];
+    uint8_t _best;
+    bool _valid;
+
+    int64_t _sum;           // 0.01 C x ms
+    uint32_t _count;
+    uint32_t _onCount;
+    uint32_t _elapsedMs;
+
+    float _y;
+    bool _primed;
+    uint32_t _history;      // bit i is the cell state i samples ago
+    uint32_t _samples;
+    uint32_t _switches;
+};
+
+#endif /* _TEMPMODEL_H */
+
+/* *****************************************************************************
+ End of File
+ */